@@ -0,0 +1,100 @@
+// JobSystem 调度开销基准：xmake build JobSystemBench && xmake run JobSystemBench
+// 对比每个作业一次 std::async（作业系统之前的做法）与 JobSystem::Schedule / ParallelFor，
+// 作业体几乎为空，测得的时间基本就是每个作业的调度与同步开销
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+std::atomic<long long> sink{0};
+
+void TinyJob(size_t i)
+{
+    sink.fetch_add(static_cast<long long>(i), std::memory_order_relaxed);
+}
+
+// 重复 repeats 次取最小值，减少系统抖动的影响；返回每个作业的纳秒数
+template <typename Body> double MeasurePerJob(size_t jobCount, int repeats, Body body)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = Clock::now();
+        body(jobCount);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        best = std::min(best, ns / static_cast<double>(jobCount));
+    }
+    return best;
+}
+
+void RunAsync(size_t jobCount)
+{
+    std::vector<std::future<void>> futures;
+    futures.reserve(jobCount);
+    for (size_t i = 0; i < jobCount; ++i)
+        futures.push_back(std::async(std::launch::async, [i]() { TinyJob(i); }));
+    for (auto &future : futures)
+        future.get();
+}
+
+void RunSchedule(size_t jobCount)
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    auto counter = std::make_shared<JobCounter>();
+    for (size_t i = 0; i < jobCount; ++i)
+        jobs.Schedule([i]() { TinyJob(i); }, counter);
+    jobs.Wait(counter);
+}
+
+void RunParallelFor(size_t jobCount)
+{
+    // 粒度为 1：每个下标一个作业，与上面两种方式的作业数相同
+    JobSystem::GetInstance().ParallelFor(0, jobCount, 1, [](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            TinyJob(i);
+    });
+}
+
+void RunParallelForGrain(size_t jobCount)
+{
+    // 实际使用中的粒度（剔除、压缩等按 64 左右切分）
+    JobSystem::GetInstance().ParallelFor(0, jobCount, 64, [](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            TinyJob(i);
+    });
+}
+} // namespace
+
+int main()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    jobs.Initialize();
+
+    const int repeats = 5;
+    std::printf("workers: %u\n", jobs.GetWorkerCount());
+    std::printf("%-10s %16s %16s %20s %22s\n", "jobs", "std::async ns", "Schedule ns", "ParallelFor(1) ns",
+                "ParallelFor(64) ns");
+    for (size_t jobCount : {1000u, 10000u, 100000u})
+    {
+        // std::async 每个作业创建一个线程，作业数过多时只测较小的规模
+        double asyncNs = jobCount <= 10000 ? MeasurePerJob(jobCount, repeats, RunAsync) : -1.0;
+        double scheduleNs = MeasurePerJob(jobCount, repeats, RunSchedule);
+        double parallelForNs = MeasurePerJob(jobCount, repeats, RunParallelFor);
+        double grainNs = MeasurePerJob(jobCount, repeats, RunParallelForGrain);
+        if (asyncNs >= 0.0)
+            std::printf("%-10zu %16.1f %16.1f %20.1f %22.1f\n", jobCount, asyncNs, scheduleNs, parallelForNs, grainNs);
+        else
+            std::printf("%-10zu %16s %16.1f %20.1f %22.1f\n", jobCount, "-", scheduleNs, parallelForNs, grainNs);
+    }
+
+    jobs.Shutdown();
+    return sink.load() == 0 ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+// 分簇光照 CPU 分配基准：xmake build LightClustersBench && xmake run LightClustersBench
+// 对比 LightClusterAssigner 的标量测试与 SoA SIMD 批量测试（AVX 8 路 / SSE 4 路，取决于编译选项），
+// 分别在单个工作线程和全部工作线程下测量一次 Assign 的耗时
+#include "core/JobSystem.hpp"
+#include "core/LightClusterAssigner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 100.0f;
+
+// 光源均匀分布在视锥内，半径 0.5~3，接近室内场景中点光源的影响范围
+void FillLights(LightClusterAssigner &assigner, size_t count)
+{
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> lateral(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(NEAR_PLANE, FAR_PLANE);
+    std::uniform_real_distribution<float> radius(0.5f, 3.0f);
+    assigner.Clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        float d = depth(rng);
+        assigner.Add(glm::vec4(lateral(rng) * d * 0.7f, lateral(rng) * d * 0.4f, -d, radius(rng)));
+    }
+}
+
+// 重复 repeats 次取最小值；返回毫秒
+double MeasureAssign(const LightClusterAssigner &assigner, int repeats, std::vector<uint32_t> &data)
+{
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, NEAR_PLANE, FAR_PLANE);
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = Clock::now();
+        assigner.Assign(projection, NEAR_PLANE, FAR_PLANE, 0, data);
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+} // namespace
+
+int main()
+{
+#if defined(__AVX__)
+    const char *simd = "AVX x8";
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    const char *simd = "SSE x4";
+#else
+    const char *simd = "none (scalar only)";
+#endif
+    std::printf("simd: %s\n", simd);
+
+    JobSystem &jobs = JobSystem::GetInstance();
+    const int repeats = 20;
+    std::vector<uint32_t> data;
+    LightClusterAssigner assigner;
+
+    for (unsigned int workers : {1u, 0u})
+    {
+        // 0 表示按硬件线程数
+        jobs.Initialize(workers);
+        std::printf("\nworkers: %u\n", jobs.GetWorkerCount());
+        std::printf("%-10s %12s %12s %10s\n", "lights", "scalar ms", "simd ms", "speedup");
+        for (size_t lightCount : {256u, 1024u, 4096u, 16384u})
+        {
+            FillLights(assigner, lightCount);
+            assigner.SetUseSimd(false);
+            double scalarMs = MeasureAssign(assigner, repeats, data);
+            assigner.SetUseSimd(true);
+            double simdMs = MeasureAssign(assigner, repeats, data);
+            std::printf("%-10zu %12.3f %12.3f %9.2fx\n", lightCount, scalarMs, simdMs, scalarMs / simdMs);
+        }
+        jobs.Shutdown();
+    }
+    return 0;
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "core/Benchmark.hpp"
 #include "core/Renderer.hpp"
 #include "ui/EditorUI.hpp"
 #include <GLFW/glfw3.h>
+#include <chrono>
 #include <memory>
 #include <iostream>
 #include <streambuf>
@@ -14,7 +16,11 @@
 class Application
 {
   public:
-    Application();
+    // 启动参数：
+    //   --bench <场景名>             运行基准测试（见 Benchmark），测完后自动退出
+    //   --startup-report <cold|warm>  测量启动到第一帧完整画面的耗时并追加到 benchmarks/results/startup.csv 后退出；
+    //                                cold 先清空着色器程序缓存
+    Application(int argc = 0, char **argv = nullptr);
     ~Application();
 
     void Run();
@@ -35,6 +41,8 @@ class Application
     void Update(float deltaTime);
     void Render();
     void CreateTestScene();
+    // 第一帧完整画面（着色器全部可用）之后调用一次：输出启动耗时与着色器缓存命中情况
+    void ReportStartup();
 
     GLFWwindow *window;
     int width = 1280;
@@ -46,6 +54,21 @@ class Application
 
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<EditorUI> editorUI;
+    // 基准测试模式：不绘制编辑器界面、关闭垂直同步，渲染结果直接拷贝到窗口
+    const Benchmark::Scene *benchmarkScene = nullptr;
+    std::unique_ptr<Benchmark> benchmark;
+
+    // 启动耗时测量
+    enum class StartupReport
+    {
+        NONE,
+        COLD,
+        WARM
+    };
+    StartupReport startupReport = StartupReport::NONE;
+    std::chrono::steady_clock::time_point launchTime;
+    double initializeMs = 0.0;
+    bool startupReported = false;
 
     bool vsyncEnabled = true;
     bool wireframeMode = false;
@@ -60,6 +83,8 @@ class Application
         
     protected:
         int overflow(int c) override {
+            // 作业线程也会输出日志，每个线程单独缓冲一行，避免字符交错
+            thread_local std::string buffer_;
             if (c != EOF) {
                 buffer_ += static_cast<char>(c);
                 if (c == '\n') {
@@ -69,9 +94,6 @@ class Application
             }
             return c;
         }
-        
-    private:
-        std::string buffer_;
     };
     
     static std::unique_ptr<ConsoleRedirector> consoleRedirector;
@@ -0,0 +1,69 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+class Renderer;
+
+// 基准测试：固定场景与相机，依次切换到每种配置，预热若干帧后统计 CPU 帧时间和各渲染阶段的 GPU 时间（GpuTimer）。
+// 启动参数 --bench <场景名> 运行（关闭垂直同步），全部配置测完后打印结果并写入 benchmarks/results/<场景名>.csv。
+// 场景在 Benchmark.cpp 中注册
+class Benchmark
+{
+  public:
+    struct Config
+    {
+        std::string name;
+        std::function<void(Renderer &)> apply; // 切换渲染模式、开关等
+        int width = 1920;                      // 渲染分辨率
+        int height = 1080;
+    };
+
+    struct Scene
+    {
+        std::string name;
+        std::string description;
+        std::function<void(Renderer &)> build; // 创建场景对象、光源并摆放相机
+        std::vector<Config> configs;
+    };
+
+    static const std::vector<Scene> &GetScenes();
+    // 不存在时返回 nullptr
+    static const Scene *FindScene(const std::string &name);
+
+    Benchmark(Renderer &renderer, const Scene &scene, int warmupFrames = 60, int measureFrames = 300);
+
+    // 创建场景并切换到第一个配置
+    void Start();
+    // 每帧渲染结束后调用，cpuFrameMs 为上一帧的 CPU 帧时间；全部配置测完后返回 false
+    bool Step(float cpuFrameMs);
+    // 打印结果并写入 CSV
+    void Report() const;
+
+  private:
+    struct Result
+    {
+        std::string config;
+        int width = 0;
+        int height = 0;
+        int frames = 0;     // CPU 采样帧数
+        int gpuFrames = 0;  // 读回的 GPU 结果帧数
+        double cpuMs = 0.0; // 以下均为累计值
+        double gpuFrameMs = 0.0;
+        int gBufferBytesPerPixel = 0; // 前向模式为 0
+        std::vector<std::string> sectionNames;
+        std::vector<double> sectionMs;
+    };
+
+    void ApplyConfig(size_t index);
+
+    Renderer &renderer;
+    const Scene &scene;
+    int warmupFrames;
+    int measureFrames;
+
+    size_t configIndex = 0;
+    int frameInConfig = 0;
+    unsigned long long lastResolvedFrame = 0;
+    std::vector<Result> results;
+};
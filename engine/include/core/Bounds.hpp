@@ -0,0 +1,66 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <limits>
+#include <vector>
+
+struct Vertex;
+
+// 轴对齐包围盒，默认构造为空盒（min > max）
+struct AABB
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+    bool IsValid() const
+    {
+        return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+    }
+    glm::vec3 GetCenter() const
+    {
+        return (min + max) * 0.5f;
+    }
+    glm::vec3 GetExtents() const
+    {
+        return (max - min) * 0.5f;
+    }
+
+    void Expand(const glm::vec3 &point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    void Expand(const AABB &other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    // 变换后的包围盒（包住变换后的原包围盒）
+    AABB Transform(const glm::mat4 &matrix) const;
+};
+
+// 包围球
+struct BoundingSphere
+{
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+
+    // 变换后的包围球，半径按最大轴向缩放放大
+    BoundingSphere Transform(const glm::mat4 &matrix) const;
+};
+
+// 由顶点计算局部包围盒与包围球（球心取包围盒中心）
+AABB ComputeBounds(const std::vector<Vertex> &vertices);
+BoundingSphere ComputeBoundingSphere(const std::vector<Vertex> &vertices, const AABB &bounds);
+
+// 视锥体：六个平面 (n, d)，法线指向视锥内侧，n·p + d >= 0 表示在平面内侧
+struct Frustum
+{
+    glm::vec4 planes[6] = {};
+
+    // 由 投影 * 视图 矩阵提取（Gribb-Hartmann），适用于透视和正交投影
+    static Frustum FromMatrix(const glm::mat4 &viewProj);
+
+    bool Intersects(const AABB &bounds) const;
+    bool Intersects(const BoundingSphere &sphere) const;
+};
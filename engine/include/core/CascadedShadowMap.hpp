@@ -0,0 +1,150 @@
+#pragma once
+#include "Bounds.hpp"
+#include "UniformBuffer.hpp"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Camera;
+class Light;
+
+// 方向光的级联阴影：相机视锥按实用分割（对数与均匀分割按 lambda 混合）切成 2~4 段，
+// 每段用包住该段视锥的球体拟合一个正交投影，投影中心按纹素大小对齐，相机移动或旋转时阴影不闪烁。
+// 所有方向光的全部级联渲染到同一张深度纹理数组，第 slot * 级联数 + cascade 层；
+// 级联矩阵和分割距离每帧写入 ShadowCascades UBO，必须与 common/shadow_cascades.glsl 保持一致
+class CascadedShadowMap
+{
+  public:
+    static constexpr int MIN_CASCADES = 2;
+    static constexpr int MAX_CASCADES = 4;
+    static constexpr int MAX_LIGHTS = 4; // 同时投射级联阴影的方向光上限
+
+    // std140，与 common/shadow_cascades.glsl 中的 ShadowCascades 一一对应
+    struct GpuData
+    {
+        glm::mat4 matrices[MAX_LIGHTS * MAX_CASCADES]; // [slot * MAX_CASCADES + cascade]
+        glm::vec4 splits;                              // 各级联远端的视空间深度
+        glm::vec4 texelSizes;                          // 各级联一个纹素对应的世界空间尺寸（法线偏移用）
+        int cascadeCount;
+        float blendRange;                              // 级联末端与下一级混合的比例
+        float padding[2];
+    };
+    static_assert(sizeof(GpuData) == 1072, "GpuData must match std140 layout");
+
+    // resolution: 每个级联的分辨率
+    CascadedShadowMap(int resolution = 1024, int cascadeCount = 3);
+    ~CascadedShadowMap();
+
+    CascadedShadowMap(const CascadedShadowMap &) = delete;
+    CascadedShadowMap &operator=(const CascadedShadowMap &) = delete;
+
+    // 由相机计算各级联的分割距离和包围球，每帧在渲染阴影前调用一次
+    void UpdateSplits(const Camera &camera, float aspect);
+
+    // 获取光源的槽位，不存在时分配；超过 MAX_LIGHTS 时返回 -1
+    int Acquire(const Light *light);
+    void ReleaseUnused(const std::unordered_set<const Light *> &alive);
+    void ReleaseAll();
+
+    // 计算光源在某个级联的光源空间矩阵；sceneBounds 为所有投射体的包围盒，
+    // 朝向光源一侧的深度范围会延伸到包住全部投射体，级联之外的物体也能投下阴影
+    glm::mat4 ComputeMatrix(int slot, const glm::vec3 &direction, int cascade, const AABB &sceneBounds);
+
+    // 矩阵和投射体都未变化时返回 false，可以跳过该级联的重绘
+    bool NeedsRedraw(int slot, int cascade, size_t casterSignature) const;
+
+    // 绑定纹理数组中的一层并清除深度，EndCascade 记录本次绘制的状态
+    void BeginCascade(int slot, int cascade) const;
+    void EndCascade(int slot, int cascade, size_t casterSignature);
+
+    // 上传级联矩阵和分割距离
+    void Upload();
+
+    // 将所有级联标记为需要重绘
+    void Invalidate();
+
+    GLuint GetDepthTexture() const
+    {
+        return depthTexture;
+    }
+    int GetResolution() const
+    {
+        return resolution;
+    }
+    void SetResolution(int value);
+    int GetCascadeCount() const
+    {
+        return cascadeCount;
+    }
+    void SetCascadeCount(int count);
+    // 0 为均匀分割，1 为对数分割
+    float GetSplitLambda() const
+    {
+        return splitLambda;
+    }
+    void SetSplitLambda(float value)
+    {
+        splitLambda = glm::clamp(value, 0.0f, 1.0f);
+    }
+    // 阴影覆盖的最远视空间距离，超出相机远平面时以远平面为准
+    float GetShadowDistance() const
+    {
+        return shadowDistance;
+    }
+    void SetShadowDistance(float value)
+    {
+        shadowDistance = glm::max(value, 1.0f);
+    }
+    float GetBlendRange() const
+    {
+        return blendRange;
+    }
+    void SetBlendRange(float value)
+    {
+        blendRange = glm::clamp(value, 0.0f, 0.5f);
+    }
+    const GpuData &GetGpuData() const
+    {
+        return gpuData;
+    }
+
+  private:
+    struct CascadeState
+    {
+        glm::mat4 matrix = glm::mat4(0.0f);   // 本帧的矩阵
+        glm::mat4 rendered = glm::mat4(0.0f); // 上次渲染时的矩阵
+        size_t casterSignature = 0;
+        bool dirty = true;
+    };
+
+    // 按槽位容量和级联数（重新）分配深度纹理数组，内容丢失后所有级联需要重绘
+    void Allocate(int lightCapacity);
+    int GetLayer(int slot, int cascade) const
+    {
+        return slot * cascadeCount + cascade;
+    }
+
+    int resolution;
+    int cascadeCount;
+    float splitLambda = 0.75f;
+    float shadowDistance = 100.0f;
+    float blendRange = 0.1f;
+
+    GLuint depthTexture = 0;
+    GLuint framebuffer = 0;
+    int lightCapacity = 0; // 纹理数组当前能容纳的方向光数
+
+    // 本帧各级联在世界空间的包围球
+    glm::vec3 sphereCenters[MAX_CASCADES];
+    float sphereRadii[MAX_CASCADES] = {};
+
+    std::unordered_map<const Light *, int> slots;
+    std::vector<bool> slotUsed = std::vector<bool>(MAX_LIGHTS, false);
+    CascadeState states[MAX_LIGHTS][MAX_CASCADES];
+
+    GpuData gpuData{};
+    std::unique_ptr<UniformBuffer> uniformBuffer;
+};
@@ -21,6 +21,9 @@ class Framebuffer
     // 深度纹理（用于阴影、SSAO 等）
     void AddDepthTexture();
 
+    // 深度/模板纹理（D24S8，可采样深度，且能与 AddDepthBuffer 的附件互相 blit）
+    void AddDepthStencilTexture();
+
     // 深度/模板渲染缓冲（默认附件，兼容旧显卡）
     void AddDepthBuffer();
 
@@ -63,6 +66,9 @@ class Framebuffer
         return height;
     }
 
+    // 所有附件每像素占用的字节数（多重采样按样本数累计），用于估算带宽
+    int GetBytesPerPixel() const;
+
     // 调整分辨率（保留原始格式）
     void Resize(int newWidth, int newHeight);
 
@@ -92,6 +98,7 @@ class Framebuffer
     std::vector<int> colorSamples;                               // 每个纹理的样本数（0 表示非 MSAA）
 
     unsigned int depthTexture = 0;
+    bool depthTextureHasStencil = false;
     unsigned int depthBuffer = 0;
     int lastSamples = 1;
 };
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "Bounds.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 批量视锥剔除：世界空间包围盒按 SoA 布局存放，每次测试 8 个包围盒。
+// 编译器启用 AVX 时使用 8 路 AVX，否则在 x86 上使用两次 4 路 SSE，其他平台退回标量实现
+class FrustumCuller
+{
+  public:
+    static constexpr size_t BATCH_SIZE = 8;
+
+    void Clear();
+    // 追加一个世界空间包围盒，返回其下标
+    size_t Add(const AABB &bounds);
+
+    size_t GetCount() const
+    {
+        return count;
+    }
+
+    // 测试全部包围盒，visible[i] 为 1 表示与视锥相交；返回可见数量
+    size_t Cull(const Frustum &frustum, std::vector<uint8_t> &visible) const;
+
+  private:
+    // 数组长度始终补齐到 BATCH_SIZE 的整数倍，补齐部分的结果会被丢弃
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    size_t count = 0;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// GPU 计时：用时间戳查询（glQueryCounter）测量每帧各渲染阶段在 GPU 上的耗时，阶段可以嵌套。
+// 查询结果延迟 FRAME_LATENCY 帧读取，正常情况下不会让 CPU 等待 GPU
+class GpuTimer
+{
+  public:
+    static constexpr int FRAME_LATENCY = 4;
+
+    struct Section
+    {
+        std::string name;
+        int depth = 0;         // 嵌套层级，0 为最外层
+        float lastMs = 0.0f;   // 最近一次读回的耗时
+        float averageMs = 0.0f; // 指数滑动平均，供界面显示
+    };
+
+    // 作用域内的 GPU 耗时计入 name 阶段
+    class Scope
+    {
+      public:
+        Scope(GpuTimer &timer, const char *name) : timer(timer)
+        {
+            timer.Begin(name);
+        }
+        ~Scope()
+        {
+            timer.End();
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        GpuTimer &timer;
+    };
+
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer &operator=(const GpuTimer &) = delete;
+
+    // 每帧在第一个阶段之前和最后一个阶段之后调用；BeginFrame 读回 FRAME_LATENCY 帧之前的结果
+    void BeginFrame();
+    void EndFrame();
+
+    void Begin(const char *name);
+    void End();
+
+    // 按第一次出现的顺序排列
+    const std::vector<Section> &GetSections() const
+    {
+        return sections;
+    }
+    // 按名称查找阶段，不存在时返回 nullptr
+    const Section *FindSection(const std::string &name) const;
+    // 整帧（BeginFrame 到 EndFrame）的 GPU 耗时
+    float GetFrameMs() const
+    {
+        return frameMs;
+    }
+    // 已读回结果的帧数，基准测试据此判断是否有新数据
+    uint64_t GetResolvedFrameCount() const
+    {
+        return resolvedFrames;
+    }
+
+    void SetEnabled(bool value)
+    {
+        enabled = value;
+    }
+    bool IsEnabled() const
+    {
+        return enabled;
+    }
+
+  private:
+    struct Record
+    {
+        int section;
+        int beginQuery;
+        int endQuery;
+    };
+
+    struct FrameQueries
+    {
+        std::vector<GLuint> queries; // 按需增长，跨帧复用
+        int used = 0;
+        std::vector<Record> records;
+        int frameBegin = -1;
+        int frameEnd = -1;
+    };
+
+    int IssueTimestamp(FrameQueries &frame);
+    void Resolve(FrameQueries &frame);
+
+    FrameQueries frames[FRAME_LATENCY];
+    int currentFrame = 0;
+    bool inFrame = false;
+    bool enabled = true;
+
+    std::vector<Section> sections;
+    std::unordered_map<std::string, int> sectionIndices;
+    std::vector<Record> openScopes;
+    float frameMs = 0.0f;
+    uint64_t resolvedFrames = 0;
+};
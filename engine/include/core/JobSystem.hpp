@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 作业计数器：记录关联作业中尚未完成的数量，归零时调度挂在其上的后续作业
+class JobCounter
+{
+  public:
+    bool IsDone() const
+    {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+    int GetPending() const
+    {
+        return pending.load(std::memory_order_acquire);
+    }
+
+  private:
+    friend class JobSystem;
+
+    std::atomic<int> pending{0};
+    std::mutex continuationMutex;
+    std::vector<std::function<void()>> continuations;
+};
+
+// 作业系统：每个工作线程持有一个双端队列，自己从尾部取作业，空闲时从其他线程的队列头部窃取。
+//
+// 线程规则：只有 GL 线程（主线程）可以调用 OpenGL。作业中只做 CPU 计算（解码、剔除、矩阵、预计算等），
+// 需要上传到 GPU 的结果由调用方放入队列，在主线程每帧取出上传。
+//
+// 耗时可能达到数秒的文件读取与导入（模型导入、贴图解码）通过 ScheduleBackground 投递到独立的后台队列，
+// 由专门的后台线程执行。主线程和帧内工作线程的 Wait 永远不会执行后台作业，避免 GL 线程被一次导入卡住。
+class JobSystem
+{
+  public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+    static JobSystem &GetInstance();
+
+    // workerCount 为 0 时使用 硬件线程数 - 1（主线程也会在 Wait 时参与执行）；
+    // backgroundCount 为后台 I/O 线程数，至少为 1
+    void Initialize(unsigned int workerCount = 0, unsigned int backgroundCount = 2);
+    void Shutdown();
+
+    // 提交作业；counter 非空时在作业完成后递减
+    void Schedule(Job job, const std::shared_ptr<JobCounter> &counter = nullptr);
+    // 提交到后台队列：只由后台线程执行，用于长时间的 I/O 与导入
+    void ScheduleBackground(Job job, const std::shared_ptr<JobCounter> &counter = nullptr);
+    // dependency 归零后再调度 job；dependency 已归零时立即调度
+    void ScheduleAfter(const std::shared_ptr<JobCounter> &dependency, Job job,
+                       const std::shared_ptr<JobCounter> &counter = nullptr);
+
+    // 把 [begin, end) 按 grainSize 切分为多个作业并行执行，返回前等待全部完成；
+    // 在后台线程中调用时切分出的作业进入后台队列，不占用帧内工作线程
+    void ParallelFor(size_t begin, size_t end, size_t grainSize, const RangeJob &body);
+
+    // 等待计数器归零；等待期间当前线程也会执行队列中的作业：
+    // 后台线程只帮忙执行后台队列，其他线程只帮忙执行帧内队列，从不执行后台作业
+    void Wait(const std::shared_ptr<JobCounter> &counter);
+
+    unsigned int GetWorkerCount() const
+    {
+        return static_cast<unsigned int>(workers.size());
+    }
+    unsigned int GetBackgroundWorkerCount() const
+    {
+        return static_cast<unsigned int>(backgroundWorkers.size());
+    }
+    bool IsInitialized() const
+    {
+        return !workers.empty();
+    }
+    // 当前线程是否为作业系统的工作线程
+    static bool IsWorkerThread();
+    // 当前线程是否为后台 I/O 线程
+    static bool IsBackgroundThread();
+
+  private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    struct JobEntry
+    {
+        Job job;
+        std::shared_ptr<JobCounter> counter;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<JobEntry> jobs;
+    };
+
+    void WorkerLoop(unsigned int index);
+    void BackgroundLoop();
+    void Push(JobEntry entry);
+    bool TryPop(JobEntry &entry);
+    bool TryPopBackground(JobEntry &entry);
+    void Execute(JobEntry &entry);
+    void Finish(const std::shared_ptr<JobCounter> &counter);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // 每个工作线程一个，非工作线程轮流投递
+    std::atomic<unsigned int> nextQueue{0};
+
+    std::atomic<int> queuedJobs{0};
+    std::atomic<bool> running{false};
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+
+    // 后台队列：单一 FIFO，后台作业数量少且耗时长，不需要窃取
+    std::vector<std::thread> backgroundWorkers;
+    std::deque<JobEntry> backgroundJobs;
+    bool backgroundRunning = false; // 受 backgroundMutex 保护
+    std::mutex backgroundMutex;
+    std::condition_variable backgroundCondition;
+};
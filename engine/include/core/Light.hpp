@@ -7,11 +7,37 @@
 #include <imgui.h>
 #include <memory>
 
+// GPU 光源表中的一条记录，与 shaders/common/light_data.glsl 中的 LightData 一一对应（std430）
+struct GpuLightData
+{
+    glm::vec4 position;   // xyz 位置，w 光源类型（0 点光源，1 方向光，2 聚光灯）
+    glm::vec4 direction;  // xyz 方向，w 是否投射阴影
+    glm::vec4 ambient;    // rgb 环境光（已乘强度），a 衰减常数项
+    glm::vec4 diffuse;    // rgb 漫反射（已乘强度），a 衰减一次项
+    glm::vec4 specular;   // rgb 镜面反射（已乘强度），a 衰减二次项
+    glm::vec4 spot;       // x 内切角余弦，y 外切角余弦
+    glm::vec4 shadowRect; // 点光源/聚光灯：阴影图集中的图块（偏移, 缩放）；方向光：x 为级联阴影槽位
+    glm::mat4 lightSpaceMatrix; // 点光源/聚光灯的光源空间矩阵，方向光的级联矩阵在 ShadowCascades UBO 中
+};
+static_assert(sizeof(GpuLightData) == 176, "GpuLightData must match std430 layout");
+
 class Light
 {
   public:
     virtual ~Light() = default;
-    virtual void SetupShader(Shader &shader, int index = 0, bool globalShadowEnabled = true) const = 0;
+
+    // 填充光源表记录
+    virtual void FillGpuData(GpuLightData &data) const = 0;
+
+    // 脏标记：修改光源参数后调用 MarkDirty，光源表只重新上传脏光源
+    void MarkDirty() { dirty = true; }
+    bool IsDirty() const { return dirty; }
+    void ClearDirty() { dirty = false; }
+
+    // 在光源表中的下标，由 LightBuffer 分配
+    int GetGpuIndex() const { return gpuIndex; }
+    void SetGpuIndex(int index) { gpuIndex = index; }
+
     virtual int getNum() const
     {
         return 1; // 默认返回1，子类可以重载此方法
@@ -47,6 +73,13 @@ class Light
     virtual void SetShadowEnabled(bool enabled) {}
     virtual bool IsShadowEnabled() const { return false; }
     virtual int GetShadowMapIndex() const { return -1; } // 获取阴影贴图索引
+    // 阴影图集中的图块矩形：xy 为偏移，zw 为缩放
+    virtual glm::vec4 GetShadowAtlasRect() const { return glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); }
+    virtual void SetShadowAtlasRect(const glm::vec4 &rect) {}
+
+  protected:
+    bool dirty = true;
+    int gpuIndex = -1;
 };
 
 class PointLight : public Light
@@ -54,7 +87,7 @@ class PointLight : public Light
   public:
     PointLight(const glm::vec3 &position = glm::vec3(0.0f), const glm::vec3 &ambient = glm::vec3(1.0f), const glm::vec3 &diffuse = glm::vec3(1.0f), const glm::vec3 &specular = glm::vec3(1.0f), float intensity = 1.0f);
 
-    void SetupShader(Shader &shader, int index = 0, bool globalShadowEnabled = true) const override;
+    void FillGpuData(GpuLightData &data) const override;
     int getNum() const override
     {
         return number;
@@ -81,10 +114,12 @@ class PointLight : public Light
     bool HasShadows() const override { return shadowEnabled; }
     glm::mat4 GetLightSpaceMatrix() const override;
     unsigned int GetShadowMap() const override { return shadowMap; }
-    void SetShadowMap(unsigned int shadowMap) override { this->shadowMap = shadowMap; }
-    void SetShadowEnabled(bool enabled) override { shadowEnabled = enabled; }
+    void SetShadowMap(unsigned int shadowMap) override { if (this->shadowMap != shadowMap) { this->shadowMap = shadowMap; MarkDirty(); } }
+    void SetShadowEnabled(bool enabled) override { if (shadowEnabled != enabled) { shadowEnabled = enabled; MarkDirty(); } }
     bool IsShadowEnabled() const override { return shadowEnabled; }
     int GetShadowMapIndex() const override { return number; }
+    glm::vec4 GetShadowAtlasRect() const override { return shadowAtlasRect; }
+    void SetShadowAtlasRect(const glm::vec4 &rect) override { if (shadowAtlasRect != rect) { shadowAtlasRect = rect; MarkDirty(); } }
 
     int number;
     static int count;
@@ -102,6 +137,7 @@ class PointLight : public Light
     // 阴影参数
     bool shadowEnabled = false;
     unsigned int shadowMap = 0;
+    glm::vec4 shadowAtlasRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
     float shadowNearPlane = 0.1f;
     float shadowFarPlane = 100.0f;
 };
@@ -112,7 +148,7 @@ class DirectionalLight : public Light
     DirectionalLight(const glm::vec3 &direction = glm::vec3(-0.2f, -1.0f, -0.3f),
                      const glm::vec3 &ambient = glm::vec3(1.0f), const glm::vec3 &diffuse = glm::vec3(1.0f), const glm::vec3 &specular = glm::vec3(1.0f), float intensity = 1.0f);
 
-    void SetupShader(Shader &shader, int index = 0, bool globalShadowEnabled = true) const override;
+    void FillGpuData(GpuLightData &data) const override;
     int getNum() const override
     {
         return number;
@@ -134,14 +170,15 @@ class DirectionalLight : public Light
     }
     void drawLightMesh(const std::unique_ptr<Shader> &shader) override;
 
-    // 阴影相关方法
+    // 阴影相关方法（级联阴影，光源空间矩阵每帧由 CascadedShadowMap 按相机计算）
     bool HasShadows() const override { return shadowEnabled; }
-    glm::mat4 GetLightSpaceMatrix() const override;
     unsigned int GetShadowMap() const override { return shadowMap; }
-    void SetShadowMap(unsigned int shadowMap) override { this->shadowMap = shadowMap; }
-    void SetShadowEnabled(bool enabled) override { shadowEnabled = enabled; }
+    void SetShadowMap(unsigned int shadowMap) override { if (this->shadowMap != shadowMap) { this->shadowMap = shadowMap; MarkDirty(); } }
+    void SetShadowEnabled(bool enabled) override { if (shadowEnabled != enabled) { shadowEnabled = enabled; MarkDirty(); } }
     bool IsShadowEnabled() const override { return shadowEnabled; }
     int GetShadowMapIndex() const override { return number; }
+    int GetShadowCascadeSlot() const { return shadowCascadeSlot; }
+    void SetShadowCascadeSlot(int slot) { if (shadowCascadeSlot != slot) { shadowCascadeSlot = slot; MarkDirty(); } }
 
     int number;
     static int count;
@@ -154,10 +191,8 @@ class DirectionalLight : public Light
 
     // 阴影参数
     bool shadowEnabled = false;
-    unsigned int shadowMap = 0;
-    float shadowNearPlane = 0.1f;
-    float shadowFarPlane = 100.0f;
-    float shadowOrthoSize = 20.0f;
+    unsigned int shadowMap = 0;     // 级联阴影纹理数组
+    int shadowCascadeSlot = -1;     // 在级联阴影纹理数组中的槽位
 };
 
 class SpotLight : public Light
@@ -167,7 +202,7 @@ class SpotLight : public Light
               const glm::vec3 &ambient = glm::vec3(1.0f), const glm::vec3 &diffuse = glm::vec3(1.0f), const glm::vec3 &specular = glm::vec3(1.0f),
               float intensity = 1.0f, float cutOff = 12.5f, float outerCutOff = 17.5f);
 
-    void SetupShader(Shader &shader, int index = 0, bool globalShadowEnabled = true) const override;
+    void FillGpuData(GpuLightData &data) const override;
 
     int getNum() const override
     {
@@ -194,10 +229,12 @@ class SpotLight : public Light
     bool HasShadows() const override { return shadowEnabled; }
     glm::mat4 GetLightSpaceMatrix() const override;
     unsigned int GetShadowMap() const override { return shadowMap; }
-    void SetShadowMap(unsigned int shadowMap) override { this->shadowMap = shadowMap; }
-    void SetShadowEnabled(bool enabled) override { shadowEnabled = enabled; }
+    void SetShadowMap(unsigned int shadowMap) override { if (this->shadowMap != shadowMap) { this->shadowMap = shadowMap; MarkDirty(); } }
+    void SetShadowEnabled(bool enabled) override { if (shadowEnabled != enabled) { shadowEnabled = enabled; MarkDirty(); } }
     bool IsShadowEnabled() const override { return shadowEnabled; }
     int GetShadowMapIndex() const override { return number; }
+    glm::vec4 GetShadowAtlasRect() const override { return shadowAtlasRect; }
+    void SetShadowAtlasRect(const glm::vec4 &rect) override { if (shadowAtlasRect != rect) { shadowAtlasRect = rect; MarkDirty(); } }
 
     int number;
     static int count;
@@ -217,6 +254,7 @@ class SpotLight : public Light
     // 阴影参数
     bool shadowEnabled = false;
     unsigned int shadowMap = 0;
+    glm::vec4 shadowAtlasRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
     float shadowNearPlane = 0.1f;
     float shadowFarPlane = 100.0f;
 };
\ No newline at end of file
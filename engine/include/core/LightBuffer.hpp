@@ -0,0 +1,75 @@
+#pragma once
+#include "Light.hpp"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+// 着色器存储缓冲（SSBO）绑定点，需与着色器中的 layout(binding = N) 保持一致
+enum StorageBindingPoint
+{
+    LIGHT_DATA_BINDING = 0,
+    INSTANCE_DATA_BINDING = 1, // RenderQueue 的实例变换表
+    CLUSTER_LIGHTS_BINDING = 2 // LightClusters 的簇光源列表
+};
+
+// GPU 光源表：所有光源打包在一个 SSBO 中，按 [方向光 | 点光源 | 聚光灯] 顺序连续存放。
+// 光源列表不变时只重新上传被标记为脏的光源，列表变化（增删）时整体重建
+class LightBuffer
+{
+  public:
+    explicit LightBuffer(size_t initialCapacity = 64);
+    ~LightBuffer();
+
+    LightBuffer(const LightBuffer &) = delete;
+    LightBuffer &operator=(const LightBuffer &) = delete;
+
+    void Update(const std::vector<std::shared_ptr<DirectionalLight>> &dirLights,
+                const std::vector<std::shared_ptr<PointLight>> &pointLights,
+                const std::vector<std::shared_ptr<SpotLight>> &spotLights);
+
+    // 重新绑定到绑定点（其他代码改动了该绑定点时使用）
+    void Bind() const;
+
+    GLuint GetID() const
+    {
+        return ID;
+    }
+    size_t GetLightCount() const
+    {
+        return records.size();
+    }
+    // 上一次 Update 实际上传的光源数量
+    int GetUploadedCount() const
+    {
+        return uploadedCount;
+    }
+    // CPU 端镜像，顺序与 GPU 光源表一致
+    const std::vector<GpuLightData> &GetRecords() const
+    {
+        return records;
+    }
+    // x 方向光、y 点光源、z 聚光灯数量（尚未 Update 时为 -1）
+    const glm::ivec4 &GetCounts() const
+    {
+        return counts;
+    }
+
+  private:
+    // 与着色器中 LightTable 的头部对应：x 方向光、y 点光源、z 聚光灯数量
+    struct Header
+    {
+        glm::ivec4 counts;
+    };
+
+    void Reserve(size_t count);
+    void UploadRange(size_t first, size_t count) const;
+
+    GLuint ID = 0;
+    size_t capacity = 0;
+
+    std::vector<const Light *> layout; // 当前光源表对应的光源顺序
+    glm::ivec4 counts = glm::ivec4(-1); // 各类光源数量，与 layout 一起判断是否需要重建
+    std::vector<GpuLightData> records; // CPU 端镜像
+    int uploadedCount = 0;
+};
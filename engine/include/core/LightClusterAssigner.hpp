@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+// 分簇光照的 CPU 光源分配，不依赖 GL，LightClusters 的 CPU 回退路径和单元测试共用。
+// 光源球体按 SoA 布局存放，每个簇一次测试 8 个（AVX）或 4 个（SSE）光源，不足一批的部分走标量实现。
+// 簇的划分与相交测试必须与 light_cluster.comp 保持一致
+class LightClusterAssigner
+{
+  public:
+    static constexpr int CLUSTER_X = 16;
+    static constexpr int CLUSTER_Y = 9;
+    static constexpr int CLUSTER_Z = 24;
+    static constexpr int CLUSTER_COUNT = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+    static constexpr int MAX_LIGHTS_PER_CLUSTER = 128;
+    // [簇光源数 | 簇光源下标]，与 ClusterLightTable 布局一致
+    static constexpr size_t DATA_SIZE = CLUSTER_COUNT + static_cast<size_t>(CLUSTER_COUNT) * MAX_LIGHTS_PER_CLUSTER;
+
+    struct Result
+    {
+        int maxClusterLights = 0; // 单个簇的最大光源数（含被截断的部分）
+        int overflowClusters = 0; // 光源数超过 MAX_LIGHTS_PER_CLUSTER 被截断的簇
+    };
+
+    void Clear();
+    // 追加一个视空间球体（xyz 中心，w 影响半径），返回其下标
+    size_t Add(const glm::vec4 &viewSphere);
+
+    size_t GetCount() const
+    {
+        return count;
+    }
+
+    // 按深度切片并行分配，结果写入 data（大小调整为 DATA_SIZE，未使用的槽位不清零）；
+    // 写入的光源下标为 indexOffset + Add 返回的下标，每个簇内按下标升序
+    Result Assign(const glm::mat4 &projection, float nearPlane, float farPlane, uint32_t indexOffset,
+                  std::vector<uint32_t> &data) const;
+
+    // 关闭后全部按标量测试，用于对照测试和基准
+    void SetUseSimd(bool value)
+    {
+        useSimd = value;
+    }
+    bool IsUsingSimd() const
+    {
+        return useSimd;
+    }
+
+  private:
+    std::vector<float> centerX, centerY, centerZ, radius;
+    size_t count = 0;
+    bool useSimd = true;
+};
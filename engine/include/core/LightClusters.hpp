@@ -0,0 +1,81 @@
+#pragma once
+#include "LightBuffer.hpp"
+#include "LightClusterAssigner.hpp"
+#include "Shader.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 分簇光照：视锥按屏幕图块和指数深度切片划分为簇，每帧把点光源和聚光灯（按影响半径的球体近似）
+// 分配到与之相交的簇，前向着色器只遍历片段所在簇的光源列表。
+// 默认用计算着色器分配；驱动不支持计算着色器或手动切换时，用 LightClusterAssigner 在 CPU 上按深度切片并行计算后上传。
+// 簇的划分必须与 common/light_clusters.glsl 保持一致
+class LightClusters
+{
+  public:
+    static constexpr int CLUSTER_X = LightClusterAssigner::CLUSTER_X;
+    static constexpr int CLUSTER_Y = LightClusterAssigner::CLUSTER_Y;
+    static constexpr int CLUSTER_Z = LightClusterAssigner::CLUSTER_Z;
+    static constexpr int CLUSTER_COUNT = LightClusterAssigner::CLUSTER_COUNT;
+    static constexpr int MAX_LIGHTS_PER_CLUSTER = LightClusterAssigner::MAX_LIGHTS_PER_CLUSTER;
+
+    struct Stats
+    {
+        int lights = 0;             // 参与分簇的点光源和聚光灯数量
+        int maxClusterLights = -1;  // 单个簇的最大光源数（仅 CPU 路径可得，GPU 路径为 -1）
+        int overflowClusters = -1;  // 光源数超过 MAX_LIGHTS_PER_CLUSTER 被截断的簇（仅 CPU 路径）
+    };
+
+    explicit LightClusters(const std::string &computeShaderPath);
+    ~LightClusters();
+
+    LightClusters(const LightClusters &) = delete;
+    LightClusters &operator=(const LightClusters &) = delete;
+
+    // 在 FrameData 和光源表更新之后、前向绘制之前调用；view/projection 须与 FrameData 中的一致
+    void Update(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane,
+                const LightBuffer &lights);
+
+    void Bind() const;
+
+    bool IsComputeSupported() const
+    {
+        return computeSupported;
+    }
+    bool IsUsingCompute() const
+    {
+        return useCompute && computeSupported;
+    }
+    void SetUseCompute(bool value)
+    {
+        useCompute = value;
+    }
+
+    // 预热用：返回计算着色器（不支持计算着色器时为 nullptr）
+    Shader *GetComputeShader() const
+    {
+        return computeShader.get();
+    }
+    const Stats &GetStats() const
+    {
+        return stats;
+    }
+
+  private:
+    void UpdateCompute();
+    void UpdateCpu(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane,
+                   const LightBuffer &lights);
+
+    GLuint ID = 0;
+    std::unique_ptr<Shader> computeShader;
+    bool computeSupported = false;
+    bool useCompute = true;
+
+    // CPU 路径：视空间光源球体与暂存数据 [簇光源数 | 簇光源下标]，与 ClusterLightTable 布局一致
+    LightClusterAssigner assigner;
+    std::vector<uint32_t> cpuData;
+
+    Stats stats;
+};
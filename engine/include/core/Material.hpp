@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 #include <core/Shader.hpp>
 
 enum MaterialType
@@ -18,6 +19,22 @@ class Material
     Material(MaterialType type = BLINN_PHONG);
 
     void Bind(Shader &shader);
+    // 设置材质 uniform，不切换着色器程序；bindTextures 为 false 时假定贴图已绑定（渲染队列中贴图组合未变化）
+    void Apply(Shader &shader, bool bindTextures = true);
+    // 解除材质贴图单元上的采样器，避免影响之后复用这些单元的后处理和 G-buffer 采样
+    static void UnbindSamplers();
+
+    // 材质贴图占用的纹理单元数量（0 起）
+    static constexpr int MATERIAL_TEXTURE_UNITS = 5;
+
+    // 当前启用的贴图组合的哈希，贴图相同的材质可以共用一次贴图绑定
+    size_t GetTextureSetHash() const;
+
+    // 当前启用的贴图对应的着色器变体特性（ShaderFeature 位掩码），渲染时据此选择变体
+    uint32_t GetShaderFeatures() const;
+
+    // 向当前启用的贴图报告本帧使用该材质的物体在屏幕上的像素尺寸（mip 流式加载据此选择分辨率）
+    void RequestTextureScreenSize(float pixels) const;
 
     // Blinn-Phong 参数
     glm::vec3 diffuse = glm::vec3(0.8f);
@@ -51,4 +68,21 @@ class Material
 
     MaterialType type;
     std::string name = "New Material";
+
+  private:
+    // 按着色器程序缓存的 uniform 句柄，绑定材质时不再做字符串查找。
+    // 以 Shader 对象和程序代号为键：程序名和对象地址都可能在着色器销毁后被复用
+    struct UniformCache
+    {
+        const Shader *shader = nullptr;
+        uint64_t generation = 0;
+        UniformHandle diffuse, specular, shininess;
+        UniformHandle diffuseMap, specularMap, normalMap;
+        UniformHandle albedo, metallic, roughness, ao;
+        UniformHandle albedoMap, metallicMap, roughnessMap, aoMap;
+    };
+    const UniformCache &GetUniformCache(const Shader &shader);
+    static constexpr size_t MAX_UNIFORM_CACHES = 16;
+
+    std::vector<UniformCache> uniformCaches;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Bounds.hpp"
 #include "Material.hpp"
 #include "Shader.hpp"
 #include <glm/glm.hpp>
@@ -20,9 +21,59 @@ class Mesh
   public:
     Mesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
          const std::shared_ptr<Material> &material = nullptr);
+    // 使用导入时已计算好的包围体（网格缓存、工作线程导入），接管顶点和索引数据
+    Mesh(std::vector<Vertex> &&vertices, std::vector<unsigned int> &&indices, const std::shared_ptr<Material> &material,
+         const AABB &bounds, const BoundingSphere &sphere);
     ~Mesh();
 
     void Draw(Shader &shader);
+    // 使用外部提供的变换绘制（模型的子网格共享模型的世界矩阵）
+    void Draw(Shader &shader, const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix);
+    // 使用外部提供的材质绘制（模型实例可覆盖共享网格的材质）
+    void Draw(Shader &shader, Material &material, const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix);
+
+    // 仅深度绘制：只使用紧凑的位置顶点流和模型矩阵，不绑定材质
+    void DrawDepthOnly(Shader &shader);
+    void DrawDepthOnly(Shader &shader, const glm::mat4 &modelMatrix);
+
+    // 由位置、欧拉角（度）和缩放组合模型矩阵
+    static glm::mat4 ComputeModelMatrix(const glm::vec3 &pos, const glm::vec3 &rot, const glm::vec3 &scl);
+    // 法线矩阵：模型矩阵左上 3x3 的逆转置
+    static glm::mat3 ComputeNormalMatrix(const glm::mat4 &model);
+
+    // 缓存的世界矩阵，只在 SetTransform 改变变换时重新计算
+    const glm::mat4 &GetModelMatrix() const
+    {
+        return modelMatrix;
+    }
+    const glm::mat3 &GetNormalMatrix() const
+    {
+        return normalMatrix;
+    }
+
+    // 局部空间包围体，在上传顶点时计算
+    const AABB &GetLocalBounds() const
+    {
+        return localBounds;
+    }
+    const BoundingSphere &GetLocalBoundingSphere() const
+    {
+        return localSphere;
+    }
+    // 按缓存的世界矩阵变换后的包围盒
+    const AABB &GetWorldBounds() const
+    {
+        return worldBounds;
+    }
+
+    unsigned int GetVAO() const
+    {
+        return VAO;
+    }
+    unsigned int GetIndexCount() const
+    {
+        return static_cast<unsigned int>(indices.size());
+    }
 
     const std::vector<Vertex> &GetVertices() const
     {
@@ -43,9 +94,12 @@ class Mesh
     }
     void SetTransform(const glm::vec3 &pos, const glm::vec3 &rot, const glm::vec3 &scl)
     {
+        if (pos == position && rot == rotation && scl == scale)
+            return;
         position = pos;
         rotation = rot;
         scale = scl;
+        UpdateMatrices();
     }
 
     const std::string &GetName() const
@@ -63,6 +117,8 @@ class Mesh
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
         glDeleteBuffers(1, &EBO);
+        glDeleteVertexArrays(1, &depthVAO);
+        glDeleteBuffers(1, &positionVBO);
         // 重新设置数据
         this->vertices = vertices;
         this->indices = indices;
@@ -78,16 +134,25 @@ class Mesh
     }
   private:
     void SetupMesh();
+    void SetupBuffers();
+    void UpdateMatrices();
 
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
     std::shared_ptr<Material> material;
 
     unsigned int VAO, VBO, EBO;
+    unsigned int depthVAO, positionVBO; // 仅位置的顶点流，与主 VAO 共用 EBO
 
     glm::vec3 position = glm::vec3(0.0f);
     glm::vec3 rotation = glm::vec3(0.0f);
     glm::vec3 scale = glm::vec3(1.0f);
+    glm::mat4 modelMatrix = glm::mat4(1.0f);
+    glm::mat3 normalMatrix = glm::mat3(1.0f);
+
+    AABB localBounds;
+    BoundingSphere localSphere;
+    AABB worldBounds;
 
     std::string name = "Mesh";
 };
\ No newline at end of file
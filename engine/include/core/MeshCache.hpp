@@ -0,0 +1,73 @@
+#pragma once
+#include "ModelAsset.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// 处理后网格的二进制缓存：以模型路径、文件修改时间和 Assimp 后处理选项为键，
+// 保存最终的顶点/索引数据、材质参数、贴图绑定和局部包围体。
+// 命中时跳过 Assimp 和逐顶点转换，顶点和索引整块读入后可直接交给 glBufferData。
+//
+// 文件布局（小端）：
+//   文件头 | 源文件路径 | 网格表（定长） | 材质（变长） | 贴图及其绑定（变长） | 数据区（16 字节对齐，顶点与索引按网格表中的偏移存放）
+class MeshCache
+{
+  public:
+    static MeshCache &GetInstance();
+
+    // 创建缓存目录并启用缓存
+    void Initialize(const std::string &directory);
+
+    // 以下函数可在工作线程中调用
+    // 命中时填充 data 的网格和贴图列表（贴图只有路径，尚未解码）
+    bool Load(const std::string &path, unsigned int importFlags, ModelImportData &data) const;
+    bool Store(const std::string &path, unsigned int importFlags, const ModelImportData &data) const;
+
+    bool IsEnabled() const
+    {
+        return enabled;
+    }
+    void SetEnabled(bool value)
+    {
+        enabled = value && initialized;
+    }
+
+  private:
+    MeshCache() = default;
+    ~MeshCache() = default;
+    MeshCache(const MeshCache &) = delete;
+    MeshCache &operator=(const MeshCache &) = delete;
+
+    // 源文件不存在时返回 false
+    bool MakeKey(const std::string &path, unsigned int importFlags, uint64_t &key, int64_t &sourceTime) const;
+    std::string GetFilePath(uint64_t key) const;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;
+        int64_t sourceTime;
+        uint32_t importFlags;
+        uint32_t meshCount;
+        uint32_t textureCount;
+        uint32_t vertexSize; // sizeof(Vertex)，顶点结构变化时缓存失效
+        uint64_t dataOffset; // 数据区在文件中的偏移
+        uint64_t dataSize;
+    };
+    struct FileMesh
+    {
+        uint64_t vertexOffset; // 相对数据区
+        uint64_t indexOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        float boundsMin[3];
+        float boundsMax[3];
+        float sphereCenter[3];
+        float sphereRadius;
+    };
+
+    std::string directory;
+    bool initialized = false;
+    std::atomic<bool> enabled{false};
+};
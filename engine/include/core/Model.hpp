@@ -1,24 +1,65 @@
 #pragma once
 
-#include "Mesh.hpp"
-#include <assimp/scene.h>
+#include "ModelAsset.hpp"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
-
+// 场景中的模型实例：共享 ModelAsset 的网格和 GPU 缓冲，自身只保存变换和材质。
+// 每个子网格默认使用资源的共享材质，OverrideMaterial 后改为该实例独有的副本
 class Model
 {
   public:
-    Model(const std::string &path);
+    using LoadState = ModelAsset::LoadState;
+
+    explicit Model(const std::shared_ptr<ModelAsset> &asset);
+    // 同步加载：通过 ModelManager 取得（或导入）资源
+    explicit Model(const std::string &path);
+
+    // 资源的网格列表变化后（异步加载完成）重建材质列表和包围盒；每帧由渲染器调用
+    void SyncWithAsset();
+
+    LoadState GetLoadState() const
+    {
+        return asset->GetLoadState();
+    }
+    bool IsResident() const
+    {
+        return asset->IsResident();
+    }
+    const std::shared_ptr<ModelAsset> &GetAsset() const
+    {
+        return asset;
+    }
 
     void Draw(Shader &shader);
     void DrawWithMaterialType(Shader &shader, MaterialType materialType);
+    // 仅深度绘制（阴影等深度阶段），不绑定材质
+    void DrawDepthOnly(Shader &shader);
     
     const std::vector<std::shared_ptr<Mesh>> &GetMeshes() const
     {
-        return meshes;
+        return asset->GetMeshes();
+    }
+    // 第 i 个子网格在本实例中使用的材质（共享材质或实例覆盖）
+    const std::shared_ptr<Material> &GetMaterial(size_t index) const
+    {
+        return materials[index];
     }
+    const std::vector<std::shared_ptr<Material>> &GetMaterials() const
+    {
+        return materials;
+    }
+    // 为第 i 个子网格创建实例独有的材质副本（已覆盖时直接返回），修改它不影响其他实例
+    const std::shared_ptr<Material> &OverrideMaterial(size_t index);
+    // 撤销覆盖，恢复使用资源的共享材质
+    void ResetMaterial(size_t index);
+    bool HasMaterialOverride(size_t index) const
+    {
+        return overridden[index] != 0;
+    }
+
     const std::string &GetName() const
     {
         return name;
@@ -26,9 +67,14 @@ class Model
 
     void SetTransform(const glm::vec3 &pos, const glm::vec3 &rot, const glm::vec3 &scl)
     {
+        if (pos == position && rot == rotation && scl == scale)
+            return;
         position = pos;
         rotation = rot;
         scale = scl;
+        modelMatrix = Mesh::ComputeModelMatrix(position, rotation, scale);
+        normalMatrix = Mesh::ComputeNormalMatrix(modelMatrix);
+        UpdateWorldBounds();
     }
 
     void SetName(const std::string &newName)
@@ -48,27 +94,40 @@ class Model
     {
         return scale;
     }
+    // 缓存的世界矩阵，所有子网格共享
+    const glm::mat4 &GetModelMatrix() const
+    {
+        return modelMatrix;
+    }
+    const glm::mat3 &GetNormalMatrix() const
+    {
+        return normalMatrix;
+    }
+    // 第 i 个子网格在世界空间的包围盒（随模型变换更新）
+    const AABB &GetMeshWorldBounds(size_t index) const
+    {
+        return meshWorldBounds[index];
+    }
     const std::string &GetPath() const
     {
-        return path;
+        return asset->GetPath();
     }
 
   private:
-    void LoadModel(const std::string &path);
-    void ProcessNode(aiNode *node, const aiScene *scene);
-    std::shared_ptr<Mesh> ProcessMesh(aiMesh *mesh, const aiScene *scene);
-    std::shared_ptr<Material> LoadMaterial(aiMaterial *mat);
-    std::vector<std::shared_ptr<Texture>> LoadMaterialTextures(aiMaterial *mat, aiTextureType type,
-                                                               const std::string &typeName);
+    void UpdateWorldBounds();
+
+    std::shared_ptr<ModelAsset> asset;
+    unsigned int syncedVersion = 0;
 
-    std::vector<std::shared_ptr<Mesh>> meshes;
-    std::string directory;
-    std::vector<std::shared_ptr<Texture>> texturesLoaded;
+    std::vector<std::shared_ptr<Material>> materials;
+    std::vector<uint8_t> overridden;
 
     glm::vec3 position = glm::vec3(0.0f);
     glm::vec3 rotation = glm::vec3(0.0f);
     glm::vec3 scale = glm::vec3(1.0f);
+    glm::mat4 modelMatrix = glm::mat4(1.0f);
+    glm::mat3 normalMatrix = glm::mat3(1.0f);
+    std::vector<AABB> meshWorldBounds;
 
     std::string name = "Model";
-    std::string path; // 模型文件路径
-};
\ No newline at end of file
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include <assimp/scene.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 模型导入的 CPU 端结果（Assimp 解析、顶点转换、贴图解码），不包含任何 GL 对象，可在工作线程中生成
+struct ModelImportData
+{
+    struct MeshData
+    {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        std::shared_ptr<Material> material;
+        AABB bounds; // 局部包围体，导入时计算
+        BoundingSphere sphere;
+    };
+
+    // 贴图在材质中的位置：上传后写入 material->*map 并打开 material->*useFlag
+    struct TextureSlot
+    {
+        Material *material;
+        std::shared_ptr<Texture> Material::*map;
+        bool Material::*useFlag;
+    };
+
+    struct TextureData
+    {
+        std::string path;
+        std::string typeName;
+        TextureImage image;
+        std::vector<TextureSlot> slots;
+    };
+
+    std::string path;
+    bool success = false;
+    std::vector<MeshData> meshes;
+    std::vector<TextureData> textures; // 按路径去重
+};
+
+// 模型资源：一个模型文件导入后的不可变部分（网格、GPU 缓冲、贴图和默认材质）。
+// 由 ModelManager 按路径缓存，场景中引用同一文件的多个 Model 实例共享同一份资源
+class ModelAsset
+{
+  public:
+    enum LoadState
+    {
+        LOAD_RESIDENT, // 网格和贴图都已上传
+        LOAD_PENDING,  // 异步导入中，显示占位网格
+        LOAD_FAILED
+    };
+
+    // 同步加载：在当前线程导入并立即上传
+    static std::shared_ptr<ModelAsset> Load(const std::string &path);
+    // 异步加载用：创建只含占位网格的资源，导入完成后由 UploadStep 逐步替换为真实网格
+    static std::shared_ptr<ModelAsset> CreatePlaceholder(const std::string &path);
+    // CPU 端导入，不调用 GL，可在工作线程中执行；网格缓存命中时跳过 Assimp
+    static std::shared_ptr<ModelImportData> Import(const std::string &path);
+    // 在 GL 线程上传导入结果中的下一项（一张贴图或一个网格）；全部完成后替换占位网格并返回 true
+    bool UploadStep(ModelImportData &data);
+    // 导入失败：移除占位网格，与同步加载失败时一样保留一个空资源
+    void MarkLoadFailed();
+
+    LoadState GetLoadState() const
+    {
+        return loadState;
+    }
+    bool IsResident() const
+    {
+        return loadState == LOAD_RESIDENT;
+    }
+    const std::vector<std::shared_ptr<Mesh>> &GetMeshes() const
+    {
+        return meshes;
+    }
+    const std::string &GetPath() const
+    {
+        return path;
+    }
+    // 网格列表每次被替换（占位网格换成真实网格、加载失败）时递增，实例据此重新同步材质和包围盒
+    unsigned int GetVersion() const
+    {
+        return version;
+    }
+
+  private:
+    ModelAsset() = default;
+
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    std::vector<std::shared_ptr<Texture>> texturesLoaded; // 持有引用，资源存在期间贴图不会被 TextureManager 淘汰
+
+    // 异步上传进度
+    LoadState loadState = LOAD_RESIDENT;
+    size_t uploadTextureIndex = 0;
+    size_t uploadMeshIndex = 0;
+    std::vector<std::shared_ptr<Mesh>> pendingMeshes;
+
+    unsigned int version = 0;
+    std::string path; // 模型文件路径
+};
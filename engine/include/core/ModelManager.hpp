@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ModelAsset.hpp"
+
+class JobCounter;
+
+// 模型资源缓存：同一路径只导入、上传一次，场景中的多个 Model 实例共享同一个 ModelAsset。
+// 缓存只持有弱引用，最后一个实例被删除后资源（GPU 缓冲、贴图）随之释放
+class ModelManager
+{
+public:
+    static ModelManager& GetInstance();
+
+    // 同步获取资源：缓存中存在直接返回，否则在当前线程导入并上传；
+    // 同一路径仍在异步加载时等待导入完成并立即上传剩余部分，返回时资源已就绪（或加载失败）
+    std::shared_ptr<ModelAsset> Load(const std::string& path);
+
+    // 异步获取资源：缓存未命中时立即返回占位资源（LOAD_PENDING），
+    // 导入在后台 I/O 线程完成，之后由 ProcessUploads 在主线程按时间预算分步上传
+    std::shared_ptr<ModelAsset> LoadAsync(const std::string& path);
+
+    // 每帧在主线程调用一次，budgetMs 为本帧上传的时间预算（至少推进一步）
+    void ProcessUploads(float budgetMs);
+
+    size_t GetPendingCount() const
+    {
+        return pendingLoads.size();
+    }
+    // 当前仍被实例引用的资源数量
+    size_t GetAssetCount() const;
+
+private:
+    ModelManager() = default;
+    ~ModelManager() = default;
+    ModelManager(const ModelManager&) = delete;
+    ModelManager& operator=(const ModelManager&) = delete;
+
+    // 返回缓存中仍然存活且未加载失败的资源，过期条目顺带清理
+    std::shared_ptr<ModelAsset> FindCached(const std::string& path);
+    // 在当前线程完成 asset 的异步加载（等待导入作业并上传全部剩余项）
+    void FinishPending(const std::shared_ptr<ModelAsset>& asset);
+
+    // 导入作业只写 ImportTask，资源本身只在主线程访问
+    struct ImportTask
+    {
+        std::shared_ptr<ModelImportData> data;
+        std::atomic<bool> ready{false};
+        std::shared_ptr<JobCounter> counter; // 同步 Load 需要等待导入时使用
+    };
+    struct PendingLoad
+    {
+        std::shared_ptr<ModelAsset> asset;
+        std::shared_ptr<ImportTask> task;
+    };
+
+    std::unordered_map<std::string, std::weak_ptr<ModelAsset>> assetCache;
+    std::vector<PendingLoad> pendingLoads;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <glad/glad.h>
+#include <vector>
+
+// 持久映射的像素解包缓冲环（GL_PIXEL_UNPACK_BUFFER），用于纹理流式上传。
+// 缓冲分为若干段，每帧写入一段，帧末在该段后插入栅栏；再次写入该段前等待 GPU 读取完成，
+// 因此 CPU 拷贝与 GPU 的纹理传输可以重叠，不会因为同步 glTexImage2D 阻塞主线程
+class PixelUploadRing
+{
+  public:
+    PixelUploadRing(size_t segmentSize, int segmentCount = 3);
+    ~PixelUploadRing();
+
+    PixelUploadRing(const PixelUploadRing &) = delete;
+    PixelUploadRing &operator=(const PixelUploadRing &) = delete;
+
+    // 在当前段中分配 size 字节；成功时返回缓冲内偏移和对应的映射地址，当前段空间不足时返回 false
+    bool Allocate(size_t size, size_t &offset, void *&mapped);
+
+    // 结束当前帧：为已写入的段插入栅栏并切换到下一段
+    void EndFrame();
+
+    void Bind() const;
+    static void Unbind();
+
+    bool IsValid() const
+    {
+        return mappedBase != nullptr;
+    }
+    size_t GetSegmentSize() const
+    {
+        return segmentSize;
+    }
+    // 当前段已使用的字节数
+    size_t GetUsedBytes() const
+    {
+        return used;
+    }
+
+  private:
+    void WaitForSegment(int index);
+
+    GLuint ID = 0;
+    unsigned char *mappedBase = nullptr;
+    size_t segmentSize;
+    int segmentCount;
+
+    int current = 0;
+    size_t used = 0;
+    bool segmentAcquired = false; // 当前段是否已等待过栅栏
+    std::vector<GLsync> fences;
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include "Material.hpp"
+#include "Mesh.hpp"
+#include "Shader.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+// 一次绘制所需的全部状态
+struct DrawPacket
+{
+    uint64_t sortKey = 0;
+    Shader *shader = nullptr;
+    Material *material = nullptr;
+    size_t textureSet = 0; // 材质贴图组合哈希
+    unsigned int vao = 0;
+    unsigned int indexCount = 0;
+    const glm::mat4 *world = nullptr;  // 指向物体缓存的世界矩阵
+    const glm::mat3 *normal = nullptr; // 指向物体缓存的法线矩阵
+};
+
+// 实例变换表中的一项（std430，与 common/instance_data.glsl 保持一致）
+struct InstanceTransform
+{
+    glm::mat4 model;
+    glm::mat4 normalMatrix; // 左上 3x3 为法线矩阵
+};
+
+// 渲染队列：每帧收集一次绘制包，按 64 位排序键排序后提交，
+// 提交时跳过与上一个绘制包相同的着色器、材质、贴图和 VAO 绑定。
+// 所有绘制包的变换按排序后的顺序写入实例变换表（SSBO），着色器、材质和网格都相同的
+// 连续绘制包合并为一次实例化绘制（baseInstance 指向表中的第一项）
+//
+// 排序键（高位优先）：
+//   [63..60] 渲染阶段  [59..52] 着色器  [51..36] 贴图组合  [35..22] 材质  [21..10] 网格  [9..0] 深度（由近到远）
+//   编号超出位宽时饱和到最大值，只影响分组效果，不影响正确性
+class RenderQueue
+{
+  public:
+    enum Pass : uint8_t
+    {
+        PASS_OPAQUE = 0
+    };
+
+    // 提交统计，用于观察状态切换次数
+    struct Stats
+    {
+        int drawCalls = 0;
+        int programBinds = 0;
+        int materialBinds = 0;
+        int textureSetBinds = 0;
+        int vaoBinds = 0;
+        int instances = 0;        // 提交的绘制包（实例）数
+        int instancedBatches = 0; // 合并了两个及以上实例的绘制调用数
+    };
+
+    RenderQueue() = default;
+    ~RenderQueue();
+    RenderQueue(const RenderQueue &) = delete;
+    RenderQueue &operator=(const RenderQueue &) = delete;
+
+    void Clear();
+
+    // 相机位置与远平面，用于计算深度排序
+    void SetView(const glm::vec3 &viewPos, float farPlane);
+
+    // material 为本次绘制使用的材质（模型实例可能覆盖网格自带的材质）；
+    // world/normal 须在提交前保持有效（通常是 Model 或 Mesh 缓存的矩阵）
+    void Add(Shader &shader, Mesh &mesh, Material &material, const glm::mat4 &world, const glm::mat3 &normal,
+             Pass pass = PASS_OPAQUE);
+
+    void Sort();
+    void Submit();
+
+    size_t GetPacketCount() const
+    {
+        return packets.size();
+    }
+    const Stats &GetStats() const
+    {
+        return stats;
+    }
+
+  private:
+    struct ShaderEntry
+    {
+        Shader *shader;
+        UniformHandle useInstanceData;
+    };
+
+    uint32_t GetShaderIndex(Shader *shader);
+    uint32_t GetTextureSetIndex(size_t textureSetHash);
+    uint32_t GetMaterialIndex(const Material *material);
+    uint32_t GetMeshIndex(unsigned int vao);
+    // 按排序后的顺序写入并上传实例变换表
+    void UploadInstances();
+
+    std::vector<DrawPacket> packets;
+    std::vector<std::pair<uint64_t, uint32_t>> order; // 排序后的（排序键, 绘制包下标）
+
+    // 每帧重新分配的紧凑编号，保证能放进排序键的位宽
+    std::vector<ShaderEntry> shaders;
+    std::unordered_map<const Shader *, uint32_t> shaderIndices;
+    std::unordered_map<size_t, uint32_t> textureSetIndices;
+    std::unordered_map<const Material *, uint32_t> materialIndices;
+    std::unordered_map<unsigned int, uint32_t> meshIndices;
+
+    std::vector<InstanceTransform> instanceData;
+    unsigned int instanceBuffer = 0; // 首次提交时创建（需要 GL 上下文）
+
+    glm::vec3 viewPos = glm::vec3(0.0f);
+    float farPlane = 100.0f;
+
+    Stats stats;
+};
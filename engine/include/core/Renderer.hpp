@@ -1,12 +1,23 @@
 ﻿#pragma once
 
 #include "Camera.hpp"
+#include "CascadedShadowMap.hpp"
 #include "Framebuffer.hpp"
+#include "FrustumCuller.hpp"
 #include "Geometry.hpp"
+#include "GpuTimer.hpp"
 #include "Light.hpp"
+#include "LightBuffer.hpp"
+#include "LightClusters.hpp"
 #include "Material.hpp"
 #include "Model.hpp"
+#include "ModelManager.hpp"
+#include "RenderQueue.hpp"
 #include "Shader.hpp"
+#include "ShaderVariants.hpp"
+#include "ShadowAtlas.hpp"
+#include "UniformBuffer.hpp"
+#include <chrono>
 #include <glm/glm.hpp>
 #include <memory>
 #include <unordered_map>
@@ -18,7 +29,18 @@ class Renderer
     enum RenderMode
     {
         FORWARD,
-        DEFERRED
+        DEFERRED,
+        TILED_DEFERRED // 几何阶段同 DEFERRED，光照阶段由计算着色器按屏幕图块一次完成
+    };
+
+    // 视锥剔除统计（阴影部分累计本帧重绘的所有图块）
+    struct CullingStats
+    {
+        int objects = 0;
+        int cameraVisible = 0;
+        int cameraCulled = 0;
+        int shadowVisible = 0;
+        int shadowCulled = 0;
     };
 
     enum BackgroundType
@@ -45,6 +67,7 @@ class Renderer
     void UseShader(const std::shared_ptr<Shader> &shader);
 
     void UseShader(const std::string &name);
+    // 上传每帧共享的相机矩阵与全局开关（FrameData UBO），每帧调用一次
     void SetGlobalUniforms(const Camera &camera);
     void SetEnvironmentMap(const std::shared_ptr<Texture> &texture);
     void SetSkybox(const std::shared_ptr<Texture> &texture);
@@ -65,6 +88,30 @@ class Renderer
 
     // 模型加载
     std::shared_ptr<Model> LoadModel(const std::string &path);
+    // 异步加载：立即返回加入场景的占位模型（GetLoadState 为 LOAD_PENDING），
+    // Assimp 解析与贴图解码在工作线程完成，GPU 上传在 Update 中按每帧时间预算分步进行
+    std::shared_ptr<Model> LoadModelAsync(const std::string &path);
+    size_t GetPendingModelLoadCount() const
+    {
+        return ModelManager::GetInstance().GetPendingCount();
+    }
+    void SetModelUploadBudget(float milliseconds)
+    {
+        modelUploadBudgetMs = milliseconds;
+    }
+
+    // 后台编译尚未完成的场景着色器数量，为 0 之前视口只清屏
+    size_t GetPendingShaderCount() const
+    {
+        return pendingShaders.size();
+    }
+    // 已编译的场景着色器变体总数
+    size_t GetShaderVariantCount() const;
+    // 从提交编译到全部着色器可用的耗时（毫秒），编译完成前为 0
+    double GetShaderLoadMs() const
+    {
+        return shaderLoadMs;
+    }
 
     // 光源管理
     void AddLight(const std::shared_ptr<Light> &light);
@@ -132,6 +179,40 @@ class Renderer
     {
         return shadowEnabled;
     }
+    // 本帧实际重绘的阴影图块数量
+    int GetShadowTilesUpdated() const
+    {
+        return shadowTilesUpdated;
+    }
+    // 本帧实际重绘的方向光级联数量
+    int GetShadowCascadesUpdated() const
+    {
+        return shadowCascadesUpdated;
+    }
+    // 方向光级联阴影（级联数、分割方式等设置）
+    CascadedShadowMap *GetCascadedShadowMap() const
+    {
+        return cascadedShadowMap.get();
+    }
+    // 上一次提交渲染队列的绘制与状态切换统计
+    const RenderQueue::Stats &GetRenderQueueStats() const
+    {
+        return renderQueue.GetStats();
+    }
+    const CullingStats &GetCullingStats() const
+    {
+        return cullingStats;
+    }
+    // 各渲染阶段的 GPU 耗时（阴影、前向/G 缓冲、SSAO、光照、后处理）
+    const GpuTimer &GetGpuTimer() const
+    {
+        return gpuTimer;
+    }
+    // G 缓冲（含深度）每像素字节数，几何阶段每帧写入一次、光照阶段读取
+    int GetGBufferBytesPerPixel() const
+    {
+        return gBuffer ? gBuffer->GetBytesPerPixel() : 0;
+    }
     bool IsIBLEnabled() const
     {
         return iblEnabled;
@@ -140,6 +221,30 @@ class Renderer
     {
         return showLights;
     }
+    // 前向渲染的分簇光照：关闭时每个片段遍历全部光源
+    void SetClusteredLighting(bool enabled)
+    {
+        clusteredLighting = enabled;
+    }
+    bool IsClusteredLightingEnabled() const
+    {
+        return clusteredLighting;
+    }
+    LightClusters *GetLightClusters() const
+    {
+        return lightClusters.get();
+    }
+    // 按需选择着色器变体（默认开启）。关闭时材质通道一律使用包含全部贴图特性的变体，
+    // 延迟光照使用包含全部全局特性的变体，作为改用变体之前按 uniform 分支的单一着色器的近似（开销上界），
+    // 仅供基准测试对比
+    void SetShaderPermutations(bool enabled)
+    {
+        shaderPermutations = enabled;
+    }
+    bool IsShaderPermutationsEnabled() const
+    {
+        return shaderPermutations;
+    }
     
     // 背景gamma校正设置
     void SetBackgroundGammaCorrection(bool enabled)
@@ -219,9 +324,9 @@ class Renderer
         std::vector<std::shared_ptr<Material>> allMaterials;
         for (const auto &model : models)
         {
-            for (const auto &mesh : model->GetMeshes())
+            for (const auto &material : model->GetMaterials())
             {
-                allMaterials.push_back(mesh->GetMaterial());
+                allMaterials.push_back(material);
             }
         }
         for (const auto &primitive : primitives)
@@ -250,20 +355,27 @@ class Renderer
     {
         return viewportBuffer->GetColorTexture(0); // 假设你有这个函数
     }
+    // 不经过编辑器界面，把渲染结果缩放拷贝到窗口的默认帧缓冲（基准测试模式使用）
+    void PresentViewport(int windowWidth, int windowHeight);
 
     // 调试视口：获取各个渲染步骤的纹理
-    GLuint GetGBufferPositionTexture() const { return gBuffer ? gBuffer->GetColorTexture(0) : 0; }
-    GLuint GetGBufferNormalTexture() const { return gBuffer ? gBuffer->GetColorTexture(1) : 0; }
-    GLuint GetGBufferAlbedoTexture() const { return gBuffer ? gBuffer->GetColorTexture(2) : 0; }
-    GLuint GetGBufferDiffuseTexture() const { return gBuffer ? gBuffer->GetColorTexture(2) : 0; }  // 漫反射（与反照率相同）
-    GLuint GetGBufferAlbedoDepthTexture() const { return gBuffer ? gBuffer->GetColorTexture(2) : 0; }  // gAlbedo第四维度的深度
-    GLuint GetGBufferSpecularTexture() const { return gBuffer ? gBuffer->GetColorTexture(3) : 0; }
-    GLuint GetGBufferMetallicTexture() const { return gBuffer ? gBuffer->GetColorTexture(4) : 0; }
-    GLuint GetGBufferRoughnessTexture() const { return gBuffer ? gBuffer->GetColorTexture(5) : 0; }
-    GLuint GetGBufferAOTexture() const { return gBuffer ? gBuffer->GetColorTexture(6) : 0; }
-    GLuint GetGBufferAmbientTexture() const { return gBuffer ? gBuffer->GetColorTexture(7) : 0; }
+    // G 缓冲为紧凑编码，以下纹理由 RequestGBufferDebugView 请求后在下一帧解码得到
+    void RequestGBufferDebugView()
+    {
+        gBufferDebugRequested = true;
+    }
+    GLuint GetGBufferPositionTexture() const { return GetGBufferDebugTexture(0); }
+    GLuint GetGBufferNormalTexture() const { return GetGBufferDebugTexture(1); }
+    GLuint GetGBufferAlbedoTexture() const { return GetGBufferDebugTexture(2); }
+    GLuint GetGBufferDiffuseTexture() const { return GetGBufferDebugTexture(2); }  // 漫反射（与反照率相同）
+    GLuint GetGBufferAlbedoDepthTexture() const { return GetGBufferDebugTexture(2); }
+    GLuint GetGBufferSpecularTexture() const { return GetGBufferDebugTexture(3); }
+    GLuint GetGBufferMetallicTexture() const { return GetGBufferDebugTexture(4); }
+    GLuint GetGBufferRoughnessTexture() const { return GetGBufferDebugTexture(5); }
+    GLuint GetGBufferAOTexture() const { return GetGBufferDebugTexture(6); }
+    GLuint GetGBufferAmbientTexture() const { return GetGBufferDebugTexture(7); }
     GLuint GetGBufferDepthTexture() const { return gBuffer ? gBuffer->GetDepthTexture() : 0; }
-    GLuint GetShadowMapTexture() const { return shadowBuffer ? shadowBuffer->GetDepthTexture() : 0; }
+    GLuint GetShadowMapTexture() const { return shadowAtlas ? shadowAtlas->GetDepthTexture() : 0; }
     GLuint GetSSAOTexture() const { return ssaoBuffer ? ssaoBuffer->GetColorTexture(0) : 0; }
     GLuint GetSSAOBlurTexture() const { return ssaoBlurBuffer ? ssaoBlurBuffer->GetColorTexture(0) : 0; }
     GLuint GetHDRTexture() const { return hdrBuffer ? hdrBuffer->GetColorTexture(0) : 0; }
@@ -274,8 +386,42 @@ class Renderer
     void LoadScene(const std::string &path);
 
   private:
+    // 与 shaders/common/frame_data.glsl 中的 FrameData block 一一对应（std140）
+    struct FrameData
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProj;
+        glm::vec3 viewPos;
+        float time;
+        glm::vec2 screenSize;
+        float nearPlane;
+        float farPlane;
+        // std140 中 bool 占 4 字节
+        int shadowEnabled;
+        int ssaoEnabled;
+        int iblEnabled;
+        int hdrEnabled;
+        int bloomEnabled;
+        int gammaEnabled;
+        float deltaTime;
+        float padding;
+        // 从深度重建位置
+        glm::mat4 inverseProjection;
+        glm::mat4 inverseView;
+    };
+    static_assert(sizeof(FrameData) == 384, "FrameData must match std140 layout");
+
     void RenderForward();
     void RenderDeferred();
+    // 分块延迟光照：G 缓冲已绑定到纹理单元，结果写入 hdrBuffer 的颜色纹理
+    void RenderTiledDeferredLighting(uint32_t globalFeatures);
+    // 把紧凑 G 缓冲解码到调试缓冲（按旧的逐属性布局）
+    void DecodeGBufferDebugView();
+    GLuint GetGBufferDebugTexture(unsigned int index) const
+    {
+        return gBufferDebugBuffer ? gBufferDebugBuffer->GetColorTexture(index) : 0;
+    }
     void RenderPostProcessing();
     void RenderLights();
     void RenderQuad();
@@ -295,10 +441,28 @@ class Renderer
     void GenerateSSAONoiseTexture();
 
     // 多光源阴影管理
-    void CreateShadowBufferForLight(Light* light);
-    void RemoveShadowBufferForLight(Light* light);
-    unsigned int GetShadowBufferIndexForLight(Light* light);
     void ClearLightShadowBuffers(); // 清理所有光源阴影缓冲区
+    // 剔除出与光源视锥相交的投射体，返回只覆盖这些投射体的签名（网格身份与世界矩阵），签名变化时重绘该光源的阴影
+    size_t CullShadowCasters(const glm::mat4 &lightSpaceMatrix);
+    // 绘制上一次 CullShadowCasters 剔除后可见的投射体
+    void RenderShadowCasters();
+
+    // 收集所有网格的世界包围盒并对相机视锥做剔除，每帧在所有渲染阶段之前执行一次
+    void UpdateVisibility();
+    // 按相机可见网格在屏幕上的投影尺寸向材质贴图报告所需分辨率，驱动 mip 流式加载
+    void RequestTextureResolutions();
+    // 收集相机可见网格的绘制包，按材质类型选择着色器
+    // globalFeatures 与材质的贴图特性合并后选择变体
+    void BuildRenderQueue(ShaderVariants &blinnPhongShaders, ShaderVariants &pbrShaders, uint32_t globalFeatures);
+    // 由全局开关决定的着色器变体特性（阴影、IBL、SSAO），与 FrameData 中的开关保持一致
+    uint32_t GetGlobalShaderFeatures() const;
+    // 把当前环境槽位的 IBL 贴图绑定到单元 20..22（须在 SHADER_FEATURE_IBL 可用时调用）
+    void BindIBLTextures();
+
+    // 按时间预算上传已完成导入的异步模型
+    void ProcessModelUploads();
+    // 解析已完成编译的着色器，全部完成时返回 true
+    bool UpdateShaderCompilation();
 
     void RenderSkybox();
     void RenderShadows();
@@ -313,7 +477,8 @@ class Renderer
 
     // 帧缓冲
     std::unique_ptr<Framebuffer> gBuffer;
-    std::unique_ptr<Framebuffer> shadowBuffer;  // 保留兼容性
+    std::unique_ptr<Framebuffer> gBufferDebugBuffer; // 调试视口首次请求时创建
+    bool gBufferDebugRequested = false;
     std::unique_ptr<Framebuffer> hdrBuffer;
     std::unique_ptr<Framebuffer> bloomPrefilterBuffer;
     std::unique_ptr<Framebuffer> bloomBlurBuffers[2];
@@ -322,18 +487,54 @@ class Renderer
     std::unique_ptr<Framebuffer> fxaaBuffer;
     std::unique_ptr<Framebuffer> viewportBuffer; // 用于显示渲染结果
 
-    // 多光源阴影缓冲区管理
-    std::vector<std::unique_ptr<Framebuffer>> lightShadowBuffers;
-    std::unordered_map<Light*, unsigned int> lightToShadowMap;
+    // 多光源阴影图集（常驻，点光源和聚光灯每个光源一个图块）
+    std::unique_ptr<ShadowAtlas> shadowAtlas;
+    int shadowTilesUpdated = 0;
+    // 方向光的级联阴影
+    std::unique_ptr<CascadedShadowMap> cascadedShadowMap;
+    int shadowCascadesUpdated = 0;
 
     std::unique_ptr<Framebuffer> hdrBufferMS;
 
+    // 每帧共享数据
+    std::unique_ptr<UniformBuffer> frameDataBuffer;
+    std::unique_ptr<LightBuffer> lightBuffer; // GPU 光源表
+    std::unique_ptr<LightClusters> lightClusters; // 前向渲染的簇光源列表
+
+    RenderQueue renderQueue;
+
+    float modelUploadBudgetMs = 4.0f;
+
+    // 视锥剔除：cullItems 与 culler 中的包围盒一一对应
+    struct CullItem
+    {
+        Mesh *mesh;
+        Material *material; // 模型实例可能覆盖网格的材质
+        const AABB *bounds; // 世界空间包围盒
+        const glm::mat4 *world;
+        const glm::mat3 *normal;
+        size_t casterKey;   // 网格身份与几何版本，参与阴影投射体签名
+    };
+    std::vector<CullItem> cullItems;
+    FrustumCuller culler;
+    AABB sceneBounds; // 所有投射体的包围盒，级联阴影据此确定朝光源一侧的深度范围
+    Frustum cameraFrustum;
+    std::vector<uint8_t> cameraVisibility;
+    std::vector<uint8_t> shadowVisibility;
+    CullingStats cullingStats;
+    GpuTimer gpuTimer;
+
+    float frameTime = 0.0f;
+    float frameDeltaTime = 0.0f;
+
     // 着色器
-    std::unique_ptr<Shader> forwardShader;
-    std::unique_ptr<Shader> pbrShader;
-    std::unique_ptr<Shader> deferredGeometryShader;
-    std::unique_ptr<Shader> deferredLightingShader;
-    std::unique_ptr<Shader> pbrDeferredGeometryShader;
+    // 场景着色器按材质贴图和全局开关编译为变体，见 GetGlobalShaderFeatures
+    std::unique_ptr<ShaderVariants> forwardShaders;
+    std::unique_ptr<ShaderVariants> pbrShaders;
+    std::unique_ptr<ShaderVariants> deferredGeometryShaders;
+    std::unique_ptr<ShaderVariants> deferredLightingShaders;
+    std::unique_ptr<ShaderVariants> pbrDeferredGeometryShaders;
+    std::unique_ptr<ShaderVariants> tiledLightingShaders; // 计算着色器，驱动不支持时为空
     std::unique_ptr<Shader> pbrDeferredLightingShader;
     std::unique_ptr<Shader> shadowDepthShader;
     std::unique_ptr<Shader> skyboxShader;
@@ -346,6 +547,7 @@ class Renderer
     std::unique_ptr<Shader> postProcessShader;
     std::unique_ptr<Shader> postShaderMS; // 采样 sampler2DMS
     std::unique_ptr<Shader> fxaaShader;
+    std::unique_ptr<Shader> gBufferDebugShader;
     
     // IBL着色器
     std::unique_ptr<Shader> equirectangularToCubemapShader;
@@ -355,6 +557,11 @@ class Renderer
 
     std::unordered_map<std::string, std::shared_ptr<Shader>> shaders;
 
+    // 仍在后台编译的着色器（初始化时提交，每帧非阻塞地检查）
+    std::vector<Shader *> pendingShaders;
+    std::chrono::steady_clock::time_point shaderLoadStart;
+    double shaderLoadMs = 0.0;
+
     // 场景数据
     std::vector<std::shared_ptr<Model>> models;
     std::vector<std::shared_ptr<PointLight>> pointLights;
@@ -394,6 +601,8 @@ class Renderer
     bool iblEnabled = false;
     bool showLights = false;
     bool fxaaEnabled = false;
+    bool clusteredLighting = true;
+    bool shaderPermutations = true;
     
     // 背景类型
     BackgroundType backgroundType = SKYBOX;
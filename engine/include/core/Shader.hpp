@@ -4,15 +4,77 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+// 预解析的 uniform 句柄，热路径上可直接设置而无需任何字符串操作
+struct UniformHandle
+{
+    GLint location = -1;
+
+    bool IsValid() const
+    {
+        return location >= 0;
+    }
+};
 
+// 着色器变体特性：编译时转换为 #define 注入到 #version 之后，代替片段着色器中按 uniform 的运行时分支
+enum ShaderFeature : uint32_t
+{
+    SHADER_FEATURE_ALBEDO_MAP = 1u << 0,    // HAS_ALBEDO_MAP（Blinn-Phong 为漫反射贴图）
+    SHADER_FEATURE_SPECULAR_MAP = 1u << 1,  // HAS_SPECULAR_MAP
+    SHADER_FEATURE_NORMAL_MAP = 1u << 2,    // HAS_NORMAL_MAP
+    SHADER_FEATURE_METALLIC_MAP = 1u << 3,  // HAS_METALLIC_MAP
+    SHADER_FEATURE_ROUGHNESS_MAP = 1u << 4, // HAS_ROUGHNESS_MAP
+    SHADER_FEATURE_AO_MAP = 1u << 5,        // HAS_AO_MAP
+    SHADER_FEATURE_SHADOWS = 1u << 6,       // USE_SHADOWS
+    SHADER_FEATURE_IBL = 1u << 7,           // USE_IBL
+    SHADER_FEATURE_SSAO = 1u << 8,          // USE_SSAO
+    SHADER_FEATURE_CLUSTERED_LIGHTS = 1u << 9, // USE_CLUSTERED_LIGHTS（只遍历片段所在簇的光源）
+};
+constexpr int SHADER_FEATURE_COUNT = 10;
+// 由材质贴图决定的特性，其余特性由渲染器的全局开关决定
+constexpr uint32_t SHADER_FEATURE_MATERIAL_MAPS = SHADER_FEATURE_ALBEDO_MAP | SHADER_FEATURE_SPECULAR_MAP |
+                                                  SHADER_FEATURE_NORMAL_MAP | SHADER_FEATURE_METALLIC_MAP |
+                                                  SHADER_FEATURE_ROUGHNESS_MAP | SHADER_FEATURE_AO_MAP;
+
+// 着色器程序分为提交和解析两个阶段：构造时只发出编译和链接命令，
+// 第一次使用（Use、设置 uniform、获取句柄）时才检查结果并反射 uniform。
+// 驱动支持 GL_KHR_parallel_shader_compile 时，编译在驱动线程中并行进行，
+// 可用 IsReady 非阻塞地查询是否完成
 class Shader
 {
   public:
-    Shader(const std::string &vertexPath, const std::string &fragmentPath);
+    // features 为 ShaderFeature 位掩码，对应的宏注入两个阶段的源码
+    Shader(const std::string &vertexPath, const std::string &fragmentPath, uint32_t features = 0);
+    // 计算着色器程序
+    explicit Shader(const std::string &computePath, uint32_t features = 0);
     ~Shader();
 
+    // 特性位掩码对应的 #define 列表（每行一个）
+    static std::string GetFeatureDefines(uint32_t features);
+    uint32_t GetFeatures() const
+    {
+        return features;
+    }
+
+    // 在 GL 上下文创建后调用一次：检测并行编译扩展并让驱动使用全部编译线程
+    // loadProc 为 GL 函数加载器（如 glfwGetProcAddress），返回扩展是否可用
+    static bool InitializeParallelCompile(void *(*loadProc)(const char *name));
+    static bool IsParallelCompileSupported()
+    {
+        return parallelCompileSupported;
+    }
+
+    // 编译和链接是否已完成（不阻塞）；没有并行编译扩展时始终返回 true
+    bool IsReady() const;
+    // 等待编译完成，检查错误、写入程序二进制缓存并反射 uniform；只执行一次
+    void Resolve() const;
+
     void Use() const;
 
     // uniform工具函数
@@ -26,13 +88,62 @@ class Shader
     void SetMat3(const std::string &name, const glm::mat3 &mat) const;
     void SetMat4(const std::string &name, const glm::mat4 &mat) const;
 
+    // 句柄版本：先用 GetUniformHandle 解析一次，之后每帧直接使用
+    UniformHandle GetUniformHandle(const std::string &name) const;
+    bool HasUniform(const std::string &name) const
+    {
+        return GetUniformLocation(name) >= 0;
+    }
+
+    void SetBool(UniformHandle handle, bool value) const;
+    void SetInt(UniformHandle handle, int value) const;
+    void SetFloat(UniformHandle handle, float value) const;
+    void SetVec2(UniformHandle handle, const glm::vec2 &value) const;
+    void SetVec3(UniformHandle handle, const glm::vec3 &value) const;
+    void SetVec4(UniformHandle handle, const glm::vec4 &value) const;
+    void SetMat2(UniformHandle handle, const glm::mat2 &mat) const;
+    void SetMat3(UniformHandle handle, const glm::mat3 &mat) const;
+    void SetMat4(UniformHandle handle, const glm::mat4 &mat) const;
+
     unsigned int GetID() const
     {
         return ID;
     }
+    // 程序代号：每次创建并链接程序时从全局计数器取新值，进程内不会重复。
+    // GL 会复用已删除的程序名，Shader 对象的地址也可能被复用，按程序缓存的数据须同时比较代号
+    uint64_t GetGeneration() const
+    {
+        return generation;
+    }
 
   private:
-    void CheckCompileErrors(unsigned int shader, std::string type);
+    // 创建程序并提交各阶段的编译和链接（缓存命中时直接恢复程序二进制）
+    void Submit(const std::vector<std::pair<GLenum, std::string>> &sources);
+
+    // 返回编译或链接是否成功
+    bool CheckCompileErrors(unsigned int shader, std::string type) const;
+
+    // 链接后通过 glGetActiveUniform 反射所有活动 uniform 的位置
+    void ReflectUniforms() const;
+    GLint GetUniformLocation(const std::string &name) const;
 
     unsigned int ID;
+
+    // 解析前保留各阶段的着色器对象用于读取编译日志；解析后删除
+    struct Stage
+    {
+        GLenum type;
+        unsigned int shader;
+    };
+    mutable std::vector<Stage> stages;
+    mutable bool resolved = false;
+    uint64_t cacheKey = 0;
+    uint32_t features = 0;
+    uint64_t generation = 0;
+
+    static bool parallelCompileSupported;
+    static std::atomic<uint64_t> nextGeneration;
+
+    // uniform 名称 -> 位置缓存（未找到的名称缓存为 -1，避免重复查询）
+    mutable std::unordered_map<std::string, GLint> uniformLocations;
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include <glad/glad.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// 着色器程序二进制缓存：以各阶段展开后的源码（含 #include 和宏定义）与驱动的
+// 厂商 / 渲染器 / 版本字符串为键，保存 glGetProgramBinary 得到的程序二进制。
+// 命中时用 glProgramBinary 直接恢复程序，跳过编译和链接；驱动更新、源码变化
+// 或驱动拒绝二进制时回退到源码编译并重新写入缓存。
+// 文件格式（小端）：文件头 | 程序二进制
+class ShaderCache
+{
+  public:
+    static ShaderCache &GetInstance();
+
+    // 在 GL 线程调用一次：创建缓存目录，查询驱动信息和二进制格式支持
+    void Initialize(const std::string &directory);
+
+    // 在已有的键上混入一个阶段的源码，stage 为 GL_VERTEX_SHADER 等
+    uint64_t AddSource(uint64_t key, unsigned int stage, const std::string &source) const;
+    // 初始键（包含驱动信息和缓存版本）
+    uint64_t GetBaseKey() const
+    {
+        return driverKey;
+    }
+
+    // 删除目录中所有缓存的程序二进制（测量冷启动用），须在 Initialize 之后调用
+    void Clear();
+
+    // 以下函数须在 GL 线程调用
+    // 命中并且驱动接受二进制时返回 true，program 处于链接成功状态
+    bool Load(uint64_t key, unsigned int program);
+    // program 须在链接前设置 GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    bool Store(uint64_t key, unsigned int program);
+
+    bool IsEnabled() const
+    {
+        return enabled;
+    }
+    void SetEnabled(bool value)
+    {
+        enabled = value && initialized;
+    }
+
+    // 启动统计，用于比较冷启动和热启动
+    struct Stats
+    {
+        int hits = 0;
+        int misses = 0;
+        int rejected = 0; // 文件存在但驱动拒绝（如驱动更新后格式不兼容）
+    };
+    const Stats &GetStats() const
+    {
+        return stats;
+    }
+
+  private:
+    ShaderCache() = default;
+    ~ShaderCache() = default;
+    ShaderCache(const ShaderCache &) = delete;
+    ShaderCache &operator=(const ShaderCache &) = delete;
+
+    std::string GetFilePath(uint64_t key) const;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;
+        uint32_t binaryFormat;
+        uint32_t size;
+    };
+
+    std::string directory;
+    uint64_t driverKey = 0;
+    bool initialized = false;
+    std::atomic<bool> enabled{false};
+    Stats stats;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include "Shader.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// 同一对源文件按特性位掩码编译出的一组着色器变体。
+// 变体在第一次请求时编译（提交后由 Shader 在第一次使用时解析），之后按位掩码缓存；
+// 不支持的特性位在查找前被屏蔽，避免为着色器不关心的特性产生重复变体
+class ShaderVariants
+{
+  public:
+    ShaderVariants(const std::string &vertexPath, const std::string &fragmentPath, uint32_t supportedFeatures);
+    // 计算着色器的变体
+    ShaderVariants(const std::string &computePath, uint32_t supportedFeatures);
+
+    // 返回的引用在本对象销毁前保持有效
+    const std::unique_ptr<Shader> &Get(uint32_t features);
+
+    uint32_t GetSupportedFeatures() const
+    {
+        return supportedFeatures;
+    }
+    size_t GetVariantCount() const
+    {
+        return variants.size();
+    }
+
+  private:
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string computePath;
+    uint32_t supportedFeatures;
+    std::unordered_map<uint32_t, std::unique_ptr<Shader>> variants;
+};
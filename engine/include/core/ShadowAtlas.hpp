@@ -0,0 +1,77 @@
+#pragma once
+#include "Framebuffer.hpp"
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Light;
+
+// 阴影图集：一张常驻的深度纹理，按固定大小的单元格切分，
+// 每个投射阴影的光源占用其中一块正方形图块，只在图集扩容时重新分配显存
+class ShadowAtlas
+{
+  public:
+    struct Tile
+    {
+        int x = 0;     // 图块起始单元格（列）
+        int y = 0;     // 图块起始单元格（行）
+        int cells = 0; // 图块边长（单元格数）
+
+        // 上次渲染时的状态，用于判断图块是否需要重绘
+        glm::mat4 lightSpaceMatrix = glm::mat4(0.0f);
+        size_t casterSignature = 0;
+        bool dirty = true;
+    };
+
+    // cellSize: 单元格分辨率；initialCells/maxCells: 图集每边的初始/最大单元格数
+    ShadowAtlas(int cellSize = 1024, int initialCells = 2, int maxCells = 8);
+
+    // 获取光源对应的图块，不存在时分配；图集已满且无法扩容时返回 nullptr
+    Tile *Acquire(const Light *light, int cells);
+    void Release(const Light *light);
+    void ReleaseAll();
+    // 释放不在 alive 集合中的光源占用的图块
+    void ReleaseUnused(const std::unordered_set<const Light *> &alive);
+
+    // 将所有图块标记为需要重绘
+    void Invalidate();
+
+    // 图块在图集中的归一化矩形：xy 为偏移，zw 为缩放
+    glm::vec4 GetTileRect(const Tile &tile) const;
+
+    // 绑定图集并把视口/裁剪区域限制在图块内，清除图块深度
+    void BeginTile(const Tile &tile) const;
+    void EndTile() const;
+
+    unsigned int GetDepthTexture() const
+    {
+        return framebuffer ? framebuffer->GetDepthTexture() : 0;
+    }
+    int GetSize() const
+    {
+        return cellSize * cellsPerSide;
+    }
+    int GetCellSize() const
+    {
+        return cellSize;
+    }
+    size_t GetTileCount() const
+    {
+        return tiles.size();
+    }
+
+  private:
+    bool FindFreeBlock(int cells, int &outX, int &outY) const;
+    void MarkCells(const Tile &tile, bool used);
+    bool Grow();
+
+    int cellSize;
+    int cellsPerSide;
+    int maxCellsPerSide;
+
+    std::unique_ptr<Framebuffer> framebuffer;
+    std::vector<bool> occupied; // cellsPerSide * cellsPerSide
+    std::unordered_map<const Light *, Tile> tiles;
+};
@@ -1,10 +1,41 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <string>
 #include <glad/glad.h>
+#include <memory>
 #include <vector>
 
+// 解码后的 CPU 端图像，不包含 GL 对象，可在工作线程中生成
+struct TextureImage
+{
+    // 一级 mip 在 pixels 中的位置
+    struct Level
+    {
+        int width;
+        int height;
+        size_t offset;
+        size_t size;
+    };
+
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int components = 0;
+    bool srgb = false;                // 颜色贴图，按 sRGB 存储并在线性空间下采样
+    bool normalMap = false;           // 切线空间法线贴图，压缩时只保留 xy（BC5）
+    unsigned int compressedFormat = 0; // GL 块压缩格式，0 表示 pixels 为未压缩的 8 位数据
+    uint64_t contentHash = 0;          // 文件内容 + 解码选项的哈希，相同的图像（无论路径）哈希相同；0 表示未知
+    std::vector<unsigned char> pixels; // 所有 mip 级别连续存放，第 0 级在最前
+    std::vector<Level> levels;         // 为空表示只有第 0 级
+
+    bool IsValid() const
+    {
+        return !pixels.empty();
+    }
+};
+
 class Texture
 {
   public:
@@ -14,6 +45,73 @@ class Texture
         LoadFromFile(filePath); 
     }
     bool LoadFromFile(const std::string &filepath);
+    // 只解码图像文件并在 CPU 上生成完整 mip 链，不调用 GL，可在工作线程中使用。
+    // image.srgb / image.normalMap 需在调用前设置，决定下采样的颜色空间和压缩格式。
+    // 启用了纹理缓存时优先读取按内容哈希缓存的块压缩结果，未命中则压缩后写入缓存
+    static bool DecodeFile(const std::string &filepath, bool flipY, TextureImage &image);
+    // 盒式滤波生成 mip 链（sRGB 图像先转到线性空间再平均）
+    static void BuildMipChain(TextureImage &image);
+    // 上传解码结果，必须在 GL 线程调用
+    bool Upload(const TextureImage &image);
+    // 按 image 的尺寸和通道数从内存上传 pixels（含全部 mip 级别）。
+    // firstLevel > 0 时只上传该级及更粗的级别（mip 流式加载），pixels 仍指向完整 mip 链的起始位置
+    bool UploadPixels(const TextureImage &image, const void *pixels, int firstLevel = 0);
+    // 从当前绑定的 GL_PIXEL_UNPACK_BUFFER 上传：pboOffset 为第 firstLevel 级数据在缓冲中的偏移，
+    // 更粗的级别按 image.levels 的布局紧随其后
+    bool UploadPixels(const TextureImage &image, size_t pboOffset, int firstLevel = 0);
+    // 取得相同路径和加载选项（翻转、颜色空间、法线贴图）的纹理，经由 TextureManager 共享而不是重新加载
+    static std::shared_ptr<Texture> LoadCopy(const Texture &source);
+
+    // 与 owner 共用同一个 GL 纹理（内容完全相同的图像去重），自身不占显存；
+    // 之后再上传数据时会先分离出独立的纹理对象，不会改写 owner
+    void ShareStorage(const std::shared_ptr<Texture> &owner, const std::string &path);
+    bool IsSharedStorage() const
+    {
+        return storageOwner != nullptr;
+    }
+
+    // mip 流式加载（由 TextureManager 驱动）：保留 CPU 端完整 mip 链，GL 纹理只包含
+    // [residentLevel, 最粗级] 并用 GL_TEXTURE_BASE_LEVEL 限定采样范围，按需流入更细的级别或释放
+    void SetStreamSource(std::shared_ptr<const TextureImage> source)
+    {
+        streamSource = std::move(source);
+    }
+    const TextureImage *GetStreamSource() const
+    {
+        return streamSource.get();
+    }
+    bool IsStreaming() const
+    {
+        return streamSource != nullptr;
+    }
+    // 当前驻留的最细级别（0 为原始分辨率）；tailLevel 为初始上传的级别，流出时不低于它
+    int GetResidentLevel() const
+    {
+        return residentLevel;
+    }
+    int GetTailLevel() const
+    {
+        return tailLevel;
+    }
+    // 上传 residentLevel - 1 级，levelPixels 指向该级数据（绑定 PBO 时为缓冲内偏移）
+    bool StreamInLevel(const void *levelPixels);
+    // 释放当前最细的一级
+    bool DropFinestLevel();
+    // 记录本帧该纹理在屏幕上覆盖的最大像素尺寸，共享存储时记到拥有者上
+    void RequestScreenSize(float pixels);
+    // 读取并清零本帧的请求
+    float TakeRequestedScreenSize()
+    {
+        float size = requestedScreenSize;
+        requestedScreenSize = 0.0f;
+        return size;
+    }
+
+    // 材质贴图共用的采样器对象：三线性过滤 + 硬件支持的最大各向异性（不超过 16x）
+    static unsigned int GetMaterialSampler();
+    // 调整材质采样器的过滤方式（基准测试对比带宽用）：useMipmaps 为 false 时只采样第 0 级，
+    // maxAnisotropy 按硬件上限截断，1 为关闭各向异性
+    static void SetMaterialSamplerFiltering(bool useMipmaps, float maxAnisotropy);
     void Generate(unsigned int width, unsigned int height, unsigned char *data);
     void Bind(unsigned int unit = 0) const;
 
@@ -30,8 +128,15 @@ class Texture
     {
         return Path;
     }
+    // 纹理在显存中占用的字节数（含全部 mip 级别），共享存储的纹理为 0
+    size_t GetMemorySize() const
+    {
+        return memorySize;
+    }
     std::string type;
     bool flipY = true;
+    bool srgb = false; // 颜色贴图（漫反射、反照率）使用 sRGB 内部格式，采样时由硬件转换到线性空间
+    bool normalMap = false; // 法线贴图，压缩为双通道 BC5，着色器重建 z 分量
     
     // 纹理ID管理
     static unsigned int GetNextTextureID();
@@ -40,6 +145,18 @@ class Texture
     unsigned int ID;
     int Width, Height, nrComponents;
     std::string Path;
+    size_t memorySize = 0;
+    std::shared_ptr<Texture> storageOwner; // 共享存储时实际拥有 GL 纹理的对象
+
+    std::shared_ptr<const TextureImage> streamSource;
+    int residentLevel = 0;
+    int tailLevel = 0;
+    float requestedScreenSize = 0.0f;
+
+    // 两个 UploadPixels 的实现：pixels 非空时从内存读取，否则从绑定的 PBO 的 pboOffset 处读取
+    bool UploadLevels(const TextureImage &image, const unsigned char *pixels, size_t pboOffset, int firstLevel);
+    // 共享存储时换回独立的 GL 纹理，上传新数据前调用
+    void DetachStorage();
 
     // 纹理参数
     unsigned int Internal_Format;
@@ -0,0 +1,71 @@
+#pragma once
+#include "Texture.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 块压缩纹理的磁盘缓存：以源文件内容哈希 + 加载选项为键，保存压缩后的完整 mip 链。
+// 第二次加载同一内容的图像时跳过解码、下采样和压缩，直接读取压缩数据上传。
+// 文件格式（小端）：文件头 | 每级 mip 的尺寸和偏移 | 连续存放的压缩数据
+class TextureCache
+{
+  public:
+    static TextureCache &GetInstance();
+
+    // 在 GL 线程调用一次：创建缓存目录并查询 S3TC 支持，之后才启用压缩
+    void Initialize(const std::string &directory);
+
+    // 根据文件内容和会影响解码结果的选项计算缓存键，同时作为 TextureImage::contentHash 用于去重
+    static uint64_t MakeKey(const std::vector<unsigned char> &fileData, bool flipY, bool srgb, bool normalMap);
+
+    // 以下函数可在工作线程中调用
+    bool Load(uint64_t key, TextureImage &image) const;
+    bool Store(uint64_t key, const TextureImage &image) const;
+
+    bool IsEnabled() const
+    {
+        return enabled;
+    }
+    void SetEnabled(bool value)
+    {
+        enabled = value && initialized;
+    }
+    bool IsS3TCSupported() const
+    {
+        return s3tcSupported;
+    }
+
+  private:
+    TextureCache() = default;
+    ~TextureCache() = default;
+    TextureCache(const TextureCache &) = delete;
+    TextureCache &operator=(const TextureCache &) = delete;
+
+    std::string GetFilePath(uint64_t key) const;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t key;
+        uint32_t format;
+        int32_t width;
+        int32_t height;
+        int32_t components;
+        uint32_t flags; // bit0 sRGB，bit1 法线贴图
+        uint32_t levelCount;
+    };
+    struct FileLevel
+    {
+        int32_t width;
+        int32_t height;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    std::string directory;
+    bool initialized = false;
+    std::atomic<bool> enabled{false};
+    bool s3tcSupported = false;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "Texture.hpp"
+#include <cstddef>
+
+// 块压缩格式（S3TC 为扩展，核心头文件可能没有定义）
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+// CPU 纹理块压缩：
+//   BC1（DXT1）  不透明颜色贴图，8 字节 / 4x4 块
+//   BC3（DXT5）  带透明度的颜色贴图，16 字节 / 4x4 块
+//   BC4（RGTC1） 单通道贴图（金属度、粗糙度、AO 等），8 字节 / 4x4 块
+//   BC5（RGTC2） 法线贴图的 xy，16 字节 / 4x4 块
+// 端点取包围盒对角线（按协方差符号选择方向）并向内收缩，索引取调色板中最近的颜色。
+// 只做 CPU 计算，可在工作线程中调用，块行通过作业系统并行
+class TextureCompressor
+{
+  public:
+    // 根据通道数、透明度和用途选择格式；返回 0 表示不压缩（如双通道灰度 + alpha）
+    // s3tcSupported 为 false 时颜色贴图保持未压缩，BC4/BC5 为核心格式不受影响
+    static unsigned int ChooseFormat(const TextureImage &image, bool s3tcSupported);
+
+    // 把 image 的全部 mip 级别压缩为 format，替换 pixels 和 levels
+    static bool Compress(TextureImage &image, unsigned int format);
+
+    // 每个 4x4 块的字节数，不支持的格式返回 0
+    static size_t GetBlockBytes(unsigned int format);
+    static size_t GetLevelSize(unsigned int format, int width, int height);
+};
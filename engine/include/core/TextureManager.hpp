@@ -1,20 +1,108 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <vector>
+#include "core/PixelUploadRing.hpp"
 #include "core/Texture.hpp"
 
+// 纹理驻留管理：引擎中所有从文件加载的纹理（场景材质、模型贴图、编辑器资源）都经由这里缓存和共享。
+// 缓存按路径和加载选项索引；上传前再按内容哈希查找，路径不同但内容相同的图像共用同一个 GL 纹理。
+// 纹理以 shared_ptr 计数引用，只被缓存持有的纹理视为未引用；
+// 驻留显存超过预算时，按最近使用时间（LRU）从最久未使用的未引用纹理开始释放。
+// 较大的纹理按 mip 流式加载：初始只上传 mip 尾部，之后根据渲染器报告的屏幕尺寸逐级流入更细的级别，
+// 物体变远、不可见或显存超出预算时再逐级释放（GL_TEXTURE_BASE_LEVEL 限定采样范围）
 class TextureManager
 {
 public:
+    // 驻留统计
+    struct Stats
+    {
+        size_t residentBytes = 0;   // 缓存中全部纹理的显存占用
+        size_t referencedBytes = 0; // 其中仍被引用的部分
+        size_t residentCount = 0;
+        size_t referencedCount = 0;
+        uint64_t hits = 0;          // 请求命中缓存次数
+        uint64_t misses = 0;        // 需要解码加载的次数
+        uint64_t evictions = 0;     // 被淘汰的纹理数
+        uint64_t evictedBytes = 0;
+        uint64_t dedupHits = 0;     // 路径不同、内容相同而共用已有纹理的次数
+        uint64_t dedupBytes = 0;    // 去重节省的显存
+        size_t streamingCount = 0;  // 按 mip 流式加载的纹理数
+        uint64_t streamedLevels = 0; // 累计流入的 mip 级别数
+        uint64_t droppedLevels = 0;  // 累计释放的 mip 级别数
+    };
+
     static TextureManager& GetInstance();
     
     // 获取或加载纹理
     std::shared_ptr<Texture> GetTexture(const std::string& path);
     
-    // 获取或加载纹理（带flipY参数）
-    std::shared_ptr<Texture> GetTexture(const std::string& path, bool flipY);
+    // 获取或加载纹理（带flipY参数）；srgb 用于颜色贴图，按 sRGB 格式生成 mip 并上传；
+    // normalMap 用于切线空间法线贴图，启用纹理缓存时压缩为 BC5
+    std::shared_ptr<Texture> GetTexture(const std::string& path, bool flipY, bool srgb = false, bool normalMap = false);
+
+    // 异步获取纹理：立即返回（1x1 白色占位），解码在后台 I/O 线程进行，
+    // 解码完成后由 ProcessUploads 在主线程按字节预算上传到同一个 Texture 对象
+    std::shared_ptr<Texture> GetTextureAsync(const std::string& path, bool flipY = true, bool srgb = false,
+                                             bool normalMap = false);
+
+    // 上传解码好的图像：放得进当前像素缓冲段时经由持久映射 PBO，否则直接上传（必须在 GL 线程调用）
+    // firstLevel > 0 时只上传该级及更粗的级别
+    bool UploadImage(Texture& texture, const TextureImage& image, int firstLevel = 0);
+
+    // 已在工作线程解码好的图像（如模型贴图）：缓存中已有相同路径和选项的纹理时直接返回，否则上传并加入缓存。
+    // 颜色空间和法线贴图选项取自 image.srgb / image.normalMap；按 mip 流式加载时像素数据被移入纹理
+    std::shared_ptr<Texture> AddTexture(const std::string& path, bool flipY, TextureImage& image);
+    // 只查找缓存，不加载，不计入命中统计
+    std::shared_ptr<Texture> FindTexture(const std::string& path, bool flipY, bool srgb = false,
+                                         bool normalMap = false) const;
+
+    // 每帧在主线程调用一次：上传已解码的异步纹理，结束本帧的 PBO 段，并在超出显存预算时淘汰未引用的纹理
+    void ProcessUploads();
+
+    // 纹理显存预算（字节），只约束未引用的纹理，仍在使用的纹理不会被释放
+    void SetMemoryBudget(size_t bytes)
+    {
+        memoryBudgetBytes = bytes;
+    }
+    size_t GetMemoryBudget() const
+    {
+        return memoryBudgetBytes;
+    }
+    // mip 流式加载开关，只影响之后加载的纹理
+    void SetStreamingEnabled(bool enabled)
+    {
+        streamingEnabled = enabled;
+    }
+    bool IsStreamingEnabled() const
+    {
+        return streamingEnabled;
+    }
+    // 立即释放所有未引用的纹理，返回释放的字节数
+    size_t EvictUnused();
+    const Stats& GetStats() const
+    {
+        return stats;
+    }
+
+    // 每帧异步纹理上传的字节预算（至少上传一张，避免大纹理永远等待）
+    void SetUploadBudget(size_t bytes)
+    {
+        uploadBudgetBytes = bytes;
+    }
+    size_t GetPendingCount() const
+    {
+        return pendingUploads.size();
+    }
+    // 上一帧上传的字节数
+    size_t GetLastFrameUploadBytes() const
+    {
+        return lastFrameUploadBytes;
+    }
     
     // 清理所有纹理缓存
     void ClearCache();
@@ -27,6 +115,71 @@ private:
     ~TextureManager() = default;
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
+
+    static std::string MakeCacheKey(const std::string& path, bool flipY, bool srgb, bool normalMap);
+
+    // 内容相同的纹理已驻留时共享其存储，否则上传并登记内容哈希；流式纹理只上传 mip 尾部并接管 image 的像素
+    bool UploadOrShare(const std::shared_ptr<Texture>& texture, TextureImage& image);
+
+    // 流式加载的初始级别，0 表示整张上传（小纹理或没有 mip 链）
+    static int ChooseTailLevel(const TextureImage& image);
+    // 屏幕尺寸对应的目标级别（不超过 mip 尾部）
+    static int GetDesiredLevel(const Texture& texture, float screenSize);
+    // 更新目标级别，释放多余的级别并在预算内流入更细的级别
+    void UpdateStreaming();
+
+    // 刷新驻留统计，仍被引用的纹理记为本帧使用
+    void UpdateResidency();
+    // 按 LRU 淘汰未引用的纹理，直到驻留字节数不超过 targetBytes；返回释放的字节数
+    size_t Evict(size_t targetBytes);
+
+    struct CacheEntry
+    {
+        std::shared_ptr<Texture> texture;
+        uint64_t lastUsedFrame = 0; // 最后一次被请求或被引用的帧
+    };
+
+    // 解码作业只写 DecodeTask，纹理对象只在主线程访问
+    struct DecodeTask
+    {
+        std::string path;
+        bool flipY = true;
+        TextureImage image; // image.srgb / image.normalMap 在调度前设置
+        std::atomic<bool> ready{false};
+    };
+    struct PendingUpload
+    {
+        std::string cacheKey;
+        std::shared_ptr<Texture> texture;
+        std::shared_ptr<DecodeTask> task;
+    };
     
-    std::unordered_map<std::string, std::shared_ptr<Texture>> textureCache;
+    std::unordered_map<std::string, CacheEntry> textureCache;
+    // 内容哈希 -> 拥有 GL 存储的纹理；弱引用，共享者仍持有时即使缓存条目被淘汰也能继续复用
+    std::unordered_map<uint64_t, std::weak_ptr<Texture>> contentIndex;
+
+    // 流式纹理：长边大于 STREAMING_MIN_SIZE 才流式加载，初始上传长边不大于 STREAMING_TAIL_SIZE 的级别
+    static constexpr int STREAMING_MIN_SIZE = 256;
+    static constexpr int STREAMING_TAIL_SIZE = 64;
+    // 连续这么多帧没有请求时退回 mip 尾部
+    static constexpr uint64_t STREAMING_IDLE_FRAMES = 120;
+    struct StreamingEntry
+    {
+        std::weak_ptr<Texture> texture;
+        float screenSize = 0.0f;
+        uint64_t lastRequestFrame = 0;
+        int desiredLevel = 0;
+    };
+    std::vector<StreamingEntry> streamingTextures;
+    bool streamingEnabled = true;
+
+    std::vector<PendingUpload> pendingUploads;
+    std::unique_ptr<PixelUploadRing> uploadRing; // 首次上传时创建（需要 GL 上下文）
+    size_t uploadBudgetBytes = 16 * 1024 * 1024;
+    size_t frameUploadBytes = 0;
+    size_t lastFrameUploadBytes = 0;
+
+    size_t memoryBudgetBytes = 512 * 1024 * 1024;
+    uint64_t frameIndex = 0;
+    Stats stats;
 };
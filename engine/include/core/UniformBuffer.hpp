@@ -0,0 +1,41 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstddef>
+
+// 全局 uniform block 绑定点，需与着色器中的 layout(binding = N) 保持一致
+enum UniformBindingPoint
+{
+    FRAME_DATA_BINDING = 0,
+    SHADOW_CASCADES_BINDING = 1 // CascadedShadowMap 的级联矩阵与分割距离
+};
+
+// Uniform 缓冲对象（UBO）：创建后绑定到固定绑定点，所有使用该 block 的着色器共享
+class UniformBuffer
+{
+  public:
+    UniformBuffer(size_t size, GLuint binding);
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer &) = delete;
+    UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+    // 更新缓冲内容（offset/size 以字节为单位）
+    void Update(const void *data, size_t size, size_t offset = 0) const;
+
+    // 重新绑定到绑定点（其他代码改动了该绑定点时使用）
+    void Bind() const;
+
+    GLuint GetID() const
+    {
+        return ID;
+    }
+    size_t GetSize() const
+    {
+        return size;
+    }
+
+  private:
+    GLuint ID = 0;
+    size_t size;
+    GLuint binding;
+};
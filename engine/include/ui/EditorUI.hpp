@@ -105,10 +105,12 @@ private:
                          const std::string &idSuffix = "");
     void ApplyMaterialToObject(); // 应用材质到对象的具体实现
     void ApplyAssetToMesh(std::shared_ptr<Mesh> mesh); // 应用资源到mesh
+    void ApplyAssetToMaterial(const std::shared_ptr<Material> &material); // 应用资源到材质
     void ApplyAssetToPrimitive(Geometry::Primitive& primitive); // 应用资源到几何体
     void ShowAntiAliasingSettings();
     void ShowPostProcessSettings();
     void ShowShadowSettings();
+    void ShowTextureMemorySettings();
     void ShowLightingSettings();
     
     // 资源管理
@@ -170,7 +172,6 @@ private:
     
     // 资源预览和管理
     AssetItem* selectedAsset = nullptr; // 当前选中的资源
-    std::unordered_map<std::string, std::shared_ptr<void>> preloadedAssets; // 预加载资源缓存
     bool enableAssetPreloading = true; // 是否启用资源预加载
     float previewWindowSize = 256.0f; // 预览窗口大小
     
@@ -0,0 +1,26 @@
+// 每帧共享的相机与全局参数，由 Renderer::SetGlobalUniforms 每帧更新一次
+// std140 布局，必须与 Renderer::FrameData 保持一致
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec3 viewPos;       // 相机位置
+    float time;         // 累计时间（秒）
+    vec2 screenSize;    // 渲染目标尺寸
+    float nearPlane;
+    float farPlane;
+
+    // 全局特效开关
+    bool shadowEnabled;
+    bool ssaoEnabled;
+    bool iblEnabled;    // 已考虑当前环境贴图是否可用
+    bool hdrEnabled;
+    bool bloomEnabled;
+    bool gammaEnabled;
+    float deltaTime;
+
+    // 从深度重建位置
+    mat4 inverseProjection;
+    mat4 inverseView;
+};
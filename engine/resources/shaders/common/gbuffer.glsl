@@ -0,0 +1,38 @@
+// 紧凑 G 缓冲的编码和解码，布局与 Renderer::SetupGBuffer 保持一致：
+//   0  RGBA8    反照率 rgb | AO
+//   1  RGBA16F  八面体编码的世界空间法线 xy | 粗糙度 | 金属度
+//   2  RGBA8    镜面反射颜色 rgb | 材质类型（0 Blinn-Phong，1 PBR）
+//   深度/模板   D24S8 纹理，位置由深度和 FrameData 中的逆矩阵重建
+// 依赖 frame_data.glsl
+
+vec2 OctWrap(vec2 v)
+{
+    return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// 单位向量 -> [-1, 1]^2
+vec2 EncodeNormal(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.z >= 0.0 ? n.xy : OctWrap(n.xy);
+}
+
+vec3 DecodeNormal(vec2 f)
+{
+    vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+// uv 为屏幕纹理坐标，depth 为深度纹理中的值
+vec3 ViewPositionFromDepth(vec2 uv, float depth)
+{
+    vec4 position = inverseProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return position.xyz / position.w;
+}
+
+vec3 WorldPositionFromDepth(vec2 uv, float depth)
+{
+    return (inverseView * vec4(ViewPositionFromDepth(uv, depth), 1.0)).xyz;
+}
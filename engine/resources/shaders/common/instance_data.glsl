@@ -0,0 +1,25 @@
+// 实例变换表，由 RenderQueue 每帧上传；合并成实例化绘制的连续绘制包按顺序存放
+// std430 布局，必须与 InstanceTransform 保持一致
+struct InstanceTransform
+{
+    mat4 model;
+    mat4 normalMatrix; // 左上 3x3 为法线矩阵
+};
+
+layout (std430, binding = 1) readonly buffer InstanceTable
+{
+    InstanceTransform instances[];
+};
+
+// 为 false 时（如编辑器、非队列绘制）使用 model / normalMatrix uniform
+uniform bool useInstanceData = false;
+
+mat4 InstanceModelMatrix(mat4 fallback)
+{
+    return useInstanceData ? instances[gl_BaseInstance + gl_InstanceID].model : fallback;
+}
+
+mat3 InstanceNormalMatrix(mat3 fallback)
+{
+    return useInstanceData ? mat3(instances[gl_BaseInstance + gl_InstanceID].normalMatrix) : fallback;
+}
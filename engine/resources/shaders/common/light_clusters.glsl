@@ -0,0 +1,41 @@
+// 分簇光照：视锥按屏幕 16x9 个图块、深度方向 24 个指数切片划分为簇，
+// 每帧由 LightClusters（计算着色器或 CPU 回退）把点光源和聚光灯分配到与其相交的簇。
+// 依赖 frame_data.glsl；簇的划分必须与 LightClusters 中的常量保持一致
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+#define CLUSTER_COUNT (CLUSTER_X * CLUSTER_Y * CLUSTER_Z)
+#define MAX_LIGHTS_PER_CLUSTER 128
+
+// 计算着色器在包含前定义为空以写入
+#ifndef CLUSTER_BUFFER_ACCESS
+#define CLUSTER_BUFFER_ACCESS readonly
+#endif
+
+// 簇下标 = x + y * CLUSTER_X + z * CLUSTER_X * CLUSTER_Y
+layout (std430, binding = 2) CLUSTER_BUFFER_ACCESS buffer ClusterLightTable
+{
+    uint clusterLightCounts[CLUSTER_COUNT];
+    uint clusterLightIndices[]; // 每个簇占 MAX_LIGHTS_PER_CLUSTER 个槽位，存光源表下标
+};
+
+// 第 slice 个切片的近端深度（视空间，正值）；近远平面之比按指数划分
+float ClusterSliceDepth(float slice)
+{
+    return nearPlane * pow(farPlane / nearPlane, slice / float(CLUSTER_Z));
+}
+
+uint ClusterSlice(float viewDepth)
+{
+    float slice = log(max(viewDepth, nearPlane) / nearPlane) / log(farPlane / nearPlane) * float(CLUSTER_Z);
+    return uint(clamp(slice, 0.0, float(CLUSTER_Z - 1)));
+}
+
+// 片段所在的簇：fragCoord 为 gl_FragCoord.xy，worldPos 为世界空间位置
+uint ClusterIndex(vec2 fragCoord, vec3 worldPos)
+{
+    vec2 tile = clamp(fragCoord / screenSize * vec2(CLUSTER_X, CLUSTER_Y), vec2(0.0),
+                      vec2(CLUSTER_X - 1, CLUSTER_Y - 1));
+    float viewDepth = -(view * vec4(worldPos, 1.0)).z;
+    return uint(tile.x) + uint(tile.y) * CLUSTER_X + ClusterSlice(viewDepth) * (CLUSTER_X * CLUSTER_Y);
+}
@@ -0,0 +1,47 @@
+// GPU 光源表，由 LightBuffer 维护，只在光源参数变化时重新上传
+// std430 布局，必须与 GpuLightData 保持一致
+struct LightData
+{
+    vec4 position;      // xyz 位置，w 光源类型（0 点光源，1 方向光，2 聚光灯）
+    vec4 direction;     // xyz 方向，w 是否投射阴影
+    vec4 ambient;       // rgb 环境光（已乘强度），a 衰减常数项
+    vec4 diffuse;       // rgb 漫反射（已乘强度），a 衰减一次项
+    vec4 specular;      // rgb 镜面反射（已乘强度），a 衰减二次项
+    vec4 spot;          // x 内切角余弦，y 外切角余弦
+    vec4 shadowRect;    // 点光源/聚光灯：阴影图集中的图块（偏移, 缩放）；方向光：x 为级联阴影槽位
+    mat4 lightSpaceMatrix; // 方向光不使用，级联矩阵见 shadow_cascades.glsl
+};
+
+// 光源按 [方向光 | 点光源 | 聚光灯] 顺序连续存放
+layout (std430, binding = 0) readonly buffer LightTable
+{
+    ivec4 lightCounts;  // x 方向光，y 点光源，z 聚光灯数量
+    LightData lights[];
+};
+
+int DirLightOffset()   { return 0; }
+int PointLightOffset() { return lightCounts.x; }
+int SpotLightOffset()  { return lightCounts.x + lightCounts.y; }
+
+// 衰减
+float LightAttenuation(LightData light, float distance)
+{
+    return 1.0 / (light.ambient.a + light.diffuse.a * distance + light.specular.a * (distance * distance));
+}
+
+// 影响半径：亮度衰减到 3/256 时的距离（与 PointLight 光体积的经验公式一致）
+float LightRange(LightData light)
+{
+    float maxBrightness = max(light.diffuse.r, max(light.diffuse.g, light.diffuse.b));
+    float constant = light.ambient.a - 256.0 / 3.0 * maxBrightness;
+    float linear = light.diffuse.a;
+    float quadratic = light.specular.a;
+    if (quadratic <= 0.0)
+        return linear > 0.0 ? max(-constant / linear, 0.01) : 1e30;
+    return max((-linear + sqrt(linear * linear - 4.0 * quadratic * constant)) / (2.0 * quadratic), 0.01);
+}
+
+bool LightHasShadows(LightData light)
+{
+    return light.direction.w > 0.5;
+}
@@ -0,0 +1,7 @@
+// 切线空间法线贴图解码：只使用 xy，z 由单位长度重建。
+// 法线贴图可能压缩为双通道 BC5（b 通道为 0），未压缩的 RGB 贴图结果相同
+vec3 UnpackNormalMap(vec4 texel)
+{
+    vec2 xy = texel.xy * 2.0 - 1.0;
+    return vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0)));
+}
@@ -0,0 +1,63 @@
+// 方向光的级联阴影，由 CascadedShadowMap 每帧更新
+// std140 布局，必须与 CascadedShadowMap::GpuData 保持一致；依赖 frame_data.glsl
+#define MAX_SHADOW_CASCADES 4
+#define MAX_CASCADED_LIGHTS 4
+
+layout (std140, binding = 1) uniform ShadowCascades
+{
+    mat4 cascadeMatrices[MAX_CASCADED_LIGHTS * MAX_SHADOW_CASCADES]; // [槽位 * MAX_SHADOW_CASCADES + 级联]
+    vec4 cascadeSplits;         // 各级联远端的视空间深度
+    vec4 cascadeTexelSizes;     // 各级联一个纹素对应的世界空间尺寸
+    int cascadeCount;
+    float cascadeBlendRange;    // 级联末端与下一级混合的比例
+};
+
+// 单个级联的 3x3 PCF；阴影纹理数组第 槽位 * cascadeCount + 级联 层
+float SampleShadowCascade(sampler2DArray shadowMap, int slot, int cascade, vec3 worldPos, vec3 normal)
+{
+    // 沿法线偏移一个多纹素，偏移量随级联的纹素大小变化，远处级联不会出现阴影失真
+    vec3 offsetPos = worldPos + normal * cascadeTexelSizes[cascade] * 1.5;
+    vec4 lightSpace = cascadeMatrices[slot * MAX_SHADOW_CASCADES + cascade] * vec4(offsetPos, 1.0);
+    vec3 projCoords = lightSpace.xyz * 0.5 + 0.5; // 正交投影，w 为 1
+    if (projCoords.z > 1.0)
+        return 0.0;
+
+    float layer = float(slot * cascadeCount + cascade);
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    float shadow = 0.0;
+    for (int x = -1; x <= 1; ++x)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            float pcfDepth = texture(shadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, layer)).r;
+            shadow += projCoords.z - 0.0005 > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    return shadow / 9.0;
+}
+
+// 按视空间深度选择级联，级联末端与下一级线性混合以隐藏交界；超出最后一级时阴影淡出
+float CascadedShadow(sampler2DArray shadowMap, int slot, vec3 worldPos, vec3 normal)
+{
+    if (slot < 0)
+        return 0.0;
+
+    float depth = -(view * vec4(worldPos, 1.0)).z;
+    int cascade = 0;
+    while (cascade < cascadeCount && depth > cascadeSplits[cascade])
+        ++cascade;
+    if (cascade >= cascadeCount)
+        return 0.0;
+
+    float shadow = SampleShadowCascade(shadowMap, slot, cascade, worldPos, normal);
+
+    float cascadeStart = cascade == 0 ? nearPlane : cascadeSplits[cascade - 1];
+    float blendStart = mix(cascadeSplits[cascade], cascadeStart, cascadeBlendRange);
+    if (depth > blendStart)
+    {
+        float t = (depth - blendStart) / max(cascadeSplits[cascade] - blendStart, 1e-4);
+        float next = cascade + 1 < cascadeCount ? SampleShadowCascade(shadowMap, slot, cascade + 1, worldPos, normal) : 0.0;
+        shadow = mix(shadow, next, t);
+    }
+    return shadow;
+}
@@ -0,0 +1,563 @@
+// 延迟光照的公共部分：G 缓冲读取和各类光源的着色函数。
+// 光体积绘制（lighting_pass.frag）和分块计算着色器（tiled_lighting.comp）共用，保证两条路径结果一致。
+// 依赖 frame_data.glsl 和 light_data.glsl
+#include "../common/gbuffer.glsl"
+#ifdef USE_SHADOWS
+#include "../common/shadow_cascades.glsl"
+#endif
+
+// G-Buffer 纹理（各变体共用固定的纹理单元，布局见 gbuffer.glsl）
+layout(binding = 0) uniform sampler2D gAlbedoAo;
+layout(binding = 1) uniform sampler2D gNormalMaterial;
+layout(binding = 2) uniform sampler2D gSpecular;
+layout(binding = 3) uniform sampler2D gDepth;
+#ifdef USE_SSAO
+layout(binding = 8) uniform sampler2D ssao;
+#endif
+
+// IBL
+#ifdef USE_IBL
+layout(binding = 20) uniform samplerCube irradianceMap;
+layout(binding = 21) uniform samplerCube prefilterMap;
+layout(binding = 22) uniform sampler2D brdfLUT;
+#endif
+
+// 光源结构体
+struct L {
+    vec3 position;      // 位置（点光源和聚光灯）
+    vec3 direction;     // 方向（方向光和聚光灯）
+    vec3 ambient;       // 环境光
+    vec3 diffuse;       // 漫反射
+    vec3 specular;      // 镜面反射
+    
+    // 衰减参数
+    float constant;
+    float linear;
+    float quadratic;
+    
+    // 聚光灯参数
+    float cutOff;       // 内切角余弦值
+    float outerCutOff;  // 外切角余弦值
+    
+    // 阴影相关
+    bool hasShadows;
+    mat4 lightSpaceMatrix;
+    vec4 shadowRect;    // 阴影图集中的图块（偏移, 缩放）；方向光的 x 为级联阴影槽位
+};
+L light; // 当前光源，调用 ShadeLight 前用 LoadLight 从光源表中取出
+#ifdef USE_SHADOWS
+layout(binding = 30) uniform sampler2D lightShadowMap; // 阴影图集，点光源和聚光灯共享
+layout(binding = 31) uniform sampler2DArray lightShadowCascades; // 方向光的级联阴影
+#endif
+
+const float PI = 3.14159265359;
+const float SHININESS_FACTOR = 32.0; // 高光系数
+
+// PBR functions
+float DistributionGGX(vec3 N, vec3 H, float roughness);
+float GeometrySchlickGGX(float NdotV, float roughness);
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness);
+vec3 fresnelSchlick(float cosTheta, vec3 F0);
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness);
+
+// 阴影计算函数
+float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap, vec4 shadowRect)
+{
+    // 执行透视除法
+    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+    
+    // 变换到[0,1]范围
+    projCoords = projCoords * 0.5 + 0.5;
+    
+    // 检查是否在阴影贴图范围内
+    if(projCoords.z > 1.0 || projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0)
+        return 0.0;
+    
+    // 获取当前片段在光源视角下的深度
+    float currentDepth = projCoords.z;
+    
+    // 映射到阴影图集中该光源的图块，并把PCF采样限制在图块内
+    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    vec2 atlasCoords = shadowRect.xy + projCoords.xy * shadowRect.zw;
+    vec2 tileMin = shadowRect.xy + texelSize * 0.5;
+    vec2 tileMax = shadowRect.xy + shadowRect.zw - texelSize * 0.5;
+    
+    // 检查当前片段是否在阴影中
+    float shadow = 0.0;
+    
+    // PCF软阴影
+    for(int x = -1; x <= 1; ++x)
+    {
+        for(int y = -1; y <= 1; ++y)
+        {
+            vec2 sampleCoords = clamp(atlasCoords + vec2(x, y) * texelSize, tileMin, tileMax);
+            float pcfDepth = texture(shadowMap, sampleCoords).r;
+            shadow += currentDepth - 0.005 > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    shadow /= 9.0;
+    
+    return shadow;
+}
+
+// PBR function implementations
+float DistributionGGX(vec3 N, vec3 H, float roughness)
+{
+    float a = roughness*roughness;
+    float a2 = a*a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH*NdotH;
+
+    float num = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return num / denom;
+}
+
+float GeometrySchlickGGX(float NdotV, float roughness)
+{
+    float r = (roughness + 1.0);
+    float k = (r*r) / 8.0;
+
+    float num = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+
+    return num / denom;
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+{
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+
+    return ggx1 * ggx2;
+}
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
+{
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
+{
+    return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+// 光照计算函数
+vec3 calculateDirectionalLight(vec3 fragPos, vec3 normal, vec3 ambientColor, vec3 albedo, vec3 specularColor, float roughness, float ao);
+vec3 calculatePointLight(vec3 fragPos, vec3 normal, vec3 ambientColor, vec3 albedo, vec3 specularColor, float roughness, float ao);
+vec3 calculateSpotLight(vec3 fragPos, vec3 normal, vec3 ambientColor, vec3 albedo, vec3 specularColor, float roughness, float ao);
+
+// PBR 光照计算函数
+vec3 calculatePBRDirectionalLight(vec3 fragPos, vec3 normal, vec3 albedo, float metallic, float roughness, float ao);
+vec3 calculatePBRPointLight(vec3 fragPos, vec3 normal, vec3 albedo, float metallic, float roughness, float ao);
+vec3 calculatePBRSpotLight(vec3 fragPos, vec3 normal, vec3 albedo, float metallic, float roughness, float ao);
+
+L LoadLight(LightData data)
+{
+    L l;
+    l.position = data.position.xyz;
+    l.direction = data.direction.xyz;
+    l.ambient = data.ambient.rgb;
+    l.diffuse = data.diffuse.rgb;
+    l.specular = data.specular.rgb;
+    l.constant = data.ambient.a;
+    l.linear = data.diffuse.a;
+    l.quadratic = data.specular.a;
+    l.cutOff = data.spot.x;
+    l.outerCutOff = data.spot.y;
+    l.hasShadows = LightHasShadows(data);
+    l.lightSpaceMatrix = data.lightSpaceMatrix;
+    l.shadowRect = data.shadowRect;
+    return l;
+}
+
+// 计算方向光
+vec3 calculateDirectionalLight(vec3 fragPos, vec3 normal, vec3 ambientColor, vec3 albedo, vec3 specularColor, float roughness, float ao) {
+    // 光源方向（从光源指向片段）
+    vec3 lightDir = normalize(-light.direction);
+    // 视线方向（从片段指向相机）
+    vec3 viewDir = normalize(viewPos - fragPos);
+    
+    // 漫反射分量
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * diff * albedo;
+    
+    // 镜面反射分量（Blinn-Phong）
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), SHININESS_FACTOR);
+    vec3 specular = light.specular * spec * specularColor;
+    
+    // 阴影计算
+    float shadow = 0.0;
+#ifdef USE_SHADOWS
+    if (light.hasShadows) {
+        shadow = CascadedShadow(lightShadowCascades, int(light.shadowRect.x), fragPos, normal);
+    }
+#endif
+    
+    // 环境光分量
+    vec3 ambient = light.ambient * ambientColor * ao;
+    
+    // 应用阴影
+    diffuse *= (1.0 - shadow);
+    specular *= (1.0 - shadow);
+
+    return ambient + diffuse + specular;
+}
+
+// 计算点光源
+vec3 calculatePointLight(vec3 fragPos, vec3 normal, vec3 ambientColor, vec3 albedo, vec3 specularColor, float roughness, float ao) {
+    // 光源方向（从片段指向光源）
+    vec3 lightDir = normalize(light.position - fragPos);
+
+    float diff = max(dot(normal, lightDir), 0.0);
+    // 视线方向（从片段指向相机）
+    vec3 viewDir = normalize(viewPos - fragPos);
+
+    // 镜面反射分量（Blinn-Phong）
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), SHININESS_FACTOR);
+
+    // 距离衰减计算
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + 
+                             light.quadratic * (distance * distance));
+    
+    // 阴影计算
+    float shadow = 0.0;
+#ifdef USE_SHADOWS
+    if (light.hasShadows) {
+        vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fragPos, 1.0);
+        shadow = ShadowCalculation(fragPosLightSpace, lightShadowMap, light.shadowRect);
+    }
+#endif
+    
+    // 漫反射分量
+    vec3 diffuse = light.diffuse * diff * albedo;
+    vec3 specular = light.specular * spec * specularColor;
+    // 环境光分量
+    vec3 ambient = light.ambient * ambientColor * ao;
+    
+    // 应用衰减和阴影
+    ambient *= attenuation;
+    diffuse *= attenuation * (1.0 - shadow);
+    specular *= attenuation * (1.0 - shadow);
+    
+    return ambient + diffuse + specular;
+}
+
+// 计算聚光灯
+vec3 calculateSpotLight(vec3 fragPos, vec3 normal, vec3 ambientColor, vec3 albedo, vec3 specularColor, float roughness, float ao) {
+    // 光源方向（从片段指向光源）
+    vec3 lightDir = normalize(light.position - fragPos);
+    // 视线方向（从片段指向相机）
+    vec3 viewDir = normalize(viewPos - fragPos);
+    
+    // 聚光灯方向（从光源指向目标）
+    vec3 spotDir = normalize(-light.direction);
+    
+    // 计算聚光灯角度
+    float theta = dot(lightDir, spotDir);
+    float epsilon = light.cutOff - light.outerCutOff;
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    
+    // 距离衰减计算
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + 
+                             light.quadratic * (distance * distance));
+    
+    // 阴影计算
+    float shadow = 0.0;
+#ifdef USE_SHADOWS
+    if (light.hasShadows) {
+        vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fragPos, 1.0);
+        shadow = ShadowCalculation(fragPosLightSpace, lightShadowMap, light.shadowRect);
+    }
+#endif
+    
+    // 漫反射分量
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * diff * albedo;
+    
+    // 镜面反射分量（Blinn-Phong）
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), SHININESS_FACTOR);
+    vec3 specular = light.specular * spec * specularColor;
+    
+    // 环境光分量
+    vec3 ambient = light.ambient * ambientColor * ao;
+
+    // 应用衰减、聚光强度和阴影
+    ambient *= attenuation * intensity;
+    diffuse *= attenuation * intensity * (1.0 - shadow);
+    specular *= attenuation * intensity * (1.0 - shadow);
+    
+    return ambient + diffuse + specular;
+}
+
+// PBR方向光计算
+vec3 calculatePBRDirectionalLight(vec3 fragPos, vec3 normal, vec3 albedo, float metallic, float roughness, float ao) {
+    vec3 N = normal;
+    vec3 V = normalize(viewPos - fragPos);
+    vec3 L = normalize(-light.direction);
+    vec3 H = normalize(V + L);
+    
+    // F0计算 - 电介质为0.04，金属为albedo
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+    
+    // Cook-Torrance BRDF计算
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+    
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+    
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular = numerator / denominator;
+    
+    float NdotL = max(dot(N, L), 0.0);
+    
+    // 阴影计算
+    float shadow = 0.0;
+#ifdef USE_SHADOWS
+    if (light.hasShadows) {
+        shadow = CascadedShadow(lightShadowCascades, int(light.shadowRect.x), fragPos, normal);
+    }
+#endif
+    
+    vec3 Lo = (kD * albedo / PI + specular) * light.diffuse * NdotL * (1.0 - shadow);
+    
+    // IBL环境光照
+    vec3 ambient = light.ambient * albedo * ao;
+#ifdef USE_IBL
+    {
+        vec3 F_roughness = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+        
+        vec3 kS_ibl = F_roughness;
+        vec3 kD_ibl = 1.0 - kS_ibl;
+        kD_ibl *= 1.0 - metallic;
+        
+        vec3 irradiance = texture(irradianceMap, N).rgb;
+        vec3 diffuse = irradiance * albedo;
+        
+        const float MAX_REFLECTION_LOD = 4.0;
+        vec3 R = reflect(-V, N);
+        vec3 prefilteredColor = textureLod(prefilterMap, R, roughness * MAX_REFLECTION_LOD).rgb;
+        vec2 brdf = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
+        vec3 specular_ibl = prefilteredColor * (F_roughness * brdf.x + brdf.y);
+        
+        ambient = (kD_ibl * diffuse + specular_ibl) * ao;
+    }
+#endif
+    
+    return ambient + Lo;
+}
+
+// PBR点光源计算
+vec3 calculatePBRPointLight(vec3 fragPos, vec3 normal, vec3 albedo, float metallic, float roughness, float ao) {
+    vec3 N = normal;
+    vec3 V = normalize(viewPos - fragPos);
+    vec3 L = normalize(light.position - fragPos);
+    vec3 H = normalize(V + L);
+    
+    // 距离衰减计算
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    vec3 radiance = light.diffuse * attenuation;
+    
+    // F0计算
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+    
+    // Cook-Torrance BRDF计算
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+    
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+    
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular = numerator / denominator;
+    
+    float NdotL = max(dot(N, L), 0.0);
+    
+    // 阴影计算
+    float shadow = 0.0;
+#ifdef USE_SHADOWS
+    if (light.hasShadows) {
+        vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fragPos, 1.0);
+        shadow = ShadowCalculation(fragPosLightSpace, lightShadowMap, light.shadowRect);
+    }
+#endif
+    
+    vec3 Lo = (kD * albedo / PI + specular) * radiance * NdotL * (1.0 - shadow);
+    
+    // IBL环境光照
+    vec3 ambient = light.ambient * albedo * ao;
+#ifdef USE_IBL
+    {
+        vec3 F_roughness = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+        
+        vec3 kS_ibl = F_roughness;
+        vec3 kD_ibl = 1.0 - kS_ibl;
+        kD_ibl *= 1.0 - metallic;
+        
+        vec3 irradiance = texture(irradianceMap, N).rgb;
+        vec3 diffuse = irradiance * albedo;
+        
+        const float MAX_REFLECTION_LOD = 4.0;
+        vec3 R = reflect(-V, N);
+        vec3 prefilteredColor = textureLod(prefilterMap, R, roughness * MAX_REFLECTION_LOD).rgb;
+        vec2 brdf = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
+        vec3 specular_ibl = prefilteredColor * (F_roughness * brdf.x + brdf.y);
+        
+        ambient = (kD_ibl * diffuse + specular_ibl) * ao;
+    }
+#endif
+    
+    return ambient + Lo;
+}
+
+// PBR聚光灯计算
+vec3 calculatePBRSpotLight(vec3 fragPos, vec3 normal, vec3 albedo, float metallic, float roughness, float ao) {
+    vec3 N = normal;
+    vec3 V = normalize(viewPos - fragPos);
+    vec3 L = normalize(light.position - fragPos);
+    vec3 H = normalize(V + L);
+    
+    // 聚光灯计算
+    vec3 spotDir = normalize(-light.direction);
+    float theta = dot(L, spotDir);
+    float epsilon = light.cutOff - light.outerCutOff;
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    
+    // 距离衰减计算
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    vec3 radiance = light.diffuse * attenuation * intensity;
+    
+    // F0计算
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+    
+    // Cook-Torrance BRDF计算
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+    
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+    
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular = numerator / denominator;
+    
+    float NdotL = max(dot(N, L), 0.0);
+    
+    // 阴影计算
+    float shadow = 0.0;
+#ifdef USE_SHADOWS
+    if (light.hasShadows) {
+        vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fragPos, 1.0);
+        shadow = ShadowCalculation(fragPosLightSpace, lightShadowMap, light.shadowRect);
+    }
+#endif
+    
+    vec3 Lo = (kD * albedo / PI + specular) * radiance * NdotL * (1.0 - shadow);
+    
+    // IBL环境光照
+    vec3 ambient = light.ambient * albedo * ao;
+#ifdef USE_IBL
+    {
+        vec3 F_roughness = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+        
+        vec3 kS_ibl = F_roughness;
+        vec3 kD_ibl = 1.0 - kS_ibl;
+        kD_ibl *= 1.0 - metallic;
+        
+        vec3 irradiance = texture(irradianceMap, N).rgb;
+        vec3 diffuse = irradiance * albedo;
+        
+        const float MAX_REFLECTION_LOD = 4.0;
+        vec3 R = reflect(-V, N);
+        vec3 prefilteredColor = textureLod(prefilterMap, R, roughness * MAX_REFLECTION_LOD).rgb;
+        vec2 brdf = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
+        vec3 specular_ibl = prefilteredColor * (F_roughness * brdf.x + brdf.y);
+        
+        ambient = (kD_ibl * diffuse + specular_ibl) * ao;
+    }
+#endif
+    
+    return ambient + Lo;
+}
+
+// G 缓冲中一个像素的表面属性
+struct GBufferSample
+{
+    bool valid; // 该像素是否有几何体（背景像素的深度为 1）
+    vec3 fragPos;
+    vec3 normal;
+    vec3 albedo;
+    vec3 specularColor;
+    float metallic;
+    float roughness;
+    float ao;           // 已乘 SSAO 遮蔽
+    vec3 ambient;
+    bool pbr;
+};
+
+GBufferSample ReadGBuffer(ivec2 pixel)
+{
+    GBufferSample s;
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    s.valid = depth < 1.0;
+    s.fragPos = WorldPositionFromDepth((vec2(pixel) + 0.5) / screenSize, depth);
+
+    vec4 albedoAo = texelFetch(gAlbedoAo, pixel, 0);
+    vec4 normalMaterial = texelFetch(gNormalMaterial, pixel, 0);
+    vec4 specular = texelFetch(gSpecular, pixel, 0);
+    s.albedo = albedoAo.rgb;
+    s.ao = albedoAo.a;
+#ifdef USE_SSAO
+    s.ao *= texelFetch(ssao, pixel, 0).r; // 应用SSAO遮挡
+#endif
+    s.normal = DecodeNormal(normalMaterial.xy);
+    s.roughness = normalMaterial.z;
+    s.metallic = normalMaterial.w;
+    s.specularColor = specular.rgb;
+    s.pbr = specular.a > 0.5; // 0.0 = Blinn-Phong, 1.0 = PBR
+    s.ambient = s.albedo;     // Blinn-Phong 的环境光颜色即反照率
+    return s;
+}
+
+// 用当前光源 light 照亮一个像素，lightType 0:点光源, 1:方向光, 2:聚光灯
+vec3 ShadeLight(GBufferSample s, int lightType)
+{
+    // 检测材质类型并选择相应的光照模型
+    if (s.pbr) {
+        switch(lightType) {
+            case 0: return calculatePBRPointLight(s.fragPos, s.normal, s.albedo, s.metallic, s.roughness, s.ao);
+            case 1: return calculatePBRDirectionalLight(s.fragPos, s.normal, s.albedo, s.metallic, s.roughness, s.ao);
+            case 2: return calculatePBRSpotLight(s.fragPos, s.normal, s.albedo, s.metallic, s.roughness, s.ao);
+        }
+    } else {
+        switch(lightType) {
+            case 0: return calculatePointLight(s.fragPos, s.normal, s.ambient, s.albedo, s.specularColor, s.roughness, s.ao);
+            case 1: return calculateDirectionalLight(s.fragPos, s.normal, s.ambient, s.albedo, s.specularColor, s.roughness, s.ao);
+            case 2: return calculateSpotLight(s.fragPos, s.normal, s.ambient, s.albedo, s.specularColor, s.roughness, s.ao);
+        }
+    }
+    return vec3(0.0);
+}
@@ -0,0 +1,47 @@
+#version 460 core
+// 把紧凑 G 缓冲解码为逐属性的纹理，仅供编辑器的调试视口显示
+#include "../common/frame_data.glsl"
+#include "../common/gbuffer.glsl"
+layout (location = 0) out vec4 outPosition;
+layout (location = 1) out vec4 outNormal;
+layout (location = 2) out vec4 outAlbedo;
+layout (location = 3) out vec4 outSpecular;
+layout (location = 4) out vec4 outMetallic;
+layout (location = 5) out vec4 outRoughness;
+layout (location = 6) out vec4 outAo;
+layout (location = 7) out vec4 outAmbient;
+
+in vec2 TexCoords;
+
+// 与光照阶段使用相同的纹理单元
+layout(binding = 0) uniform sampler2D gAlbedoAo;
+layout(binding = 1) uniform sampler2D gNormalMaterial;
+layout(binding = 2) uniform sampler2D gSpecular;
+layout(binding = 3) uniform sampler2D gDepth;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    if (depth >= 1.0)
+    {
+        // 背景
+        outPosition = outNormal = outAlbedo = outSpecular = vec4(0.0);
+        outMetallic = outRoughness = outAo = outAmbient = vec4(0.0);
+        return;
+    }
+
+    vec4 albedoAo = texelFetch(gAlbedoAo, pixel, 0);
+    vec4 normalMaterial = texelFetch(gNormalMaterial, pixel, 0);
+    vec4 specular = texelFetch(gSpecular, pixel, 0);
+
+    outPosition = vec4(WorldPositionFromDepth(TexCoords, depth), 1.0);
+    outNormal = vec4(DecodeNormal(normalMaterial.xy), 1.0);
+    outAlbedo = vec4(albedoAo.rgb, 1.0);
+    outSpecular = vec4(specular.rgb, 1.0);
+    outMetallic = vec4(vec3(normalMaterial.w), 1.0);
+    outRoughness = vec4(vec3(normalMaterial.z), 1.0);
+    outAo = vec4(vec3(albedoAo.a), 1.0);
+    // Blinn-Phong 的环境光颜色即反照率，PBR 使用固定的环境光
+    outAmbient = vec4(specular.a > 0.5 ? vec3(0.1) : albedoAo.rgb, 1.0);
+}
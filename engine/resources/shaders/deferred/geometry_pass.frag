@@ -1,12 +1,10 @@
 #version 460 core
-layout (location = 0) out vec4 gPosition;
-layout (location = 1) out vec4 gNormal;
-layout (location = 2) out vec4 gAlbedo;
-layout (location = 3) out vec4 gSpecular;
-layout (location = 4) out vec4 gMetallic; // 金属度
-layout (location = 5) out vec4 gRoughness; // 粗糙度
-layout (location = 6) out vec4 gAo; // 环境光遮蔽
-layout (location = 7) out vec4 gAmbient; // 环境光
+#include "../common/frame_data.glsl"
+#include "../common/normal_map.glsl"
+#include "../common/gbuffer.glsl"
+layout (location = 0) out vec4 gAlbedoAo;       // 反照率 + 环境光遮蔽
+layout (location = 1) out vec4 gNormalMaterial; // 八面体法线 + 粗糙度 + 金属度
+layout (location = 2) out vec4 gSpecular;       // 镜面反射颜色 + 材质类型
 
 in vec2 TexCoords;
 in vec3 FragPos;
@@ -28,33 +26,20 @@ struct Material {
     sampler2D metallicMap;
     sampler2D roughnessMap;
     sampler2D aoMap;
-
-    bool useDiffuseMap;
-    bool useSpecularMap;
-    bool useNormalMap;
-    bool useMetallicMap;
-    bool useRoughnessMap;
-    bool useAoMap;
+    // 是否使用各贴图由变体宏 HAS_*_MAP 决定（漫反射贴图对应 HAS_ALBEDO_MAP）
 };
 
 uniform Material material;
-uniform float NEAR= 0.1;
-uniform float FAR= 100.0;
-float LinearizeDepth(float depth)
-{
-    float z = depth * 2.0 - 1.0; // 回到NDC
-    return (2.0 * NEAR * FAR) / (FAR + NEAR - z * (FAR - NEAR));    
-}
 
 void main() {
-    // 存储片段位置向量和深度
-    gPosition = vec4(FragPos,  LinearizeDepth(gl_FragCoord.z));
+    // 位置由深度重建，不再单独存储
     
     // 存储法线向量
     vec3 N = normalize(Normal);
-    if (material.useNormalMap) {
+#ifdef HAS_NORMAL_MAP
+    {
         // 从法线贴图获取法线
-        vec3 tangentNormal = texture(material.normalMap, TexCoords).xyz * 2.0 - 1.0;
+        vec3 tangentNormal = UnpackNormalMap(texture(material.normalMap, TexCoords));
         
         // 创建TBN矩阵
         vec3 T = normalize(Tangent);
@@ -62,22 +47,39 @@ void main() {
         mat3 TBN = mat3(T, B, N);
         N = normalize(TBN * tangentNormal);
     }
+#endif
     
-    gNormal = vec4(N, 1.0);
     
     // 存储反照率
-    gAlbedo = vec4(material.useDiffuseMap ? 
-        texture(material.diffuseMap, TexCoords).rgb : material.diffuse, 1.0);
+#ifdef HAS_ALBEDO_MAP
+    vec3 albedo = texture(material.diffuseMap, TexCoords).rgb;
+#else
+    vec3 albedo = material.diffuse;
+#endif
     
     // 存储金属度、粗糙度和AO
-    gSpecular = vec4(material.useSpecularMap ? 
-        texture(material.specularMap, TexCoords).rgb : material.specular, 1.0);
-    gMetallic = vec4(material.useMetallicMap ? 
-        texture(material.metallicMap, TexCoords).r : material.metallic, 0.0, 0.0, 1.0);
-    gRoughness = vec4(material.useRoughnessMap ?
-        texture(material.roughnessMap, TexCoords).r : material.roughness, 0.0, 0.0, 1.0);
-    gAo = vec4(material.useAoMap ?
-        texture(material.aoMap, TexCoords).r : 1.0, 0.0, 0.0, 0.0);
-    gAmbient = vec4(material.useDiffuseMap ?
-        texture(material.diffuseMap, TexCoords).rgb : material.diffuse, 1.0);
+#ifdef HAS_METALLIC_MAP
+    float metallic = texture(material.metallicMap, TexCoords).r;
+#else
+    float metallic = material.metallic;
+#endif
+#ifdef HAS_ROUGHNESS_MAP
+    float roughness = texture(material.roughnessMap, TexCoords).r;
+#else
+    float roughness = material.roughness;
+#endif
+#ifdef HAS_AO_MAP
+    float ao = texture(material.aoMap, TexCoords).r;
+#else
+    float ao = 1.0;
+#endif
+    gAlbedoAo = vec4(albedo, ao);
+    gNormalMaterial = vec4(EncodeNormal(N), roughness, metallic);
+    
+    // Blinn-Phong 材质的环境光颜色即反照率，由光照阶段直接使用
+#ifdef HAS_SPECULAR_MAP
+    gSpecular = vec4(texture(material.specularMap, TexCoords).rgb, 0.0);
+#else
+    gSpecular = vec4(material.specular, 0.0);
+#endif
 }
\ No newline at end of file
@@ -1,10 +1,9 @@
-#version 430 core
+#version 460 core
+#include "../common/frame_data.glsl"
 layout (location = 0) in vec3 aPos;
 
 uniform int lightType; // 0:点光源, 1:方向光, 2:聚光灯
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 void main()
 {
@@ -13,6 +12,6 @@ void main()
     } else {
         // 点光源和聚光灯：应用模型、视图和投影变换
         vec4 worldPos = model * vec4(aPos, 1.0);
-        gl_Position = projection * view * worldPos;
+        gl_Position = viewProj * worldPos;
     }
 }
\ No newline at end of file
@@ -1,13 +1,11 @@
-#version 330 core
+#version 460 core
+#include "../common/frame_data.glsl"
+#include "../common/normal_map.glsl"
+#include "../common/gbuffer.glsl"
 
-layout (location = 0) out vec3 gPosition;
-layout (location = 1) out vec3 gNormal;
-layout (location = 2) out vec4 gAlbedo;
-layout (location = 3) out vec3 gSpecular;
-layout (location = 4) out float gMetallic;
-layout (location = 5) out float gRoughness;
-layout (location = 6) out float gAo;
-layout (location = 7) out vec3 gAmbient;
+layout (location = 0) out vec4 gAlbedoAo;       // 反照率 + 环境光遮蔽
+layout (location = 1) out vec4 gNormalMaterial; // 八面体法线 + 粗糙度 + 金属度
+layout (location = 2) out vec4 gSpecular;       // 镜面反射颜色 + 材质类型
 
 in VS_OUT {
     vec3 FragPos;
@@ -23,12 +21,7 @@ struct Material {
     float roughness;
     float ao;
     
-    bool useAlbedoMap;
-    bool useMetallicMap;
-    bool useRoughnessMap;
-    bool useNormalMap;
-    bool useAOMap;
-    
+    // 是否使用各贴图由变体宏 HAS_*_MAP 决定
     sampler2D albedoMap;
     sampler2D metallicMap;
     sampler2D roughnessMap;
@@ -41,30 +34,47 @@ uniform Material material;
 // 获取法线贴图的法线
 vec3 getNormalFromMap()
 {
-    vec3 tangentNormal = texture(material.normalMap, fs_in.TexCoord).xyz * 2.0 - 1.0;
+    vec3 tangentNormal = UnpackNormalMap(texture(material.normalMap, fs_in.TexCoord));
     return normalize(fs_in.TBN * tangentNormal);
 }
 
 void main()
 {
-    // 位置 (世界空间)
-    gPosition = fs_in.FragPos;
+    // 位置由深度重建，不再单独存储
     
     // 法线 (世界空间)
-    gNormal = material.useNormalMap ? getNormalFromMap() : normalize(fs_in.Normal);
+#ifdef HAS_NORMAL_MAP
+    vec3 normal = getNormalFromMap();
+#else
+    vec3 normal = normalize(fs_in.Normal);
+#endif
     
     // 反照率
-    gAlbedo.rgb = material.useAlbedoMap ? texture(material.albedoMap, fs_in.TexCoord).rgb : material.albedo;
-    gAlbedo.a = 1.0; // 标记为PBR材质
-    
-    // 对于PBR，高光颜色设置为0，我们将使用金属度和粗糙度
-    gSpecular = vec3(0.0);
+#ifdef HAS_ALBEDO_MAP
+    vec3 albedo = texture(material.albedoMap, fs_in.TexCoord).rgb;
+#else
+    vec3 albedo = material.albedo;
+#endif
     
     // PBR参数
-    gMetallic = material.useMetallicMap ? texture(material.metallicMap, fs_in.TexCoord).r : material.metallic;
-    gRoughness = material.useRoughnessMap ? texture(material.roughnessMap, fs_in.TexCoord).r : material.roughness;
-    gAo = material.useAOMap ? texture(material.aoMap, fs_in.TexCoord).r : material.ao;
-    
-    // 环境光，暂时设为默认值
-    gAmbient = vec3(0.1);
+#ifdef HAS_METALLIC_MAP
+    float metallic = texture(material.metallicMap, fs_in.TexCoord).r;
+#else
+    float metallic = material.metallic;
+#endif
+#ifdef HAS_ROUGHNESS_MAP
+    float roughness = texture(material.roughnessMap, fs_in.TexCoord).r;
+#else
+    float roughness = material.roughness;
+#endif
+#ifdef HAS_AO_MAP
+    float ao = texture(material.aoMap, fs_in.TexCoord).r;
+#else
+    float ao = material.ao;
+#endif
+
+    gAlbedoAo = vec4(albedo, ao);
+    gNormalMaterial = vec4(EncodeNormal(normal), roughness, metallic);
+    // 对于PBR，高光颜色设置为0，我们将使用金属度和粗糙度；alpha 标记为PBR材质
+    gSpecular = vec4(0.0, 0.0, 0.0, 1.0);
 }
@@ -1,4 +1,5 @@
-#version 330 core
+#version 460 core
+#include "../common/frame_data.glsl"
 
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
@@ -14,25 +15,27 @@ out VS_OUT {
 } vs_out;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix; // CPU 端缓存的法线矩阵
+#include "../common/instance_data.glsl"
 
 void main()
 {
-    vs_out.FragPos = vec3(model * vec4(aPos, 1.0));
+    mat4 worldMatrix = InstanceModelMatrix(model);
+    mat3 worldNormalMatrix = InstanceNormalMatrix(normalMatrix);
+
+    vs_out.FragPos = vec3(worldMatrix * vec4(aPos, 1.0));
     vs_out.TexCoord = aTexCoord;
     
     // 变换法线到世界空间
-    mat3 normalMatrix = transpose(inverse(mat3(model)));
-    vs_out.Normal = normalize(normalMatrix * aNormal);
+    vs_out.Normal = normalize(worldNormalMatrix * aNormal);
     
     // 计算TBN矩阵用于法线贴图
-    vec3 T = normalize(normalMatrix * aTangent);
+    vec3 T = normalize(worldNormalMatrix * aTangent);
     vec3 N = vs_out.Normal;
     // 重新正交化切线向量
     T = normalize(T - dot(T, N) * N);
     vec3 B = cross(N, T);
     vs_out.TBN = mat3(T, B, N);
     
-    gl_Position = projection * view * vec4(vs_out.FragPos, 1.0);
+    gl_Position = viewProj * vec4(vs_out.FragPos, 1.0);
 }
@@ -1,4 +1,13 @@
 #version 460 core
+#include "../common/frame_data.glsl"
+#include "../common/light_data.glsl"
+#include "../common/normal_map.glsl"
+#ifdef USE_CLUSTERED_LIGHTS
+#include "../common/light_clusters.glsl"
+#endif
+#ifdef USE_SHADOWS
+#include "../common/shadow_cascades.glsl"
+#endif
 
 struct Material {
     vec3 diffuse;
@@ -8,55 +17,9 @@ struct Material {
     sampler2D diffuseMap;
     sampler2D specularMap;
     sampler2D normalMap;
-    
-    bool useDiffuseMap;
-    bool useSpecularMap;
-    bool useNormalMap;
-};
-
-struct DirLight {
-    vec3 direction;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    bool hasShadows;
-    sampler2D shadowMap;
-    mat4 lightSpaceMatrix;
-};
-
-struct PointLight {
-    vec3 position;
-    
-    float constant;
-    float linear;
-    float quadratic;
-    
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    
-    bool hasShadows;
-    sampler2D shadowMap;
-    mat4 lightSpaceMatrix;
-};
-
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    float cutOff;
-    float outerCutOff;
-    
-    float constant;
-    float linear;
-    float quadratic;
-    
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
+    // 是否使用各贴图由变体宏 HAS_*_MAP 决定（漫反射贴图对应 HAS_ALBEDO_MAP）
 };
 
-#define NR_POINT_LIGHTS 4
-
 in vec3 FragPos;
 in vec2 TexCoords;
 in vec3 Normal;
@@ -65,22 +28,19 @@ in vec3 Bitangent;
 
 out vec4 FragColor;
 
-uniform vec3 viewPos;
 uniform Material material;
-uniform int numLights[3]; // [0]: DirLight, [1]: PointLight, [2]: SpotLight
-uniform bool shadowEnabled;
-uniform DirLight dirLight[NR_POINT_LIGHTS];
-uniform PointLight pointLights[NR_POINT_LIGHTS];
-uniform SpotLight spotLights[NR_POINT_LIGHTS];
-uniform bool useNormalMapping;
+#ifdef USE_SHADOWS
+layout(binding = 10) uniform sampler2D shadowAtlas; // 阴影图集，点光源和聚光灯共享
+layout(binding = 11) uniform sampler2DArray shadowCascades; // 方向光的级联阴影
+#endif
 
 // 函数声明
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 fragPos);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+vec3 CalcDirLight(LightData light, vec3 normal, vec3 viewDir, vec3 fragPos);
+vec3 CalcPointLight(LightData light, vec3 normal, vec3 fragPos, vec3 viewDir);
+vec3 CalcSpotLight(LightData light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
 // 阴影计算函数
-float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap);
+float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap, vec4 shadowRect);
 
 void main() {
     // 属性
@@ -88,11 +48,10 @@ void main() {
     vec3 viewDir = normalize(viewPos - FragPos);
     
     // 法线贴图
-    if (material.useNormalMap && useNormalMapping) {
+#ifdef HAS_NORMAL_MAP
+    {
         // 从法线贴图获取法线 [0,1]
-        vec3 normalMap = texture(material.normalMap, TexCoords).rgb;
-        // 转换到 [-1,1] 范围
-        normalMap = normalize(normalMap * 2.0 - 1.0);
+        vec3 normalMap = UnpackNormalMap(texture(material.normalMap, TexCoords));
         
         // 创建TBN矩阵
         vec3 T = normalize(Tangent);
@@ -106,30 +65,44 @@ void main() {
         
         norm = normalize(TBN * normalMap);
     }
+#endif
     
     // 光贡献
     vec3 result = vec3(0.0);
     //定向光贡献
-    for(int i = 0; i < numLights[0]; i++) {
-        result += CalcDirLight(dirLight[i], norm, viewDir, FragPos);
+    for(int i = 0; i < lightCounts.x; i++) {
+        result += CalcDirLight(lights[DirLightOffset() + i], norm, viewDir, FragPos);
     }
     
+#ifdef USE_CLUSTERED_LIGHTS
+    // 只遍历片段所在簇的点光源和聚光灯
+    uint cluster = ClusterIndex(gl_FragCoord.xy, FragPos);
+    uint clusterLights = clusterLightCounts[cluster];
+    for(uint i = 0; i < clusterLights; i++) {
+        int index = int(clusterLightIndices[cluster * MAX_LIGHTS_PER_CLUSTER + i]);
+        if (index >= SpotLightOffset())
+            result += CalcSpotLight(lights[index], norm, FragPos, viewDir);
+        else
+            result += CalcPointLight(lights[index], norm, FragPos, viewDir);
+    }
+#else
     // 点光源贡献
-    for(int i = 0; i < numLights[1]; i++) {
-        result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);
+    for(int i = 0; i < lightCounts.y; i++) {
+        result += CalcPointLight(lights[PointLightOffset() + i], norm, FragPos, viewDir);
     }
     
     // 聚光灯贡献
-    for(int i = 0; i < numLights[2]; i++) {
-        result += CalcSpotLight(spotLights[i], norm, FragPos, viewDir);
+    for(int i = 0; i < lightCounts.z; i++) {
+        result += CalcSpotLight(lights[SpotLightOffset() + i], norm, FragPos, viewDir);
     }
+#endif
     
     FragColor = vec4(result, 1.0);
 }
 
 // 计算方向光
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 fragPos) {
-    vec3 lightDir = normalize(-light.direction);
+vec3 CalcDirLight(LightData light, vec3 normal, vec3 viewDir, vec3 fragPos) {
+    vec3 lightDir = normalize(-light.direction.xyz);
     
     // 漫反射
     float diff = max(dot(normal, lightDir), 0.0);
@@ -140,27 +113,28 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 fragPos) {
     
     // 阴影计算
     float shadow = 0.0;
-    if (light.hasShadows) {
-        vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fragPos, 1.0);
-        shadow = ShadowCalculation(fragPosLightSpace, light.shadowMap);
+#ifdef USE_SHADOWS
+    if (LightHasShadows(light)) {
+        shadow = CascadedShadow(shadowCascades, int(light.shadowRect.x), fragPos, normal);
     }
+#endif
     
     // 组合结果
     vec3 ambient, diffuse, specular;
 
-    if (material.useDiffuseMap) {
-        ambient = light.ambient * vec3(texture(material.diffuseMap, TexCoords));
-        diffuse = light.diffuse * diff * vec3(texture(material.diffuseMap, TexCoords));
-    } else {
-        ambient = light.ambient * material.diffuse;
-        diffuse = light.diffuse * diff * material.diffuse;
-    }
-    
-    if (material.useSpecularMap) {
-        specular = light.specular * spec * vec3(texture(material.specularMap, TexCoords));
-    } else {
-        specular = light.specular * spec * material.specular;
-    }
+#ifdef HAS_ALBEDO_MAP
+    ambient = light.ambient.rgb * vec3(texture(material.diffuseMap, TexCoords));
+    diffuse = light.diffuse.rgb * diff * vec3(texture(material.diffuseMap, TexCoords));
+#else
+    ambient = light.ambient.rgb * material.diffuse;
+    diffuse = light.diffuse.rgb * diff * material.diffuse;
+#endif
+    
+#ifdef HAS_SPECULAR_MAP
+    specular = light.specular.rgb * spec * vec3(texture(material.specularMap, TexCoords));
+#else
+    specular = light.specular.rgb * spec * material.specular;
+#endif
     
     // 应用阴影
     diffuse *= (1.0 - shadow);
@@ -170,8 +144,8 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 fragPos) {
 }
 
 // 计算点光源
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
+vec3 CalcPointLight(LightData light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.position.xyz - fragPos);
     
     // 漫反射
     float diff = max(dot(normal, lightDir), 0.0);
@@ -181,32 +155,34 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
     
     // 衰减
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    float distance = length(light.position.xyz - fragPos);
+    float attenuation = LightAttenuation(light, distance);
     
     // 阴影计算
     float shadow = 0.0;
-    if (light.hasShadows) {
+#ifdef USE_SHADOWS
+    if (LightHasShadows(light)) {
         vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fragPos, 1.0);
-        shadow = ShadowCalculation(fragPosLightSpace, light.shadowMap);
+        shadow = ShadowCalculation(fragPosLightSpace, shadowAtlas, light.shadowRect);
     }
+#endif
     
     // 组合结果
     vec3 ambient, diffuse, specular;
 
-    if (material.useDiffuseMap) {
-        ambient = light.ambient * vec3(texture(material.diffuseMap, TexCoords));
-        diffuse = light.diffuse * diff * vec3(texture(material.diffuseMap, TexCoords));
-    } else {
-        ambient = light.ambient * material.diffuse;
-        diffuse = light.diffuse * diff * material.diffuse;
-    }
-    
-    if (material.useSpecularMap) {
-        specular = light.specular * spec * vec3(texture(material.specularMap, TexCoords));
-    } else {
-        specular = light.specular * spec * material.specular;
-    }
+#ifdef HAS_ALBEDO_MAP
+    ambient = light.ambient.rgb * vec3(texture(material.diffuseMap, TexCoords));
+    diffuse = light.diffuse.rgb * diff * vec3(texture(material.diffuseMap, TexCoords));
+#else
+    ambient = light.ambient.rgb * material.diffuse;
+    diffuse = light.diffuse.rgb * diff * material.diffuse;
+#endif
+    
+#ifdef HAS_SPECULAR_MAP
+    specular = light.specular.rgb * spec * vec3(texture(material.specularMap, TexCoords));
+#else
+    specular = light.specular.rgb * spec * material.specular;
+#endif
     
     ambient *= attenuation;
     diffuse *= attenuation * (1.0 - shadow);
@@ -216,8 +192,8 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
 }
 
 // 计算聚光灯
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
+vec3 CalcSpotLight(LightData light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 lightDir = normalize(light.position.xyz - fragPos);
     
     // 漫反射
     float diff = max(dot(normal, lightDir), 0.0);
@@ -227,30 +203,30 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
     
     // 衰减
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    float distance = length(light.position.xyz - fragPos);
+    float attenuation = LightAttenuation(light, distance);
     
     // 聚光强度
-    float theta = dot(lightDir, normalize(-light.direction));
-    float epsilon = light.cutOff - light.outerCutOff;
-    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    float theta = dot(lightDir, normalize(-light.direction.xyz));
+    float epsilon = light.spot.x - light.spot.y;
+    float intensity = clamp((theta - light.spot.y) / epsilon, 0.0, 1.0);
     
     // 组合结果
     vec3 ambient, diffuse, specular;
 
-    if (material.useDiffuseMap) {
-        ambient = light.ambient * vec3(texture(material.diffuseMap, TexCoords));
-        diffuse = light.diffuse * diff * vec3(texture(material.diffuseMap, TexCoords));
-    } else {
-        ambient = light.ambient * material.diffuse;
-        diffuse = light.diffuse * diff * material.diffuse;
-    }
-    
-    if (material.useSpecularMap) {
-        specular = light.specular * spec * vec3(texture(material.specularMap, TexCoords));
-    } else {
-        specular = light.specular * spec * material.specular;
-    }
+#ifdef HAS_ALBEDO_MAP
+    ambient = light.ambient.rgb * vec3(texture(material.diffuseMap, TexCoords));
+    diffuse = light.diffuse.rgb * diff * vec3(texture(material.diffuseMap, TexCoords));
+#else
+    ambient = light.ambient.rgb * material.diffuse;
+    diffuse = light.diffuse.rgb * diff * material.diffuse;
+#endif
+    
+#ifdef HAS_SPECULAR_MAP
+    specular = light.specular.rgb * spec * vec3(texture(material.specularMap, TexCoords));
+#else
+    specular = light.specular.rgb * spec * material.specular;
+#endif
     
     ambient *= attenuation * intensity;
     diffuse *= attenuation * intensity;
@@ -260,7 +236,7 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
 }
 
 // 阴影计算函数
-float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap)
+float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap, vec4 shadowRect)
 {
     // 执行透视除法
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
@@ -275,16 +251,22 @@ float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap)
     // 获取当前片段在光源视角下的深度
     float currentDepth = projCoords.z;
     
+    // 映射到阴影图集中该光源的图块，并把PCF采样限制在图块内
+    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    vec2 atlasCoords = shadowRect.xy + projCoords.xy * shadowRect.zw;
+    vec2 tileMin = shadowRect.xy + texelSize * 0.5;
+    vec2 tileMax = shadowRect.xy + shadowRect.zw - texelSize * 0.5;
+    
     // 检查当前片段是否在阴影中
     float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
     
     // PCF软阴影
     for(int x = -1; x <= 1; ++x)
     {
         for(int y = -1; y <= 1; ++y)
         {
-            float pcfDepth = texture(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
+            vec2 sampleCoords = clamp(atlasCoords + vec2(x, y) * texelSize, tileMin, tileMax);
+            float pcfDepth = texture(shadowMap, sampleCoords).r;
             shadow += currentDepth - 0.005 > pcfDepth ? 1.0 : 0.0;
         }
     }
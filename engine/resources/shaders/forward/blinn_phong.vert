@@ -1,4 +1,5 @@
 #version 460 core
+#include "../common/frame_data.glsl"
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
@@ -13,17 +14,19 @@ out vec3 Tangent;
 out vec3 Bitangent;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix; // CPU 端缓存的法线矩阵
+#include "../common/instance_data.glsl"
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    mat4 worldMatrix = InstanceModelMatrix(model);
+    mat3 worldNormalMatrix = InstanceNormalMatrix(normalMatrix);
+
+    FragPos = vec3(worldMatrix * vec4(aPos, 1.0));
     TexCoords = aTexCoords;
     
-    mat3 normalMatrix = transpose(inverse(mat3(model)));
-    Normal = normalMatrix * aNormal;
-    Tangent = normalMatrix * aTangent;
-    Bitangent = normalMatrix * aBitangent;
+    Normal = worldNormalMatrix * aNormal;
+    Tangent = worldNormalMatrix * aTangent;
+    Bitangent = worldNormalMatrix * aBitangent;
     
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    gl_Position = viewProj * vec4(FragPos, 1.0);
 }
\ No newline at end of file
@@ -1,4 +1,13 @@
-#version 330 core
+#version 460 core
+#include "../common/frame_data.glsl"
+#include "../common/light_data.glsl"
+#include "../common/normal_map.glsl"
+#ifdef USE_CLUSTERED_LIGHTS
+#include "../common/light_clusters.glsl"
+#endif
+#ifdef USE_SHADOWS
+#include "../common/shadow_cascades.glsl"
+#endif
 
 in VS_OUT {
     vec3 FragPos;
@@ -16,12 +25,7 @@ struct Material {
     float roughness;
     float ao;
     
-    bool useAlbedoMap;
-    bool useMetallicMap;
-    bool useRoughnessMap;
-    bool useNormalMap;
-    bool useAOMap;
-    
+    // 是否使用各贴图由变体宏 HAS_*_MAP 决定
     sampler2D albedoMap;
     sampler2D metallicMap;
     sampler2D roughnessMap;
@@ -29,63 +33,22 @@ struct Material {
     sampler2D aoMap;
 };
 
-// 光源结构
-struct DirectionalLight {
-    vec3 direction;
-    vec3 color;
-    float intensity;
-    bool shadowEnabled;
-    sampler2D shadowMap;
-    mat4 lightSpaceMatrix;
-};
-
-struct PointLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-    float constant;
-    float linear;
-    float quadratic;
-    bool shadowEnabled;
-};
-
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float intensity;
-    float constant;
-    float linear;
-    float quadratic;
-    float cutOff;
-    float outerCutOff;
-    bool shadowEnabled;
-    sampler2D shadowMap;
-    mat4 lightSpaceMatrix;
-};
-
 // Uniforms
 uniform Material material;
-uniform vec3 viewPos;
-
-// 光源数组
-#define MAX_DIR_LIGHTS 4
-#define MAX_POINT_LIGHTS 32
-#define MAX_SPOT_LIGHTS 32
 
-uniform DirectionalLight dirLights[MAX_DIR_LIGHTS];
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
-uniform int numLights[3]; // [dirLights, pointLights, spotLights]
+// 阴影图集由点光源和聚光灯共享，方向光使用级联阴影（各变体共用固定的纹理单元）
+#ifdef USE_SHADOWS
+layout(binding = 10) uniform sampler2D shadowAtlas;
+layout(binding = 11) uniform sampler2DArray shadowCascades;
+#endif
 
 // IBL
-uniform samplerCube irradianceMap;
-uniform samplerCube prefilterMap;
-uniform sampler2D brdfLUT;
-uniform bool iblEnabled;
+#ifdef USE_IBL
+layout(binding = 20) uniform samplerCube irradianceMap;
+layout(binding = 21) uniform samplerCube prefilterMap;
+layout(binding = 22) uniform sampler2D brdfLUT;
+#endif
 
-// 阴影
-uniform bool shadowEnabled;
 
 const float PI = 3.14159265359;
 
@@ -96,15 +59,15 @@ float GeometrySchlickGGX(float NdotV, float roughness);
 float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness);
 vec3 fresnelSchlick(float cosTheta, vec3 F0);
 vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness);
-float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap);
-vec3 CalcDirLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0);
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0);
+float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap, vec4 shadowRect);
+vec3 CalcDirLight(LightData light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0);
+vec3 CalcPointLight(LightData light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0);
+vec3 CalcSpotLight(LightData light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0);
 
 // 获取法线贴图的法线
 vec3 getNormalFromMap()
 {
-    vec3 tangentNormal = texture(material.normalMap, fs_in.TexCoord).xyz * 2.0 - 1.0;
+    vec3 tangentNormal = UnpackNormalMap(texture(material.normalMap, fs_in.TexCoord));
     return normalize(fs_in.TBN * tangentNormal);
 }
 
@@ -157,18 +120,19 @@ vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
 }
 
 // 阴影计算
-float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap)
+float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap, vec4 shadowRect)
 {
     // 透视除法
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
     // 变换到[0,1]的范围
     projCoords = projCoords * 0.5 + 0.5;
 
-    if(projCoords.z > 1.0)
+    // 超出光源视锥的片段不在阴影中（图集中相邻图块属于其他光源）
+    if(projCoords.z > 1.0 || projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0)
         return 0.0;
 
-    // 获取最近点的深度值
-    float closestDepth = texture(shadowMap, projCoords.xy).r; 
+    // 获取最近点的深度值（映射到阴影图集中的图块）
+    float closestDepth = texture(shadowMap, shadowRect.xy + projCoords.xy * shadowRect.zw).r; 
     // 获取当前片段的深度值
     float currentDepth = projCoords.z;
 
@@ -180,18 +144,19 @@ float ShadowCalculation(vec4 fragPosLightSpace, sampler2D shadowMap)
 }
 
 // 计算方向光
-vec3 CalcDirLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0)
+vec3 CalcDirLight(LightData light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0)
 {
-    vec3 lightDir = normalize(-light.direction);
+    vec3 lightDir = normalize(-light.direction.xyz);
     vec3 halfwayDir = normalize(lightDir + viewDir);
     float NdotL = max(dot(normal, lightDir), 0.0);
     
     // 计算阴影
     float shadow = 0.0;
-    if (light.shadowEnabled && shadowEnabled) {
-        vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fs_in.FragPos, 1.0);
-        shadow = ShadowCalculation(fragPosLightSpace, light.shadowMap);
+#ifdef USE_SHADOWS
+    if (LightHasShadows(light)) {
+        shadow = CascadedShadow(shadowCascades, int(light.shadowRect.x), fs_in.FragPos, normal);
     }
+#endif
     
     // Cook-Torrance BRDF
     float NDF = DistributionGGX(normal, halfwayDir, roughness);
@@ -206,19 +171,19 @@ vec3 CalcDirLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 albedo
     float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * max(dot(normal, lightDir), 0.0) + 0.0001;
     vec3 specular = numerator / denominator;
     
-    vec3 radiance = light.color * light.intensity;
+    vec3 radiance = light.diffuse.rgb;
     
     return (kD * albedo / PI + specular) * radiance * NdotL * (1.0 - shadow);
 }
 
 // 计算点光源
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0)
+vec3 CalcPointLight(LightData light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0)
 {
-    vec3 lightDir = normalize(light.position - fs_in.FragPos);
+    vec3 lightDir = normalize(light.position.xyz - fs_in.FragPos);
     vec3 halfwayDir = normalize(lightDir + viewDir);
     
-    float distance = length(light.position - fs_in.FragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * distance * distance);
+    float distance = length(light.position.xyz - fs_in.FragPos);
+    float attenuation = LightAttenuation(light, distance);
     
     float NdotL = max(dot(normal, lightDir), 0.0);
     
@@ -235,32 +200,34 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 viewDir, vec3 albedo, fl
     float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * max(dot(normal, lightDir), 0.0) + 0.0001;
     vec3 specular = numerator / denominator;
     
-    vec3 radiance = light.color * light.intensity * attenuation;
+    vec3 radiance = light.diffuse.rgb * attenuation;
     
     return (kD * albedo / PI + specular) * radiance * NdotL;
 }
 
 // 计算聚光灯
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0)
+vec3 CalcSpotLight(LightData light, vec3 normal, vec3 viewDir, vec3 albedo, float metallic, float roughness, vec3 F0)
 {
-    vec3 lightDir = normalize(light.position - fs_in.FragPos);
+    vec3 lightDir = normalize(light.position.xyz - fs_in.FragPos);
     vec3 halfwayDir = normalize(lightDir + viewDir);
     
-    float distance = length(light.position - fs_in.FragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * distance * distance);
+    float distance = length(light.position.xyz - fs_in.FragPos);
+    float attenuation = LightAttenuation(light, distance);
     
-    float theta = dot(lightDir, normalize(-light.direction));
-    float epsilon = light.cutOff - light.outerCutOff;
-    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    float theta = dot(lightDir, normalize(-light.direction.xyz));
+    float epsilon = light.spot.x - light.spot.y;
+    float intensity = clamp((theta - light.spot.y) / epsilon, 0.0, 1.0);
     
     float NdotL = max(dot(normal, lightDir), 0.0);
     
     // 计算阴影
     float shadow = 0.0;
-    if (light.shadowEnabled && shadowEnabled) {
+#ifdef USE_SHADOWS
+    if (LightHasShadows(light)) {
         vec4 fragPosLightSpace = light.lightSpaceMatrix * vec4(fs_in.FragPos, 1.0);
-        shadow = ShadowCalculation(fragPosLightSpace, light.shadowMap);
+        shadow = ShadowCalculation(fragPosLightSpace, shadowAtlas, light.shadowRect);
     }
+#endif
     
     // Cook-Torrance BRDF
     float NDF = DistributionGGX(normal, halfwayDir, roughness);
@@ -275,7 +242,7 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 viewDir, vec3 albedo, floa
     float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * max(dot(normal, lightDir), 0.0) + 0.0001;
     vec3 specular = numerator / denominator;
     
-    vec3 radiance = light.color * light.intensity * attenuation * intensity;
+    vec3 radiance = light.diffuse.rgb * attenuation * intensity;
     
     return (kD * albedo / PI + specular) * radiance * NdotL * (1.0 - shadow);
 }
@@ -283,13 +250,33 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 viewDir, vec3 albedo, floa
 void main()
 {
     // 获取材质属性
-    vec3 albedo = material.useAlbedoMap ? texture(material.albedoMap, fs_in.TexCoord).rgb : material.albedo;
-    float metallic = material.useMetallicMap ? texture(material.metallicMap, fs_in.TexCoord).r : material.metallic;
-    float roughness = material.useRoughnessMap ? texture(material.roughnessMap, fs_in.TexCoord).r : material.roughness;
-    float ao = material.useAOMap ? texture(material.aoMap, fs_in.TexCoord).r : material.ao;
+#ifdef HAS_ALBEDO_MAP
+    vec3 albedo = texture(material.albedoMap, fs_in.TexCoord).rgb;
+#else
+    vec3 albedo = material.albedo;
+#endif
+#ifdef HAS_METALLIC_MAP
+    float metallic = texture(material.metallicMap, fs_in.TexCoord).r;
+#else
+    float metallic = material.metallic;
+#endif
+#ifdef HAS_ROUGHNESS_MAP
+    float roughness = texture(material.roughnessMap, fs_in.TexCoord).r;
+#else
+    float roughness = material.roughness;
+#endif
+#ifdef HAS_AO_MAP
+    float ao = texture(material.aoMap, fs_in.TexCoord).r;
+#else
+    float ao = material.ao;
+#endif
     
     // 获取法线
-    vec3 normal = material.useNormalMap ? getNormalFromMap() : normalize(fs_in.Normal);
+#ifdef HAS_NORMAL_MAP
+    vec3 normal = getNormalFromMap();
+#else
+    vec3 normal = normalize(fs_in.Normal);
+#endif
     
     vec3 viewDir = normalize(viewPos - fs_in.FragPos);
     
@@ -301,23 +288,37 @@ void main()
     vec3 Lo = vec3(0.0);
     
     // 方向光
-    for(int i = 0; i < numLights[0]; ++i) {
-        Lo += CalcDirLight(dirLights[i], normal, viewDir, albedo, metallic, roughness, F0);
+    for(int i = 0; i < lightCounts.x; ++i) {
+        Lo += CalcDirLight(lights[DirLightOffset() + i], normal, viewDir, albedo, metallic, roughness, F0);
     }
     
+#ifdef USE_CLUSTERED_LIGHTS
+    // 只遍历片段所在簇的点光源和聚光灯
+    uint cluster = ClusterIndex(gl_FragCoord.xy, fs_in.FragPos);
+    uint clusterLights = clusterLightCounts[cluster];
+    for(uint i = 0; i < clusterLights; ++i) {
+        int index = int(clusterLightIndices[cluster * MAX_LIGHTS_PER_CLUSTER + i]);
+        if (index >= SpotLightOffset())
+            Lo += CalcSpotLight(lights[index], normal, viewDir, albedo, metallic, roughness, F0);
+        else
+            Lo += CalcPointLight(lights[index], normal, viewDir, albedo, metallic, roughness, F0);
+    }
+#else
     // 点光源
-    for(int i = 0; i < numLights[1]; ++i) {
-        Lo += CalcPointLight(pointLights[i], normal, viewDir, albedo, metallic, roughness, F0);
+    for(int i = 0; i < lightCounts.y; ++i) {
+        Lo += CalcPointLight(lights[PointLightOffset() + i], normal, viewDir, albedo, metallic, roughness, F0);
     }
     
     // 聚光灯
-    for(int i = 0; i < numLights[2]; ++i) {
-        Lo += CalcSpotLight(spotLights[i], normal, viewDir, albedo, metallic, roughness, F0);
+    for(int i = 0; i < lightCounts.z; ++i) {
+        Lo += CalcSpotLight(lights[SpotLightOffset() + i], normal, viewDir, albedo, metallic, roughness, F0);
     }
+#endif
     
     // 环境光照 (IBL)
     vec3 ambient = vec3(0.03) * albedo * ao;
-    if (iblEnabled) {
+#ifdef USE_IBL
+    {
         vec3 F = fresnelSchlickRoughness(max(dot(normal, viewDir), 0.0), F0, roughness);
         
         vec3 kS = F;
@@ -334,6 +335,7 @@ void main()
         
         ambient = (kD * diffuse + specular) * ao;
     }
+#endif
     
     vec3 color = ambient + Lo;
     
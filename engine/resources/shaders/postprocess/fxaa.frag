@@ -1,16 +1,16 @@
-#version 430 core
+#version 460 core
+#include "../common/frame_data.glsl"
 in vec2 TexCoords;
 out vec4 FragColor;
 
 uniform sampler2D screenTexture;
-uniform vec2 resolution;
 
 #define FXAA_REDUCE_MIN (1.0/128.0)
 #define FXAA_REDUCE_MUL (1.0/8.0)
 #define FXAA_SPAN_MAX 8.0
 
 void main() {
-    vec2 invRes = 1.0 / resolution;
+    vec2 invRes = 1.0 / screenSize;
     
     // 当前像素颜色
     vec3 rgbNW = texture(screenTexture, TexCoords + vec2(-1.0, -1.0) * invRes).rgb;
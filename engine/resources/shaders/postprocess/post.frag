@@ -1,12 +1,10 @@
-#version 330 core
+#version 460 core
+#include "../common/frame_data.glsl"
 out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D scene;
 uniform sampler2D bloom;
-uniform bool hdrEnabled;
-uniform bool bloomEnabled;
-uniform bool gammaEnabled;
 uniform float exposure = 1.0;
 uniform float bloomIntensity = 1.0; // 新增
 
@@ -1,9 +1,11 @@
-#version 430 core
+#version 460 core
+#include "../common/frame_data.glsl"
+#include "../common/gbuffer.glsl"
 out float FragColor;
 in vec2 TexCoords;
 
-uniform sampler2D gPosition;
-uniform sampler2D gNormal;
+uniform sampler2D gDepth;          // G缓冲深度，重建视图空间位置
+uniform sampler2D gNormalMaterial; // 八面体编码的世界空间法线
 uniform sampler2D texNoise;
 
 uniform vec3 samples[64];
@@ -11,17 +13,14 @@ uniform int kernelSize;
 uniform float radius;
 uniform float bias;
 uniform float power;
-uniform mat4 view;
 
 
-uniform mat4 projection;
 uniform vec2 noiseScale;
 
 void main() {
     // 获取视图空间位置和法线
-    vec3 fragPos = texture(gPosition, TexCoords).xyz;
-    fragPos = vec3(view * vec4(fragPos, 1.0)); // 将位置转换到视图空间
-    vec3 normal = normalize(texture(gNormal, TexCoords).rgb);
+    vec3 fragPos = ViewPositionFromDepth(TexCoords, texture(gDepth, TexCoords).r);
+    vec3 normal = DecodeNormal(texture(gNormalMaterial, TexCoords).xy);
     normal = normalize(vec3(view * vec4(normal, 0.0))); // 将法线转换到视图空间
     
     // 重建TBN矩阵
@@ -44,7 +43,7 @@ void main() {
         offset.xyz = offset.xyz * 0.5 + 0.5; // 变换到0.0-1.0
         
         // 获取样本深度
-        float sampleDepth = -texture(gPosition, offset.xy).w;
+        float sampleDepth = ViewPositionFromDepth(offset.xy, texture(gDepth, offset.xy).r).z;
         
         // 范围检查
         float rangeCheck = smoothstep(0.0, 1.0, radius / abs(fragPos.z - sampleDepth));
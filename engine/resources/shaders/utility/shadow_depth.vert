@@ -1,10 +1,7 @@
 #version 460 core
 
+// 仅位置的顶点流（Mesh::DrawDepthOnly）
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
 
 uniform mat4 model;
 uniform mat4 lightSpaceMatrix;
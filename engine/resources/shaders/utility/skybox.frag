@@ -4,7 +4,7 @@ out vec4 FragColor;
 in vec3 WorldPos;
 
 uniform samplerCube skybox;
-uniform bool gammaEnabled;
+uniform bool backgroundGammaEnabled; // 背景贴图单独的gamma开关
 
 void main()
 {
@@ -15,7 +15,7 @@ void main()
     envColor = vec3(1.0) - exp(-envColor * exposure);
     
     // Gamma校正
-    if (gammaEnabled) {
+    if (backgroundGammaEnabled) {
         envColor = pow(envColor, vec3(1.0/2.2));
     }
     
@@ -1,11 +1,9 @@
-#version 430 core
+#version 460 core
+#include "../common/frame_data.glsl"
 layout (location = 0) in vec3 aPos;
 
 out vec3 WorldPos;
 
-uniform mat4 projection;
-uniform mat4 view;
-
 void main()
 {
     WorldPos = aPos;
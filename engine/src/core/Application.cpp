@@ -1,10 +1,16 @@
 #include "GLFW/glfw3.h"
 #include "core/Application.hpp"
+#include "core/JobSystem.hpp"
 #include "core/Light.hpp"
 #include "core/Material.hpp"
+#include "core/MeshCache.hpp"
+#include "core/ShaderCache.hpp"
+#include "core/TextureCache.hpp"
 #include "stb_image.h"
 #include "utils/FileSystem.hpp"
 #include "utils/Logger.hpp"
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
 // 静态成员变量定义
@@ -15,12 +21,40 @@ std::streambuf* Application::originalCoutBuffer = nullptr;
 std::streambuf* Application::originalCerrBuffer = nullptr;
 
 
-Application::Application()
+Application::Application(int argc, char **argv)
 {
+    launchTime = std::chrono::steady_clock::now();
+
     // 首先初始化控制台重定向，确保所有后续输出都被捕获
     InitializeConsoleRedirection();
-    
+
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--bench")
+        {
+            benchmarkScene = Benchmark::FindScene(argv[i + 1]);
+            if (!benchmarkScene)
+            {
+                std::cerr << "未知的基准测试场景: " << argv[i + 1] << "，可用场景:";
+                for (const auto &scene : Benchmark::GetScenes())
+                    std::cerr << " " << scene.name;
+                std::cerr << std::endl;
+            }
+        }
+        else if (std::string(argv[i]) == "--startup-report")
+        {
+            std::string mode = argv[i + 1];
+            startupReport = mode == "cold" ? StartupReport::COLD : StartupReport::WARM;
+        }
+    }
     Initialize();
+    initializeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launchTime).count();
+
+    if (benchmarkScene && renderer)
+    {
+        benchmark = std::make_unique<Benchmark>(*renderer, *benchmarkScene);
+        benchmark->Start();
+    }
 }
 
 Application::~Application()
@@ -56,7 +90,7 @@ void Application::Initialize()
     }
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(vsyncEnabled ? 1 : 0);
+    glfwSwapInterval(vsyncEnabled && !benchmarkScene ? 1 : 0);
 
     std::string iconPath = FileSystem::GetPath("resources/avatar.jpg");
     if (!FileSystem::FileExists(iconPath))
@@ -85,12 +119,28 @@ void Application::Initialize()
         return;
     }
 
+    // 着色器在驱动线程中并行编译（需要 GL_KHR_parallel_shader_compile）
+    Shader::InitializeParallelCompile(reinterpret_cast<void *(*)(const char *)>(glfwGetProcAddress));
+
+    // 启动作业系统（工作线程只做 CPU 计算，GL 调用留在主线程）
+    JobSystem::GetInstance().Initialize();
+
+    // 块压缩纹理缓存（需要 GL 上下文查询压缩格式支持）
+    TextureCache::GetInstance().Initialize("cache/textures");
+    // 处理后网格缓存，场景重新加载时跳过 Assimp
+    MeshCache::GetInstance().Initialize("cache/meshes");
+    // 着色器程序二进制缓存，第二次启动时跳过编译和链接
+    ShaderCache::GetInstance().Initialize("cache/shaders");
+    if (startupReport == StartupReport::COLD)
+        ShaderCache::GetInstance().Clear();
+
     // 初始化渲染器
     renderer = std::make_unique<Renderer>(width, height);
     renderer->Initialize();
 
-    // 创建测试场景
-    CreateTestScene();
+    // 创建测试场景（基准测试由 Benchmark 创建自己的场景）
+    if (!benchmarkScene)
+        CreateTestScene();
 
     // 初始化UI
     editorUI = std::make_unique<EditorUI>(window, renderer.get());
@@ -165,6 +215,21 @@ void Application::Run()
         Render();
 
         glfwPollEvents();
+
+        // 着色器全部可用后的第一帧才是完整画面
+        if (!startupReported && renderer->GetPendingShaderCount() == 0)
+        {
+            ReportStartup();
+            if (startupReport != StartupReport::NONE)
+                glfwSetWindowShouldClose(window, true);
+        }
+
+        if (benchmark && !benchmark->Step(deltaTime * 1000.0f))
+        {
+            benchmark->Report();
+            benchmark.reset();
+            glfwSetWindowShouldClose(window, true);
+        }
     }
 }
 
@@ -173,6 +238,10 @@ void Application::ProcessInput(float deltaTime)
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
 
+    // 基准测试期间相机固定
+    if (benchmark)
+        return;
+
     // 摄像机控制 - 只有在鼠标在视口内时才允许
     static bool rightMousePressed = false;
     if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS && editorUI->IsMouseInViewport())
@@ -207,14 +276,24 @@ void Application::ProcessInput(float deltaTime)
 void Application::Update(float deltaTime)
 {
     renderer->Update(deltaTime);
-    editorUI->Update(deltaTime);
+    if (!benchmark)
+        editorUI->Update(deltaTime);
 }
 
 void Application::Render()
 {
     renderer->BeginFrame();
     renderer->RenderScene();
-    editorUI->Render();
+    if (benchmark)
+    {
+        int framebufferWidth = 0, framebufferHeight = 0;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        renderer->PresentViewport(framebufferWidth, framebufferHeight);
+    }
+    else
+    {
+        editorUI->Render();
+    }
     renderer->EndFrame();
     glfwSwapBuffers(window);
     glfwPollEvents();
@@ -288,10 +367,7 @@ void Application::CreateTestScene()
         glm::vec3(1.0f, 1.0f, 1.0f),     // 镜面反射
         1.0f                             // 强度
     );
-    directionalLight->SetShadowEnabled(true);
-    directionalLight->shadowOrthoSize = 15.0f; // 调整阴影范围
-    directionalLight->shadowNearPlane = 0.1f;
-    directionalLight->shadowFarPlane = 50.0f;
+    directionalLight->SetShadowEnabled(true); // 级联阴影的范围由相机和渲染器的阴影距离决定
     renderer->AddLight(directionalLight);
 
     // 创建一个点光源并启用阴影
@@ -327,8 +403,45 @@ void Application::CreateTestScene()
     renderer->SetShadow(true);
 }
 
+void Application::ReportStartup()
+{
+    startupReported = true;
+
+    // 等 GPU 执行完第一帧，计入驱动在首次绘制时才做的着色器工作
+    glFinish();
+    double firstFrameMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launchTime).count();
+    const ShaderCache::Stats &cacheStats = ShaderCache::GetInstance().GetStats();
+    std::cout << "启动耗时: 初始化 " << initializeMs << " ms，着色器 " << renderer->GetShaderLoadMs()
+              << " ms，首帧完整画面 " << firstFrameMs << " ms（着色器缓存命中 " << cacheStats.hits << "，未命中 "
+              << cacheStats.misses << "，驱动拒绝 " << cacheStats.rejected << "）" << std::endl;
+
+    if (startupReport == StartupReport::NONE)
+        return;
+
+    // 每次运行追加一行，冷启动与热启动各运行一次即可比较
+    std::error_code error;
+    std::filesystem::create_directories("benchmarks/results", error);
+    std::string path = "benchmarks/results/startup.csv";
+    bool writeHeader = !std::filesystem::exists(path, error);
+    std::ofstream file(path, std::ios::app);
+    if (!file)
+    {
+        std::cerr << "启动耗时写入失败: " << path << std::endl;
+        return;
+    }
+    if (writeHeader)
+        file << "mode,initialize_ms,shader_ms,first_frame_ms,cache_hits,cache_misses,cache_rejected\n";
+    file << (startupReport == StartupReport::COLD ? "cold" : "warm") << "," << initializeMs << ","
+         << renderer->GetShaderLoadMs() << "," << firstFrameMs << "," << cacheStats.hits << "," << cacheStats.misses
+         << "," << cacheStats.rejected << "\n";
+    std::cout << "启动耗时已写入: " << path << std::endl;
+}
+
 void Application::Shutdown()
 {
+    // 先停止工作线程，保证没有作业再访问渲染器和场景数据
+    JobSystem::GetInstance().Shutdown();
     editorUI.reset();
     renderer.reset();
     glfwDestroyWindow(window);
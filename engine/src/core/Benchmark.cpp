@@ -0,0 +1,444 @@
+#include "core/Benchmark.hpp"
+#include "core/Renderer.hpp"
+#include "core/Texture.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace
+{
+void PlaceCamera(Renderer &renderer, const glm::vec3 &position, float yaw, float pitch)
+{
+    auto camera = renderer.GetCamera();
+    camera->Position = position;
+    camera->Yaw = yaw;
+    camera->Pitch = pitch;
+    camera->ProcessMouseMovement(0.0f, 0.0f); // 按欧拉角更新方向向量
+}
+
+// 程序生成的颜色贴图（高频噪声叠加棋盘格），带完整 mip 链，不依赖资源文件
+std::shared_ptr<Texture> CreateNoiseTexture(int size, unsigned int seed)
+{
+    TextureImage image;
+    image.path = "benchmark/noise_" + std::to_string(seed);
+    image.width = size;
+    image.height = size;
+    image.components = 4;
+    image.srgb = true;
+    image.pixels.resize(static_cast<size_t>(size) * size * 4);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(64, 255);
+    glm::vec3 tint(noise(rng) / 255.0f, noise(rng) / 255.0f, noise(rng) / 255.0f);
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            float checker = ((x / 64 + y / 64) & 1) ? 1.0f : 0.6f;
+            float value = checker * noise(rng);
+            unsigned char *pixel = &image.pixels[(static_cast<size_t>(y) * size + x) * 4];
+            pixel[0] = static_cast<unsigned char>(value * tint.r);
+            pixel[1] = static_cast<unsigned char>(value * tint.g);
+            pixel[2] = static_cast<unsigned char>(value * tint.b);
+            pixel[3] = 255;
+        }
+    }
+    Texture::BuildMipChain(image);
+
+    auto texture = std::make_shared<Texture>();
+    texture->Upload(image);
+    return texture;
+}
+
+// 贴图带宽场景：低机位掠射大片贴图地面和成排立方体，远处的贴图被大幅缩小，
+// 只采样第 0 级时纹理缓存命中率很低，对比 mip 与各向异性过滤的开销
+void BuildTextureScene(Renderer &renderer)
+{
+    renderer.SetShadow(false);
+    renderer.SetSSAO(false);
+    renderer.SetBloom(false);
+    renderer.SetIBL(false);
+
+    const int textureCount = 8;
+    std::vector<std::shared_ptr<Texture>> textures;
+    for (int i = 0; i < textureCount; ++i)
+        textures.push_back(CreateNoiseTexture(2048, 1234u + i));
+
+    auto texturedMaterial = [&](int index) {
+        Material material;
+        material.diffuse = glm::vec3(1.0f);
+        material.diffuseMap = textures[index % textureCount];
+        material.useDiffuseMap = true;
+        return material;
+    };
+
+    const float tile = 2.5f;
+    for (int z = -20; z < 20; ++z)
+    {
+        for (int x = -20; x < 20; ++x)
+        {
+            renderer.CreatePrimitive(Geometry::Type::CUBE,
+                                     glm::vec3((x + 0.5f) * tile, -0.05f, (z + 0.5f) * tile),
+                                     glm::vec3(tile, 0.1f, tile), glm::vec3(0.0f), texturedMaterial(x + z + 40));
+        }
+    }
+    for (int z = -10; z < 10; ++z)
+    {
+        for (int x = -10; x < 10; ++x)
+        {
+            renderer.CreatePrimitive(Geometry::Type::CUBE, glm::vec3(x * 5.0f + 2.5f, 0.5f, z * 5.0f + 2.5f),
+                                     glm::vec3(1.0f), glm::vec3(0.0f, static_cast<float>((x * 37 + z * 11) % 90), 0.0f),
+                                     texturedMaterial(x * 3 + z + 40));
+        }
+    }
+
+    renderer.AddLight(std::make_shared<DirectionalLight>(glm::vec3(-0.4f, -1.0f, -0.3f), glm::vec3(0.3f),
+                                                         glm::vec3(1.0f), glm::vec3(0.2f), 1.0f));
+    PlaceCamera(renderer, glm::vec3(0.0f, 1.7f, 48.0f), -90.0f, -6.0f);
+}
+
+// 着色填充率场景：PBR 立方体墙铺满画面，前方散布 32 个点光源和一个投射级联阴影的方向光；
+// 材质不使用贴图，按需变体中不含任何贴图路径
+void BuildShadingScene(Renderer &renderer)
+{
+    renderer.SetShadow(true);
+    renderer.SetSSAO(true);
+    renderer.SetBloom(false);
+    renderer.SetIBL(false);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int y = -5; y < 5; ++y)
+    {
+        for (int x = -8; x < 8; ++x)
+        {
+            Material material(PBR);
+            material.albedo = glm::vec3(0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng));
+            material.metallic = unit(rng);
+            material.roughness = 0.2f + 0.8f * unit(rng);
+            renderer.CreatePrimitive(Geometry::Type::CUBE, glm::vec3(x * 2.0f + 1.0f, y * 2.0f + 1.0f, 0.0f),
+                                     glm::vec3(2.0f, 2.0f, 0.5f), glm::vec3(0.0f), material);
+        }
+    }
+    for (int i = 0; i < 24; ++i)
+    {
+        Material material(PBR);
+        material.albedo = glm::vec3(0.9f);
+        material.metallic = 0.0f;
+        material.roughness = 0.4f;
+        renderer.CreatePrimitive(Geometry::Type::SPHERE,
+                                 glm::vec3((i % 6) * 3.0f - 7.5f, (i / 6) * 2.5f - 3.75f, 2.0f), glm::vec3(0.8f),
+                                 glm::vec3(0.0f), material);
+    }
+
+    auto sun = std::make_shared<DirectionalLight>(glm::vec3(-0.3f, -0.5f, -1.0f), glm::vec3(0.1f), glm::vec3(0.8f),
+                                                  glm::vec3(0.5f), 1.0f);
+    sun->SetShadowEnabled(true);
+    renderer.AddLight(sun);
+    for (int i = 0; i < 32; ++i)
+    {
+        glm::vec3 color(0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng));
+        glm::vec3 position((unit(rng) - 0.5f) * 16.0f, (unit(rng) - 0.5f) * 10.0f, 1.0f + unit(rng) * 3.0f);
+        renderer.AddLight(std::make_shared<PointLight>(position, glm::vec3(0.0f), color, color, 1.0f));
+    }
+    PlaceCamera(renderer, glm::vec3(0.0f, 0.0f, 14.0f), -90.0f, 0.0f);
+}
+
+// 多光源场景：60x60 的 PBR 地面和立柱上方散布 1024 个短距离点光源（影响半径约 5~7），
+// 关闭阴影与后处理，帧时间主要取决于逐光源着色的开销
+void BuildManyLightsScene(Renderer &renderer)
+{
+    renderer.SetShadow(false);
+    renderer.SetSSAO(false);
+    renderer.SetBloom(false);
+    renderer.SetIBL(false);
+    renderer.SetLightsEnabled(false); // 不绘制光源标记
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int z = -10; z < 10; ++z)
+    {
+        for (int x = -10; x < 10; ++x)
+        {
+            Material material(PBR);
+            material.albedo = glm::vec3(0.6f + 0.2f * unit(rng));
+            material.metallic = 0.0f;
+            material.roughness = 0.5f + 0.4f * unit(rng);
+            renderer.CreatePrimitive(Geometry::Type::CUBE, glm::vec3(x * 3.0f + 1.5f, -0.05f, z * 3.0f + 1.5f),
+                                     glm::vec3(3.0f, 0.1f, 3.0f), glm::vec3(0.0f), material);
+            if ((x + z) % 3 == 0)
+            {
+                material.metallic = unit(rng);
+                renderer.CreatePrimitive(Geometry::Type::CUBE, glm::vec3(x * 3.0f + 1.5f, 1.5f, z * 3.0f + 1.5f),
+                                         glm::vec3(0.6f, 3.0f, 0.6f), glm::vec3(0.0f), material);
+            }
+        }
+    }
+
+    const int lightCount = 1024;
+    for (int i = 0; i < lightCount; ++i)
+    {
+        glm::vec3 color(0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng));
+        glm::vec3 position((unit(rng) - 0.5f) * 60.0f, 0.3f + unit(rng) * 2.5f, (unit(rng) - 0.5f) * 60.0f);
+        auto light = std::make_shared<PointLight>(position, glm::vec3(0.0f), color, color, 1.0f);
+        light->linear = 0.7f;
+        light->quadratic = 1.8f;
+        renderer.AddLight(light);
+    }
+    PlaceCamera(renderer, glm::vec3(0.0f, 14.0f, 38.0f), -90.0f, -28.0f);
+}
+
+// G 缓冲带宽：着色场景关闭阴影和 SSAO，只剩几何阶段写 G 缓冲和光照阶段读 G 缓冲，按分辨率比较两者的 GPU 时间
+Benchmark::Config GBufferConfig(const char *name, Renderer::RenderMode mode, int width, int height)
+{
+    Benchmark::Config config;
+    config.name = name;
+    config.width = width;
+    config.height = height;
+    config.apply = [mode](Renderer &renderer) {
+        renderer.SetRenderMode(mode);
+        renderer.SetShadow(false);
+        renderer.SetSSAO(false);
+    };
+    return config;
+}
+
+void UseForward(Renderer &renderer)
+{
+    renderer.SetRenderMode(Renderer::FORWARD);
+}
+
+// 着色器变体对比：按需变体 / 全部特性变体（改用变体之前的单一着色器的近似），分别测前向 PBR 和延迟光照
+Benchmark::Config ShadingConfig(const char *name, Renderer::RenderMode mode, bool permutations)
+{
+    Benchmark::Config config;
+    config.name = name;
+    config.width = 2560;
+    config.height = 1440;
+    config.apply = [mode, permutations](Renderer &renderer) {
+        renderer.SetRenderMode(mode);
+        renderer.SetShaderPermutations(permutations);
+    };
+    return config;
+}
+} // namespace
+
+const std::vector<Benchmark::Scene> &Benchmark::GetScenes()
+{
+    static const std::vector<Scene> scenes = {
+        {"textures",
+         "贴图带宽：只采样第 0 级（旧路径）/ 三线性 / 三线性 + 16x 各向异性，比较前向阶段 GPU 时间",
+         BuildTextureScene,
+         {
+             {"level0", [](Renderer &r) { UseForward(r); Texture::SetMaterialSamplerFiltering(false, 1.0f); }},
+             {"trilinear", [](Renderer &r) { UseForward(r); Texture::SetMaterialSamplerFiltering(true, 1.0f); }},
+             {"trilinear_aniso16",
+              [](Renderer &r) { UseForward(r); Texture::SetMaterialSamplerFiltering(true, 16.0f); }},
+         }},
+        {"shader_permutations",
+         "着色器变体：pbr.frag（前向）与 lighting_pass.frag（延迟）的按需变体对比全部特性变体，2560x1440",
+         BuildShadingScene,
+         {
+             ShadingConfig("forward_variants", Renderer::FORWARD, true),
+             ShadingConfig("forward_all_features", Renderer::FORWARD, false),
+             ShadingConfig("deferred_variants", Renderer::DEFERRED, true),
+             ShadingConfig("deferred_all_features", Renderer::DEFERRED, false),
+         }},
+        {"gbuffer",
+         "G 缓冲带宽：延迟与分块延迟在 1080p / 1440p / 2160p 下的 GBuffer 与 Lighting 阶段 GPU 时间",
+         BuildShadingScene,
+         {
+             GBufferConfig("deferred_1080p", Renderer::DEFERRED, 1920, 1080),
+             GBufferConfig("deferred_1440p", Renderer::DEFERRED, 2560, 1440),
+             GBufferConfig("deferred_2160p", Renderer::DEFERRED, 3840, 2160),
+             GBufferConfig("tiled_deferred_1080p", Renderer::TILED_DEFERRED, 1920, 1080),
+             GBufferConfig("tiled_deferred_1440p", Renderer::TILED_DEFERRED, 2560, 1440),
+             GBufferConfig("tiled_deferred_2160p", Renderer::TILED_DEFERRED, 3840, 2160),
+         }},
+        {"many_lights",
+         "多光源：1024 个点光源，延迟光体积 / 分块延迟（计算着色器）/ 分簇前向 / 不分簇前向",
+         BuildManyLightsScene,
+         {
+             {"deferred", [](Renderer &r) { r.SetRenderMode(Renderer::DEFERRED); }},
+             {"tiled_deferred", [](Renderer &r) { r.SetRenderMode(Renderer::TILED_DEFERRED); }},
+             {"forward_clustered",
+              [](Renderer &r) {
+                  UseForward(r);
+                  r.SetClusteredLighting(true);
+              }},
+             {"forward_unclustered",
+              [](Renderer &r) {
+                  UseForward(r);
+                  r.SetClusteredLighting(false);
+              }},
+         }},
+    };
+    return scenes;
+}
+
+const Benchmark::Scene *Benchmark::FindScene(const std::string &name)
+{
+    for (const Scene &scene : GetScenes())
+    {
+        if (scene.name == name)
+            return &scene;
+    }
+    return nullptr;
+}
+
+Benchmark::Benchmark(Renderer &renderer, const Scene &scene, int warmupFrames, int measureFrames)
+    : renderer(renderer), scene(scene), warmupFrames(warmupFrames), measureFrames(measureFrames)
+{
+}
+
+void Benchmark::Start()
+{
+    std::cout << "基准测试: " << scene.name << " - " << scene.description << std::endl;
+    scene.build(renderer);
+    ApplyConfig(0);
+}
+
+void Benchmark::ApplyConfig(size_t index)
+{
+    const Config &config = scene.configs[index];
+    configIndex = index;
+    frameInConfig = 0;
+
+    renderer.Resize(config.width, config.height);
+    if (config.apply)
+        config.apply(renderer);
+
+    Result result;
+    result.config = config.name;
+    result.width = config.width;
+    result.height = config.height;
+    if (renderer.GetRenderMode() != Renderer::FORWARD)
+        result.gBufferBytesPerPixel = renderer.GetGBufferBytesPerPixel();
+    results.push_back(result);
+    std::cout << "基准测试配置: " << config.name << " (" << config.width << "x" << config.height << ")" << std::endl;
+}
+
+bool Benchmark::Step(float cpuFrameMs)
+{
+    if (configIndex >= scene.configs.size())
+        return false;
+
+    // 着色器编译和异步加载完成之前不计入预热
+    if (renderer.GetPendingShaderCount() > 0 || renderer.GetPendingModelLoadCount() > 0)
+        return true;
+
+    const GpuTimer &timer = renderer.GetGpuTimer();
+    ++frameInConfig;
+    if (frameInConfig <= warmupFrames)
+    {
+        // GPU 结果延迟几帧读回，预热期间读回的仍可能属于上一个配置
+        lastResolvedFrame = timer.GetResolvedFrameCount();
+        return true;
+    }
+
+    Result &result = results.back();
+    ++result.frames;
+    result.cpuMs += cpuFrameMs;
+    if (timer.GetResolvedFrameCount() != lastResolvedFrame)
+    {
+        lastResolvedFrame = timer.GetResolvedFrameCount();
+        ++result.gpuFrames;
+        result.gpuFrameMs += timer.GetFrameMs();
+        for (const GpuTimer::Section &section : timer.GetSections())
+        {
+            auto it = std::find(result.sectionNames.begin(), result.sectionNames.end(), section.name);
+            if (it == result.sectionNames.end())
+            {
+                result.sectionNames.push_back(section.name);
+                result.sectionMs.push_back(section.lastMs);
+            }
+            else
+            {
+                result.sectionMs[it - result.sectionNames.begin()] += section.lastMs;
+            }
+        }
+    }
+
+    if (frameInConfig < warmupFrames + measureFrames)
+        return true;
+
+    if (configIndex + 1 >= scene.configs.size())
+    {
+        configIndex = scene.configs.size();
+        return false;
+    }
+    ApplyConfig(configIndex + 1);
+    return true;
+}
+
+void Benchmark::Report() const
+{
+    // 所有配置中出现过的阶段，按出现顺序作为列
+    std::vector<std::string> columns;
+    for (const Result &result : results)
+    {
+        for (const std::string &name : result.sectionNames)
+        {
+            if (std::find(columns.begin(), columns.end(), name) == columns.end())
+                columns.push_back(name);
+        }
+    }
+
+    auto average = [](double total, int count) { return count > 0 ? total / count : 0.0; };
+    auto sectionAverage = [&](const Result &result, const std::string &name) {
+        auto it = std::find(result.sectionNames.begin(), result.sectionNames.end(), name);
+        if (it == result.sectionNames.end())
+            return 0.0;
+        return average(result.sectionMs[it - result.sectionNames.begin()], result.gpuFrames);
+    };
+    // 每帧写入 G 缓冲的数据量
+    auto gBufferMb = [](const Result &result) {
+        return static_cast<double>(result.gBufferBytesPerPixel) * result.width * result.height / 1.0e6;
+    };
+
+    std::cout << "基准测试结果: " << scene.name << "（每帧平均毫秒）" << std::endl;
+    std::cout << std::left << std::setw(22) << "config" << std::setw(12) << "resolution" << std::setw(10) << "frame"
+              << std::setw(10) << "gpu" << std::setw(10) << "gbuf MB";
+    for (const std::string &name : columns)
+        std::cout << std::setw(12) << name;
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const Result &result : results)
+    {
+        std::cout << std::setw(22) << result.config << std::setw(12)
+                  << (std::to_string(result.width) + "x" + std::to_string(result.height)) << std::setw(10)
+                  << average(result.cpuMs, result.frames) << std::setw(10) << average(result.gpuFrameMs, result.gpuFrames)
+                  << std::setw(10) << gBufferMb(result);
+        for (const std::string &name : columns)
+            std::cout << std::setw(12) << sectionAverage(result, name);
+        std::cout << std::endl;
+    }
+    std::cout << std::defaultfloat;
+
+    std::error_code error;
+    std::filesystem::create_directories("benchmarks/results", error);
+    std::string path = "benchmarks/results/" + scene.name + ".csv";
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "基准测试结果写入失败: " << path << std::endl;
+        return;
+    }
+    file << "config,width,height,frames,frame_ms,gpu_frame_ms,gbuffer_bytes_per_pixel,gbuffer_mb";
+    for (const std::string &name : columns)
+        file << "," << name << "_ms";
+    file << "\n";
+    for (const Result &result : results)
+    {
+        file << result.config << "," << result.width << "," << result.height << "," << result.frames << ","
+             << average(result.cpuMs, result.frames) << "," << average(result.gpuFrameMs, result.gpuFrames) << ","
+             << result.gBufferBytesPerPixel << "," << gBufferMb(result);
+        for (const std::string &name : columns)
+            file << "," << sectionAverage(result, name);
+        file << "\n";
+    }
+    std::cout << "基准测试结果已写入: " << path << std::endl;
+}
@@ -0,0 +1,110 @@
+#include "core/Bounds.hpp"
+#include "core/Mesh.hpp"
+#include <algorithm>
+#include <cmath>
+
+AABB AABB::Transform(const glm::mat4 &matrix) const
+{
+    if (!IsValid())
+        return *this;
+
+    // 中心 + 半长的形式：新半长 = |M| * 半长，避免变换 8 个角点
+    glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+    glm::vec3 extents = GetExtents();
+    glm::vec3 newExtents(0.0f);
+    for (int col = 0; col < 3; ++col)
+    {
+        newExtents += glm::abs(glm::vec3(matrix[col])) * extents[col];
+    }
+
+    AABB result;
+    result.min = center - newExtents;
+    result.max = center + newExtents;
+    return result;
+}
+
+BoundingSphere BoundingSphere::Transform(const glm::mat4 &matrix) const
+{
+    float scaleX = glm::length(glm::vec3(matrix[0]));
+    float scaleY = glm::length(glm::vec3(matrix[1]));
+    float scaleZ = glm::length(glm::vec3(matrix[2]));
+
+    BoundingSphere result;
+    result.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+    result.radius = radius * std::max({scaleX, scaleY, scaleZ});
+    return result;
+}
+
+AABB ComputeBounds(const std::vector<Vertex> &vertices)
+{
+    AABB bounds;
+    for (const auto &vertex : vertices)
+    {
+        bounds.Expand(vertex.Position);
+    }
+    return bounds;
+}
+
+BoundingSphere ComputeBoundingSphere(const std::vector<Vertex> &vertices, const AABB &bounds)
+{
+    BoundingSphere sphere;
+    if (!bounds.IsValid())
+        return sphere;
+
+    sphere.center = bounds.GetCenter();
+    float maxDistance2 = 0.0f;
+    for (const auto &vertex : vertices)
+    {
+        glm::vec3 offset = vertex.Position - sphere.center;
+        maxDistance2 = std::max(maxDistance2, glm::dot(offset, offset));
+    }
+    sphere.radius = std::sqrt(maxDistance2);
+    return sphere;
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4 &viewProj)
+{
+    // glm 为列主序，row(i) = (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&viewProj](int i) {
+        return glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    };
+
+    Frustum frustum;
+    frustum.planes[0] = row(3) + row(0); // 左
+    frustum.planes[1] = row(3) - row(0); // 右
+    frustum.planes[2] = row(3) + row(1); // 下
+    frustum.planes[3] = row(3) - row(1); // 上
+    frustum.planes[4] = row(3) + row(2); // 近（OpenGL 裁剪空间 z ∈ [-w, w]）
+    frustum.planes[5] = row(3) - row(2); // 远
+
+    for (auto &plane : frustum.planes)
+    {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f)
+            plane /= length;
+    }
+    return frustum;
+}
+
+bool Frustum::Intersects(const AABB &bounds) const
+{
+    for (const auto &plane : planes)
+    {
+        // 取法线方向上最远的角点（正顶点），它在平面外侧则整个包围盒在外侧
+        glm::vec3 positive(plane.x >= 0.0f ? bounds.max.x : bounds.min.x, plane.y >= 0.0f ? bounds.max.y : bounds.min.y,
+                           plane.z >= 0.0f ? bounds.max.z : bounds.min.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const BoundingSphere &sphere) const
+{
+    for (const auto &plane : planes)
+    {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,232 @@
+#include "core/CascadedShadowMap.hpp"
+#include "core/Camera.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+
+CascadedShadowMap::CascadedShadowMap(int resolution, int cascadeCount)
+    : resolution(resolution), cascadeCount(std::clamp(cascadeCount, MIN_CASCADES, MAX_CASCADES))
+{
+    for (auto &center : sphereCenters)
+        center = glm::vec3(0.0f);
+
+    glGenFramebuffers(1, &framebuffer);
+    Allocate(1);
+    uniformBuffer = std::make_unique<UniformBuffer>(sizeof(GpuData), SHADOW_CASCADES_BINDING);
+}
+
+CascadedShadowMap::~CascadedShadowMap()
+{
+    if (depthTexture)
+        glDeleteTextures(1, &depthTexture);
+    if (framebuffer)
+        glDeleteFramebuffers(1, &framebuffer);
+}
+
+void CascadedShadowMap::UpdateSplits(const Camera &camera, float aspect)
+{
+    float nearPlane = camera.GetNearPlane();
+    float farPlane = std::max(std::min(camera.GetFarPlane(), shadowDistance), nearPlane + 1.0f);
+
+    // 视锥角点相对视轴的斜率平方：深度 d 处角点到视轴的距离为 d * sqrt(k)
+    float tanHalfFov = std::tan(glm::radians(camera.GetFov()) * 0.5f);
+    float k = tanHalfFov * tanHalfFov * (1.0f + aspect * aspect);
+
+    float sliceNear = nearPlane;
+    for (int i = 0; i < cascadeCount; ++i)
+    {
+        // 实用分割：对数分割保证近处分辨率，均匀分割避免远处级联过长
+        float p = static_cast<float>(i + 1) / cascadeCount;
+        float logSplit = nearPlane * std::pow(farPlane / nearPlane, p);
+        float uniformSplit = nearPlane + (farPlane - nearPlane) * p;
+        float sliceFar = glm::mix(uniformSplit, logSplit, splitLambda);
+
+        // 包围球球心在视轴上，与切片近端和远端角点等距；球只取决于相机参数，相机旋转时大小不变
+        float z = std::min(0.5f * (sliceNear + sliceFar) * (1.0f + k), sliceFar);
+        float radius = std::max(std::sqrt((z - sliceNear) * (z - sliceNear) + sliceNear * sliceNear * k),
+                                std::sqrt((sliceFar - z) * (sliceFar - z) + sliceFar * sliceFar * k));
+        // 量化半径，消除浮点误差带来的投影尺寸抖动
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        sphereCenters[i] = camera.Position + glm::normalize(camera.Front) * z;
+        sphereRadii[i] = radius;
+        gpuData.splits[i] = sliceFar;
+        gpuData.texelSizes[i] = 2.0f * radius / resolution;
+        sliceNear = sliceFar;
+    }
+    for (int i = cascadeCount; i < MAX_CASCADES; ++i)
+    {
+        gpuData.splits[i] = farPlane;
+        gpuData.texelSizes[i] = 0.0f;
+    }
+    gpuData.cascadeCount = cascadeCount;
+    gpuData.blendRange = blendRange;
+}
+
+int CascadedShadowMap::Acquire(const Light *light)
+{
+    auto it = slots.find(light);
+    if (it != slots.end())
+        return it->second;
+
+    auto free = std::find(slotUsed.begin(), slotUsed.end(), false);
+    if (free == slotUsed.end())
+    {
+        std::cerr << "CascadedShadowMap: more than " << MAX_LIGHTS << " directional lights cast shadows" << std::endl;
+        return -1;
+    }
+
+    int slot = static_cast<int>(free - slotUsed.begin());
+    if (slot >= lightCapacity)
+        Allocate(std::min(std::max(lightCapacity * 2, slot + 1), static_cast<int>(MAX_LIGHTS)));
+
+    slotUsed[slot] = true;
+    for (auto &state : states[slot])
+        state.dirty = true;
+    slots.emplace(light, slot);
+    return slot;
+}
+
+void CascadedShadowMap::ReleaseUnused(const std::unordered_set<const Light *> &alive)
+{
+    for (auto it = slots.begin(); it != slots.end();)
+    {
+        if (alive.count(it->first) == 0)
+        {
+            slotUsed[it->second] = false;
+            it = slots.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void CascadedShadowMap::ReleaseAll()
+{
+    slots.clear();
+    std::fill(slotUsed.begin(), slotUsed.end(), false);
+}
+
+glm::mat4 CascadedShadowMap::ComputeMatrix(int slot, const glm::vec3 &direction, int cascade, const AABB &sceneBounds)
+{
+    // 光源视图只包含旋转，平移放进正交投影的范围里，便于按纹素对齐
+    glm::vec3 dir = glm::normalize(direction);
+    glm::vec3 up = std::abs(dir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), dir, up);
+
+    float radius = sphereRadii[cascade];
+    float texel = 2.0f * radius / resolution;
+    glm::vec3 center = glm::vec3(lightView * glm::vec4(sphereCenters[cascade], 1.0f));
+    center = glm::floor(center / texel) * texel;
+
+    // 光源视图看向 -z，z 越大越靠近光源；朝光源一侧延伸到包住所有投射体
+    float minZ = center.z - radius;
+    float maxZ = center.z + radius;
+    if (sceneBounds.IsValid())
+    {
+        AABB lightBounds = sceneBounds.Transform(lightView);
+        maxZ = std::max(maxZ, std::ceil(lightBounds.max.z));
+    }
+
+    glm::mat4 projection =
+        glm::ortho(center.x - radius, center.x + radius, center.y - radius, center.y + radius, -maxZ, -minZ);
+    glm::mat4 matrix = projection * lightView;
+
+    states[slot][cascade].matrix = matrix;
+    gpuData.matrices[slot * MAX_CASCADES + cascade] = matrix;
+    return matrix;
+}
+
+bool CascadedShadowMap::NeedsRedraw(int slot, int cascade, size_t casterSignature) const
+{
+    const CascadeState &state = states[slot][cascade];
+    return state.dirty || state.rendered != state.matrix || state.casterSignature != casterSignature;
+}
+
+void CascadedShadowMap::BeginCascade(int slot, int cascade) const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, GetLayer(slot, cascade));
+    glViewport(0, 0, resolution, resolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void CascadedShadowMap::EndCascade(int slot, int cascade, size_t casterSignature)
+{
+    CascadeState &state = states[slot][cascade];
+    state.rendered = state.matrix;
+    state.casterSignature = casterSignature;
+    state.dirty = false;
+}
+
+void CascadedShadowMap::Upload()
+{
+    uniformBuffer->Update(&gpuData, sizeof(GpuData));
+}
+
+void CascadedShadowMap::Invalidate()
+{
+    for (auto &light : states)
+        for (auto &state : light)
+            state.dirty = true;
+}
+
+void CascadedShadowMap::SetResolution(int value)
+{
+    if (value == resolution || value <= 0)
+        return;
+    resolution = value;
+    Allocate(lightCapacity);
+}
+
+void CascadedShadowMap::SetCascadeCount(int count)
+{
+    count = std::clamp(count, MIN_CASCADES, MAX_CASCADES);
+    if (count == cascadeCount)
+        return;
+    cascadeCount = count;
+    Allocate(lightCapacity);
+}
+
+void CascadedShadowMap::Allocate(int capacity)
+{
+    if (depthTexture)
+        glDeleteTextures(1, &depthTexture);
+
+    // 可能在渲染过程中（Acquire 扩容）调用，结束时恢复调用者的帧缓冲和纹理绑定
+    GLint prevDrawFramebuffer, prevReadFramebuffer, prevTexture;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFramebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFramebuffer);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D_ARRAY, &prevTexture);
+
+    lightCapacity = capacity;
+    glGenTextures(1, &depthTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depthTexture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution, lightCapacity * cascadeCount, 0,
+                 GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+
+    // 只有深度附件，没有颜色输出
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "CascadedShadowMap: framebuffer is not complete" << std::endl;
+    }
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFramebuffer);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, prevTexture);
+
+    // 纹理重建后内容丢失，所有级联需要重绘
+    Invalidate();
+}
@@ -1,4 +1,5 @@
 #include "core/Framebuffer.hpp"
+#include <algorithm>
 #include <iostream>
 
 Framebuffer::Framebuffer(int width, int height) : width(width), height(height)
@@ -83,6 +84,26 @@ void Framebuffer::AddDepthTexture()
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
 
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    depthTextureHasStencil = false;
+}
+
+void Framebuffer::AddDepthStencilTexture()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, ID);
+
+    glGenTextures(1, &depthTexture);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8,
+                 nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // 采样时读取深度分量
+    glTexParameteri(GL_TEXTURE_2D, GL_DEPTH_STENCIL_TEXTURE_MODE, GL_DEPTH_COMPONENT);
+
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    depthTextureHasStencil = true;
 }
 
 void Framebuffer::AddDepthBuffer()
@@ -162,6 +183,44 @@ unsigned int Framebuffer::GetColorTexture(unsigned int index) const
     return (index < colorTextures.size()) ? colorTextures[index] : 0;
 }
 
+int Framebuffer::GetBytesPerPixel() const
+{
+    auto formatBytes = [](GLint internalFormat) {
+        switch (internalFormat)
+        {
+        case GL_RED:
+        case GL_R8:
+            return 1;
+        case GL_R16F:
+            return 2;
+        case GL_RGB:
+        case GL_RGB8:
+            return 3;
+        case GL_RGB16F:
+            return 6;
+        case GL_RGBA16F:
+        case GL_RG32F:
+            return 8;
+        case GL_RGB32F:
+            return 12;
+        case GL_RGBA32F:
+            return 16;
+        default: // RGBA8、R32F、RG16F、R11F_G11F_B10F 等
+            return 4;
+        }
+    };
+
+    int bytes = 0;
+    for (size_t i = 0; i < colorFormats.size(); ++i)
+        bytes += formatBytes(std::get<0>(colorFormats[i])) * std::max(colorSamples[i], 1);
+    // 深度纹理和深度渲染缓冲均为 D24S8 或 32 位深度
+    if (depthTexture != 0)
+        bytes += 4;
+    if (depthBuffer != 0)
+        bytes += 4 * std::max(lastSamples, 1);
+    return bytes;
+}
+
 void Framebuffer::Resize(int newWidth, int newHeight)
 {
     width = newWidth;
@@ -203,7 +262,12 @@ void Framebuffer::Resize(int newWidth, int newHeight)
 
     // 重建深度附件（根据之前是否存在决定）
     if (hadDepthTex)
-        AddDepthTexture();
+    {
+        if (depthTextureHasStencil)
+            AddDepthStencilTexture();
+        else
+            AddDepthTexture();
+    }
     if (hadDepthBuf)
     {
         if (lastSamples > 1)
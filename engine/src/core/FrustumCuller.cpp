@@ -0,0 +1,144 @@
+#include "core/FrustumCuller.hpp"
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULLER_AVX 1
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLER_SSE 1
+#endif
+
+namespace
+{
+// 一个平面对应的正顶点分量来源：法线分量非负时取 max，否则取 min
+struct PlaneInput
+{
+    const float *x;
+    const float *y;
+    const float *z;
+    glm::vec4 plane;
+};
+
+#if defined(FRUSTUM_CULLER_SSE)
+// 4 个包围盒中在某个平面外侧的掩码
+inline __m128 OutsideMask4(const PlaneInput &input, size_t offset)
+{
+    __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(input.plane.x), _mm_loadu_ps(input.x + offset)),
+                          _mm_mul_ps(_mm_set1_ps(input.plane.y), _mm_loadu_ps(input.y + offset)));
+    d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(input.plane.z), _mm_loadu_ps(input.z + offset)));
+    d = _mm_add_ps(d, _mm_set1_ps(input.plane.w));
+    return _mm_cmplt_ps(d, _mm_setzero_ps());
+}
+#endif
+
+// 返回 8 个包围盒的外侧位掩码，第 i 位为 1 表示第 i 个包围盒在视锥外
+inline unsigned int CullBatch(const PlaneInput (&inputs)[6], size_t offset)
+{
+#if defined(FRUSTUM_CULLER_AVX)
+    __m256 outside = _mm256_setzero_ps();
+    for (const auto &input : inputs)
+    {
+        __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(input.plane.x), _mm256_loadu_ps(input.x + offset)),
+                                 _mm256_mul_ps(_mm256_set1_ps(input.plane.y), _mm256_loadu_ps(input.y + offset)));
+        d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(input.plane.z), _mm256_loadu_ps(input.z + offset)));
+        d = _mm256_add_ps(d, _mm256_set1_ps(input.plane.w));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+    return static_cast<unsigned int>(_mm256_movemask_ps(outside));
+#elif defined(FRUSTUM_CULLER_SSE)
+    __m128 outsideLo = _mm_setzero_ps();
+    __m128 outsideHi = _mm_setzero_ps();
+    for (const auto &input : inputs)
+    {
+        outsideLo = _mm_or_ps(outsideLo, OutsideMask4(input, offset));
+        outsideHi = _mm_or_ps(outsideHi, OutsideMask4(input, offset + 4));
+    }
+    return static_cast<unsigned int>(_mm_movemask_ps(outsideLo) | (_mm_movemask_ps(outsideHi) << 4));
+#else
+    unsigned int mask = 0;
+    for (size_t lane = 0; lane < FrustumCuller::BATCH_SIZE; ++lane)
+    {
+        for (const auto &input : inputs)
+        {
+            size_t i = offset + lane;
+            float d = input.plane.x * input.x[i] + input.plane.y * input.y[i] + input.plane.z * input.z[i] +
+                      input.plane.w;
+            if (d < 0.0f)
+            {
+                mask |= 1u << lane;
+                break;
+            }
+        }
+    }
+    return mask;
+#endif
+}
+} // namespace
+
+void FrustumCuller::Clear()
+{
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+    count = 0;
+}
+
+size_t FrustumCuller::Add(const AABB &bounds)
+{
+    if (count % BATCH_SIZE == 0)
+    {
+        size_t padded = count + BATCH_SIZE;
+        minX.resize(padded, 0.0f);
+        minY.resize(padded, 0.0f);
+        minZ.resize(padded, 0.0f);
+        maxX.resize(padded, 0.0f);
+        maxY.resize(padded, 0.0f);
+        maxZ.resize(padded, 0.0f);
+    }
+
+    minX[count] = bounds.min.x;
+    minY[count] = bounds.min.y;
+    minZ[count] = bounds.min.z;
+    maxX[count] = bounds.max.x;
+    maxY[count] = bounds.max.y;
+    maxZ[count] = bounds.max.z;
+    return count++;
+}
+
+size_t FrustumCuller::Cull(const Frustum &frustum, std::vector<uint8_t> &visible) const
+{
+    visible.assign(count, 0);
+    if (count == 0)
+        return 0;
+
+    // 每个平面的正顶点只取决于法线符号，可在批处理前一次选好数据来源
+    PlaneInput inputs[6];
+    for (int p = 0; p < 6; ++p)
+    {
+        const glm::vec4 &plane = frustum.planes[p];
+        inputs[p].x = plane.x >= 0.0f ? maxX.data() : minX.data();
+        inputs[p].y = plane.y >= 0.0f ? maxY.data() : minY.data();
+        inputs[p].z = plane.z >= 0.0f ? maxZ.data() : minZ.data();
+        inputs[p].plane = plane;
+    }
+
+    size_t visibleCount = 0;
+    for (size_t offset = 0; offset < count; offset += BATCH_SIZE)
+    {
+        unsigned int outside = CullBatch(inputs, offset);
+        size_t lanes = std::min(BATCH_SIZE, count - offset);
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            if (!(outside & (1u << lane)))
+            {
+                visible[offset + lane] = 1;
+                ++visibleCount;
+            }
+        }
+    }
+    return visibleCount;
+}
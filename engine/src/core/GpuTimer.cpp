@@ -0,0 +1,137 @@
+#include "core/GpuTimer.hpp"
+
+namespace
+{
+// 界面显示用的滑动平均权重
+constexpr float AVERAGE_WEIGHT = 0.1f;
+} // namespace
+
+GpuTimer::~GpuTimer()
+{
+    for (auto &frame : frames)
+    {
+        if (!frame.queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    }
+}
+
+void GpuTimer::BeginFrame()
+{
+    if (!enabled)
+        return;
+
+    // 槽位中还是 FRAME_LATENCY 帧之前的查询，复用前先读回
+    currentFrame = (currentFrame + 1) % FRAME_LATENCY;
+    FrameQueries &frame = frames[currentFrame];
+    Resolve(frame);
+
+    frame.used = 0;
+    frame.records.clear();
+    openScopes.clear();
+    frame.frameBegin = IssueTimestamp(frame);
+    frame.frameEnd = -1;
+    inFrame = true;
+}
+
+void GpuTimer::EndFrame()
+{
+    if (!inFrame)
+        return;
+
+    FrameQueries &frame = frames[currentFrame];
+    // 未配对的 Begin 在帧末自动结束
+    while (!openScopes.empty())
+        End();
+    frame.frameEnd = IssueTimestamp(frame);
+    inFrame = false;
+}
+
+void GpuTimer::Begin(const char *name)
+{
+    if (!inFrame)
+        return;
+
+    auto it = sectionIndices.find(name);
+    int index;
+    if (it == sectionIndices.end())
+    {
+        index = static_cast<int>(sections.size());
+        Section section;
+        section.name = name;
+        section.depth = static_cast<int>(openScopes.size());
+        sections.push_back(section);
+        sectionIndices.emplace(name, index);
+    }
+    else
+    {
+        index = it->second;
+    }
+
+    openScopes.push_back({index, IssueTimestamp(frames[currentFrame]), -1});
+}
+
+void GpuTimer::End()
+{
+    if (!inFrame || openScopes.empty())
+        return;
+
+    Record record = openScopes.back();
+    openScopes.pop_back();
+    FrameQueries &frame = frames[currentFrame];
+    record.endQuery = IssueTimestamp(frame);
+    frame.records.push_back(record);
+}
+
+const GpuTimer::Section *GpuTimer::FindSection(const std::string &name) const
+{
+    auto it = sectionIndices.find(name);
+    return it != sectionIndices.end() ? &sections[it->second] : nullptr;
+}
+
+int GpuTimer::IssueTimestamp(FrameQueries &frame)
+{
+    if (frame.used == static_cast<int>(frame.queries.size()))
+    {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        frame.queries.push_back(query);
+    }
+    int index = frame.used++;
+    glQueryCounter(frame.queries[index], GL_TIMESTAMP);
+    return index;
+}
+
+void GpuTimer::Resolve(FrameQueries &frame)
+{
+    if (frame.frameBegin < 0 || frame.frameEnd < 0)
+        return;
+
+    // 正常情况下 GPU 最多落后几帧，这里的结果早已可用；不可用时读取会等待 GPU
+    auto read = [&frame](int index) {
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(frame.queries[index], GL_QUERY_RESULT, &value);
+        return value;
+    };
+    auto toMs = [](GLuint64 begin, GLuint64 end) {
+        return end > begin ? static_cast<float>(static_cast<double>(end - begin) / 1.0e6) : 0.0f;
+    };
+
+    // 同一阶段一帧内可能出现多次，累加
+    std::vector<float> totals(sections.size(), 0.0f);
+    for (const Record &record : frame.records)
+    {
+        totals[record.section] += toMs(read(record.beginQuery), read(record.endQuery));
+    }
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        Section &section = sections[i];
+        section.lastMs = totals[i];
+        // 本帧没有执行的阶段按 0 计入平均（例如切换渲染模式后不再使用的阶段）
+        section.averageMs = section.averageMs + (totals[i] - section.averageMs) * AVERAGE_WEIGHT;
+    }
+    frameMs = toMs(read(frame.frameBegin), read(frame.frameEnd));
+
+    frame.frameBegin = -1;
+    frame.frameEnd = -1;
+    ++resolvedFrames;
+}
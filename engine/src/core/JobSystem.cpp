@@ -0,0 +1,370 @@
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+// 工作线程对应的队列下标，非工作线程为 -1
+thread_local int currentWorkerIndex = -1;
+thread_local bool currentIsBackground = false;
+} // namespace
+
+JobSystem &JobSystem::GetInstance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize(unsigned int workerCount, unsigned int backgroundCount)
+{
+    if (running)
+        return;
+
+    if (workerCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    queues.clear();
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    running = true;
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+
+    backgroundCount = std::max(backgroundCount, 1u);
+    {
+        std::lock_guard<std::mutex> lock(backgroundMutex);
+        backgroundRunning = true;
+    }
+    for (unsigned int i = 0; i < backgroundCount; ++i)
+    {
+        backgroundWorkers.emplace_back(&JobSystem::BackgroundLoop, this);
+    }
+
+    std::cout << "JobSystem initialized with " << workerCount << " worker threads and " << backgroundCount
+              << " background threads" << std::endl;
+}
+
+void JobSystem::Shutdown()
+{
+    if (!running)
+        return;
+
+    // 后台线程先执行完队列中剩余的导入再退出；导入中投递的帧内作业此时仍由工作线程执行
+    {
+        std::lock_guard<std::mutex> lock(backgroundMutex);
+        backgroundRunning = false;
+    }
+    backgroundCondition.notify_all();
+    for (auto &worker : backgroundWorkers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    backgroundWorkers.clear();
+
+    // 先把剩余作业执行完，避免计数器永远无法归零
+    JobEntry entry;
+    while (TryPop(entry))
+    {
+        Execute(entry);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    for (auto &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+    queues.clear();
+}
+
+void JobSystem::Schedule(Job job, const std::shared_ptr<JobCounter> &counter)
+{
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    JobEntry entry{std::move(job), counter};
+
+    // 未初始化（或已关闭）时直接在当前线程执行
+    if (!running)
+    {
+        Execute(entry);
+        return;
+    }
+
+    Push(std::move(entry));
+}
+
+void JobSystem::ScheduleBackground(Job job, const std::shared_ptr<JobCounter> &counter)
+{
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    JobEntry entry{std::move(job), counter};
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(backgroundMutex);
+        if (backgroundRunning)
+        {
+            // 后台线程投递的作业属于正在执行的导入，放到队首优先完成
+            if (currentIsBackground)
+                backgroundJobs.push_front(std::move(entry));
+            else
+                backgroundJobs.push_back(std::move(entry));
+            queued = true;
+        }
+    }
+
+    // 未初始化（或已关闭）时直接在当前线程执行
+    if (!queued)
+    {
+        Execute(entry);
+        return;
+    }
+    backgroundCondition.notify_one();
+}
+
+void JobSystem::ScheduleAfter(const std::shared_ptr<JobCounter> &dependency, Job job,
+                              const std::shared_ptr<JobCounter> &counter)
+{
+    if (!dependency)
+    {
+        Schedule(std::move(job), counter);
+        return;
+    }
+
+    // 后续作业在挂起期间也计入 counter，保证 Wait(counter) 能等到它
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    auto continuation = [this, job = std::move(job), counter]() mutable {
+        Schedule(std::move(job), counter);
+        if (counter)
+            Finish(counter);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (!dependency->IsDone())
+        {
+            dependency->continuations.push_back(std::move(continuation));
+            return;
+        }
+    }
+    continuation();
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grainSize, const RangeJob &body)
+{
+    if (begin >= end)
+        return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    if (!running || end - begin <= grainSize)
+    {
+        body(begin, end);
+        return;
+    }
+
+    auto counter = std::make_shared<JobCounter>();
+    for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+    {
+        size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+        Job chunk = [&body, chunkBegin, chunkEnd]() { body(chunkBegin, chunkEnd); };
+        if (currentIsBackground)
+            ScheduleBackground(std::move(chunk), counter);
+        else
+            Schedule(std::move(chunk), counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::Wait(const std::shared_ptr<JobCounter> &counter)
+{
+    if (!counter)
+        return;
+
+    while (!counter->IsDone())
+    {
+        JobEntry entry;
+        if (currentIsBackground ? TryPopBackground(entry) : TryPop(entry))
+        {
+            Execute(entry);
+        }
+        else
+        {
+            // 剩余作业都在其他线程上执行中
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::IsWorkerThread()
+{
+    return currentWorkerIndex >= 0;
+}
+
+bool JobSystem::IsBackgroundThread()
+{
+    return currentIsBackground;
+}
+
+void JobSystem::WorkerLoop(unsigned int index)
+{
+    currentWorkerIndex = static_cast<int>(index);
+
+    while (true)
+    {
+        JobEntry entry;
+        if (TryPop(entry))
+        {
+            Execute(entry);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this]() { return !running || queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (!running)
+            break;
+    }
+
+    currentWorkerIndex = -1;
+}
+
+void JobSystem::BackgroundLoop()
+{
+    currentIsBackground = true;
+
+    while (true)
+    {
+        JobEntry entry;
+        {
+            std::unique_lock<std::mutex> lock(backgroundMutex);
+            backgroundCondition.wait(lock, [this]() { return !backgroundRunning || !backgroundJobs.empty(); });
+            // 关闭后仍把队列执行完再退出
+            if (backgroundJobs.empty())
+                break;
+            entry = std::move(backgroundJobs.front());
+            backgroundJobs.pop_front();
+        }
+        Execute(entry);
+    }
+
+    currentIsBackground = false;
+}
+
+void JobSystem::Push(JobEntry entry)
+{
+    // 工作线程投递到自己的队列尾部（局部性更好），其他线程轮流投递
+    size_t index = currentWorkerIndex >= 0 ? static_cast<size_t>(currentWorkerIndex)
+                                           : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(entry));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+    wakeCondition.notify_one();
+}
+
+bool JobSystem::TryPop(JobEntry &entry)
+{
+    if (queues.empty() || queuedJobs.load(std::memory_order_acquire) <= 0)
+        return false;
+
+    size_t queueCount = queues.size();
+    size_t self = currentWorkerIndex >= 0 ? static_cast<size_t>(currentWorkerIndex) : 0;
+
+    // 先取自己队列的尾部（最近投递的作业）
+    if (currentWorkerIndex >= 0)
+    {
+        WorkQueue &own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            entry = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    // 再从其他队列头部窃取（最早投递、通常也是最大的作业）
+    for (size_t offset = 1; offset <= queueCount; ++offset)
+    {
+        WorkQueue &victim = *queues[(self + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            entry = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::TryPopBackground(JobEntry &entry)
+{
+    std::lock_guard<std::mutex> lock(backgroundMutex);
+    if (backgroundJobs.empty())
+        return false;
+    entry = std::move(backgroundJobs.front());
+    backgroundJobs.pop_front();
+    return true;
+}
+
+void JobSystem::Execute(JobEntry &entry)
+{
+    try
+    {
+        entry.job();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "JobSystem: job threw exception: " << e.what() << std::endl;
+    }
+
+    if (entry.counter)
+        Finish(entry.counter);
+}
+
+void JobSystem::Finish(const std::shared_ptr<JobCounter> &counter)
+{
+    if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // 计数器归零：调度所有后续作业
+    std::vector<Job> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        continuations.swap(counter->continuations);
+    }
+    for (auto &continuation : continuations)
+    {
+        continuation();
+    }
+}
@@ -40,45 +40,16 @@ PointLight::PointLight(const glm::vec3 &position, const glm::vec3 &ambient, cons
     number = count++;
 }
 
-void PointLight::SetupShader(Shader &shader, int index, bool globalShadowEnabled) const
+void PointLight::FillGpuData(GpuLightData &data) const
 {
-    std::string prefix = "pointLights[" + std::to_string(index) + "].";
-    shader.SetVec3(prefix + "position", position);
-    shader.SetVec3(prefix + "ambient", ambient * intensity);
-    shader.SetVec3(prefix + "diffuse", diffuse * intensity);
-    shader.SetVec3(prefix + "specular", specular * intensity);
-    shader.SetFloat(prefix + "constant", constant);
-    shader.SetFloat(prefix + "linear", linear);
-    shader.SetFloat(prefix + "quadratic", quadratic);
-    
-    // 设置阴影相关参数
-    bool finalShadowEnabled = shadowEnabled && globalShadowEnabled;
-    shader.SetBool(prefix + "hasShadows", finalShadowEnabled);
-    if (finalShadowEnabled && shadowMap != 0)
-    {
-        // 使用基于光源类型和索引的纹理单元分配策略
-        // 点光源从 15 开始，避免与其他光源冲突
-        int textureUnit = 15 + index;
-        shader.SetInt(prefix + "shadowMap", textureUnit);
-        shader.SetMat4(prefix + "lightSpaceMatrix", GetLightSpaceMatrix());
-        
-        // 绑定阴影贴图
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, shadowMap);
-        
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
-    }
-    else
-    {
-        shader.SetBool(prefix + "hasShadows", false);
-        shader.SetInt(prefix + "shadowMap", 0);
-    }
+    data.position = glm::vec4(position, static_cast<float>(getType()));
+    data.direction = glm::vec4(0.0f, -1.0f, 0.0f, shadowEnabled && shadowMap != 0 ? 1.0f : 0.0f);
+    data.ambient = glm::vec4(ambient * intensity, constant);
+    data.diffuse = glm::vec4(diffuse * intensity, linear);
+    data.specular = glm::vec4(specular * intensity, quadratic);
+    data.spot = glm::vec4(0.0f);
+    data.shadowRect = shadowAtlasRect;
+    data.lightSpaceMatrix = GetLightSpaceMatrix();
 }
 
 void PointLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
@@ -126,37 +97,10 @@ void PointLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
     model = glm::translate(model, position);
     model = glm::scale(model, glm::vec3(radius));
 
-    // 4. 把矩阵和光源参数送入 shader
+    // 4. 把矩阵和光源下标送入 shader（光源参数在光源表中）
     shader->SetMat4("model", model);
-    shader->SetVec3("light.position", position);
-    shader->SetVec3("light.ambient", ambient * intensity);
-    shader->SetVec3("light.diffuse", diffuse * intensity);
-    shader->SetVec3("light.specular", specular * intensity);
-    shader->SetFloat("light.constant", constant);
-    shader->SetFloat("light.linear", linear);
-    shader->SetFloat("light.quadratic", quadratic);
+    shader->SetInt("lightIndex", gpuIndex);
     shader->SetInt("lightType", this->getType());
-    
-    // 设置阴影相关参数
-    shader->SetBool("light.hasShadows", shadowEnabled);
-    if (shadowEnabled && shadowMap != 0)
-    {
-        shader->SetMat4("light.lightSpaceMatrix", GetLightSpaceMatrix());
-        
-        // 绑定阴影贴图到固定的纹理单元
-        int textureUnit = 30; // 延迟渲染使用专用纹理单元
-        shader->SetInt("lightShadowMap", textureUnit);
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, shadowMap);
-        
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
-    }
 
     // 5. 绘制球体
     glBindVertexArray(lightSphereVAO);
@@ -171,41 +115,17 @@ DirectionalLight::DirectionalLight(const glm::vec3 &direction, const glm::vec3 &
     number = count++;
 }
 
-void DirectionalLight::SetupShader(Shader &shader, int index, bool globalShadowEnabled) const
+void DirectionalLight::FillGpuData(GpuLightData &data) const
 {
-    std::string prefix = "dirLight[" + std::to_string(index) + "].";
-    shader.SetVec3(prefix + "direction", direction);
-    shader.SetVec3(prefix + "ambient", ambient * intensity);
-    shader.SetVec3(prefix + "diffuse", diffuse * intensity);
-    shader.SetVec3(prefix + "specular", specular * intensity);
-    
-    // 设置阴影相关参数
-    bool finalShadowEnabled = shadowEnabled && globalShadowEnabled;
-    shader.SetBool(prefix + "hasShadows", finalShadowEnabled);
-    if (finalShadowEnabled && shadowMap != 0)
-    {
-        // 定向光从纹理单元 10 开始
-        int textureUnit = 10 + index;
-        shader.SetInt(prefix + "shadowMap", textureUnit);
-        shader.SetMat4(prefix + "lightSpaceMatrix", GetLightSpaceMatrix());
-        
-        // 绑定阴影贴图
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, shadowMap);
-        
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
-    }
-    else
-    {
-        shader.SetBool(prefix + "hasShadows", false);
-        shader.SetInt(prefix + "shadowMap", 0);
-    }
+    data.position = glm::vec4(0.0f, 0.0f, 0.0f, static_cast<float>(getType()));
+    bool castsShadow = shadowEnabled && shadowMap != 0 && shadowCascadeSlot >= 0;
+    data.direction = glm::vec4(direction, castsShadow ? 1.0f : 0.0f);
+    data.ambient = glm::vec4(ambient * intensity, 1.0f);
+    data.diffuse = glm::vec4(diffuse * intensity, 0.0f);
+    data.specular = glm::vec4(specular * intensity, 0.0f);
+    data.spot = glm::vec4(0.0f);
+    data.shadowRect = glm::vec4(static_cast<float>(shadowCascadeSlot), 0.0f, 0.0f, 0.0f);
+    data.lightSpaceMatrix = glm::mat4(1.0f);
 }
 
 void DirectionalLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
@@ -214,32 +134,8 @@ void DirectionalLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
      * 1. 方向光没有位置，只有方向；无衰减
      *------------------------------------------------*/
     shader->SetMat4("model", glm::mat4(1.0f)); // 单位矩阵
-    shader->SetVec3("light.direction", glm::normalize(direction));
-    shader->SetVec3("light.ambient", ambient * intensity);
-    shader->SetVec3("light.diffuse", diffuse * intensity);
-    shader->SetVec3("light.specular", specular * intensity);
+    shader->SetInt("lightIndex", gpuIndex);
     shader->SetInt("lightType", this->getType());
-    
-    // 设置阴影相关参数
-    shader->SetBool("light.hasShadows", shadowEnabled);
-    if (shadowEnabled && shadowMap != 0)
-    {
-        shader->SetMat4("light.lightSpaceMatrix", GetLightSpaceMatrix());
-        
-        // 绑定阴影贴图到固定的纹理单元
-        int textureUnit = 30; // 延迟渲染使用专用纹理单元
-        shader->SetInt("lightShadowMap", textureUnit);
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, shadowMap);
-        
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
-    }
 
     /*-------------------------------------------------
      * 2. 直接绘制全屏 Quad
@@ -259,47 +155,16 @@ SpotLight::SpotLight(const glm::vec3 &position, const glm::vec3 &direction, cons
     number = count++;
 }
 
-void SpotLight::SetupShader(Shader &shader, int index, bool globalShadowEnabled) const
+void SpotLight::FillGpuData(GpuLightData &data) const
 {
-    std::string prefix = "spotLights[" + std::to_string(index) + "].";
-    shader.SetVec3(prefix + "position", position);
-    shader.SetVec3(prefix + "direction", direction);
-    shader.SetVec3(prefix + "ambient", ambient * intensity);
-    shader.SetVec3(prefix + "diffuse", diffuse * intensity);
-    shader.SetVec3(prefix + "specular", specular * intensity);
-    shader.SetFloat(prefix + "cutOff", cutOff);
-    shader.SetFloat(prefix + "outerCutOff", outerCutOff);
-    shader.SetFloat(prefix + "constant", constant);
-    shader.SetFloat(prefix + "linear", linear);
-    shader.SetFloat(prefix + "quadratic", quadratic);
-    
-    // 设置阴影相关参数
-    bool finalShadowEnabled = shadowEnabled && globalShadowEnabled;
-    shader.SetBool(prefix + "hasShadows", finalShadowEnabled);
-    if (finalShadowEnabled && shadowMap != 0)
-    {
-        // 聚光灯从纹理单元 20 开始，避免与其他光源冲突
-        int textureUnit = 20 + index;
-        shader.SetInt(prefix + "shadowMap", textureUnit);
-        shader.SetMat4(prefix + "lightSpaceMatrix", GetLightSpaceMatrix());
-        
-        // 绑定阴影贴图
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, shadowMap);
-        
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
-    }
-    else
-    {
-        shader.SetBool(prefix + "hasShadows", false);
-        shader.SetInt(prefix + "shadowMap", 0);
-    }
+    data.position = glm::vec4(position, static_cast<float>(getType()));
+    data.direction = glm::vec4(direction, shadowEnabled && shadowMap != 0 ? 1.0f : 0.0f);
+    data.ambient = glm::vec4(ambient * intensity, constant);
+    data.diffuse = glm::vec4(diffuse * intensity, linear);
+    data.specular = glm::vec4(specular * intensity, quadratic);
+    data.spot = glm::vec4(cutOff, outerCutOff, 0.0f, 0.0f);
+    data.shadowRect = shadowAtlasRect;
+    data.lightSpaceMatrix = GetLightSpaceMatrix();
 }
 
 void SpotLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
@@ -401,40 +266,10 @@ void SpotLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
 
     
 
-    /* 4. 传 uniform（与旧 SetupShader 字段保持一致） */
+    /* 4. 传 uniform（光源参数在光源表中，只需下标） */
     shader->SetMat4("model", model);
-    shader->SetVec3("light.position", position);
-    shader->SetVec3("light.direction", direction);
-    shader->SetVec3("light.ambient", ambient * intensity);
-    shader->SetVec3("light.diffuse", diffuse * intensity);
-    shader->SetVec3("light.specular", specular * intensity);
-    shader->SetFloat("light.cutOff", cutOff);
-    shader->SetFloat("light.outerCutOff", outerCutOff);
-    shader->SetFloat("light.constant", constant);
-    shader->SetFloat("light.linear", linear);
-    shader->SetFloat("light.quadratic", quadratic);
+    shader->SetInt("lightIndex", gpuIndex);
     shader->SetInt("lightType", this->getType());
-    
-    // 设置阴影相关参数
-    shader->SetBool("light.hasShadows", shadowEnabled);
-    if (shadowEnabled && shadowMap != 0)
-    {
-        shader->SetMat4("light.lightSpaceMatrix", GetLightSpaceMatrix());
-        
-        // 绑定阴影贴图到固定的纹理单元
-        int textureUnit = 30; // 延迟渲染使用专用纹理单元
-        shader->SetInt("lightShadowMap", textureUnit);
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        glBindTexture(GL_TEXTURE_2D, shadowMap);
-        
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        float border[] = {1.0f, 1.0f, 1.0f, 1.0f};
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
-    }
 
     /* 5. 绘制 */
     glBindVertexArray(lightConeVAO);
@@ -443,28 +278,6 @@ void SpotLight::drawLightMesh(const std::unique_ptr<Shader> &shader)
 }
 
 // 阴影相关方法实现
-glm::mat4 DirectionalLight::GetLightSpaceMatrix() const
-{
-    // 计算光源位置（在场景中心上方，朝向光源方向的反方向）
-    glm::vec3 lightPos = glm::vec3(0.0f, 10.0f, 0.0f) - glm::normalize(direction) * 10.0f;
-    
-    // 计算光源视图矩阵
-    glm::mat4 lightView = glm::lookAt(
-        lightPos,                    // 光源位置
-        glm::vec3(0.0f, 0.0f, 0.0f), // 看向场景中心
-        glm::vec3(0.0f, 1.0f, 0.0f)  // 上方向
-    );
-    
-    // 正交投影矩阵
-    glm::mat4 lightProjection = glm::ortho(
-        -shadowOrthoSize, shadowOrthoSize,
-        -shadowOrthoSize, shadowOrthoSize,
-        shadowNearPlane, shadowFarPlane
-    );
-    
-    return lightProjection * lightView;
-}
-
 glm::mat4 PointLight::GetLightSpaceMatrix() const
 {
     // 点光源使用透视投影，朝向Y轴负方向（向下）
@@ -0,0 +1,127 @@
+#include "core/LightBuffer.hpp"
+#include <algorithm>
+
+LightBuffer::LightBuffer(size_t initialCapacity)
+{
+    glGenBuffers(1, &ID);
+    Reserve(std::max<size_t>(initialCapacity, 1));
+    Bind();
+}
+
+LightBuffer::~LightBuffer()
+{
+    if (ID != 0)
+    {
+        glDeleteBuffers(1, &ID);
+        ID = 0;
+    }
+}
+
+void LightBuffer::Update(const std::vector<std::shared_ptr<DirectionalLight>> &dirLights,
+                         const std::vector<std::shared_ptr<PointLight>> &pointLights,
+                         const std::vector<std::shared_ptr<SpotLight>> &spotLights)
+{
+    uploadedCount = 0;
+
+    std::vector<const Light *> current;
+    current.reserve(dirLights.size() + pointLights.size() + spotLights.size());
+    for (auto &light : dirLights)
+        current.push_back(light.get());
+    for (auto &light : pointLights)
+        current.push_back(light.get());
+    for (auto &light : spotLights)
+        current.push_back(light.get());
+
+    Header header;
+    header.counts = glm::ivec4(static_cast<int>(dirLights.size()), static_cast<int>(pointLights.size()),
+                               static_cast<int>(spotLights.size()), 0);
+
+    auto lightAt = [&](size_t i) -> Light * {
+        if (i < dirLights.size())
+            return dirLights[i].get();
+        i -= dirLights.size();
+        if (i < pointLights.size())
+            return pointLights[i].get();
+        return spotLights[i - pointLights.size()].get();
+    };
+
+    // 光源增删：重建整张表
+    if (current != layout || header.counts != counts)
+    {
+        layout = std::move(current);
+        counts = header.counts;
+        records.resize(layout.size());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            Light *light = lightAt(i);
+            light->SetGpuIndex(static_cast<int>(i));
+            light->FillGpuData(records[i]);
+            light->ClearDirty();
+        }
+
+        Reserve(records.size());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, ID);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(Header), &header);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        UploadRange(0, records.size());
+        uploadedCount = static_cast<int>(records.size());
+        return;
+    }
+
+    // 光源列表不变：只上传脏光源，相邻的脏光源合并为一次上传。
+    // 指针相同不代表是同一个光源（删除后新建的光源可能复用原地址），下标不一致的光源也按脏处理
+    size_t rangeStart = 0, rangeCount = 0;
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        Light *light = lightAt(i);
+        if (light->GetGpuIndex() != static_cast<int>(i))
+        {
+            light->SetGpuIndex(static_cast<int>(i));
+            light->MarkDirty();
+        }
+        if (!light->IsDirty())
+        {
+            if (rangeCount > 0)
+                UploadRange(rangeStart, rangeCount);
+            rangeCount = 0;
+            continue;
+        }
+
+        light->FillGpuData(records[i]);
+        light->ClearDirty();
+        ++uploadedCount;
+
+        if (rangeCount == 0)
+            rangeStart = i;
+        ++rangeCount;
+    }
+    if (rangeCount > 0)
+        UploadRange(rangeStart, rangeCount);
+}
+
+void LightBuffer::Bind() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_DATA_BINDING, ID);
+}
+
+void LightBuffer::Reserve(size_t count)
+{
+    if (count <= capacity)
+        return;
+
+    // 容量翻倍增长，避免光源逐个增加时频繁重新分配
+    capacity = std::max(count, capacity * 2);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ID);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Header) + capacity * sizeof(GpuLightData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void LightBuffer::UploadRange(size_t first, size_t count) const
+{
+    if (count == 0)
+        return;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ID);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, sizeof(Header) + first * sizeof(GpuLightData),
+                    count * sizeof(GpuLightData), &records[first]);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
@@ -0,0 +1,223 @@
+#include "core/LightClusterAssigner.hpp"
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define LIGHT_CLUSTER_AVX 1
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define LIGHT_CLUSTER_SSE 1
+#endif
+
+namespace
+{
+using Assigner = LightClusterAssigner;
+
+// 与切片深度范围相交的光源，按 SoA 紧凑存放以便整批读取
+struct SliceLights
+{
+    std::vector<float> x, y, z, radiusSq;
+    std::vector<uint32_t> index;
+
+    void Clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+        radiusSq.clear();
+        index.clear();
+    }
+};
+
+// 与 light_clusters.glsl 的 ClusterSliceDepth 一致
+float SliceDepth(float nearPlane, float farPlane, int slice)
+{
+    return nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(slice) / Assigner::CLUSTER_Z);
+}
+
+// NDC 坐标在近平面上对应的视空间点，与原点连线即为该方向的视线
+glm::vec3 ViewRay(const glm::mat4 &inverseProjection, float ndcX, float ndcY)
+{
+    glm::vec4 p = inverseProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+    return glm::vec3(p) / p.w;
+}
+
+// 测试切片内全部光源与簇包围盒是否相交，前 MAX_LIGHTS_PER_CLUSTER 个下标写入 slots；
+// 返回相交的光源数（含被截断的部分）
+int AssignCluster(const SliceLights &lights, const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, bool useSimd,
+                  uint32_t indexOffset, uint32_t *slots)
+{
+    const size_t lightCount = lights.index.size();
+    int count = 0;
+    auto append = [&](size_t i) {
+        if (count < Assigner::MAX_LIGHTS_PER_CLUSTER)
+            slots[count] = indexOffset + lights.index[i];
+        ++count;
+    };
+
+    // 球心钳制到包围盒内得到最近点，与球心的距离不超过半径即相交；按批处理时逐位取出掩码，保持下标升序
+    size_t i = 0;
+#if defined(LIGHT_CLUSTER_AVX)
+    if (useSimd)
+    {
+        const __m256 minX = _mm256_set1_ps(aabbMin.x), maxX = _mm256_set1_ps(aabbMax.x);
+        const __m256 minY = _mm256_set1_ps(aabbMin.y), maxY = _mm256_set1_ps(aabbMax.y);
+        const __m256 minZ = _mm256_set1_ps(aabbMin.z), maxZ = _mm256_set1_ps(aabbMax.z);
+        for (; i + 8 <= lightCount; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(lights.x.data() + i);
+            __m256 y = _mm256_loadu_ps(lights.y.data() + i);
+            __m256 z = _mm256_loadu_ps(lights.z.data() + i);
+            __m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(x, minX), maxX), x);
+            __m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(y, minY), maxY), y);
+            __m256 dz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(z, minZ), maxZ), z);
+            __m256 distSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                          _mm256_mul_ps(dz, dz));
+            __m256 inside = _mm256_cmp_ps(distSq, _mm256_loadu_ps(lights.radiusSq.data() + i), _CMP_LE_OQ);
+            for (unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(inside)); mask; mask &= mask - 1)
+                append(i + std::countr_zero(mask));
+        }
+    }
+#elif defined(LIGHT_CLUSTER_SSE)
+    if (useSimd)
+    {
+        const __m128 minX = _mm_set1_ps(aabbMin.x), maxX = _mm_set1_ps(aabbMax.x);
+        const __m128 minY = _mm_set1_ps(aabbMin.y), maxY = _mm_set1_ps(aabbMax.y);
+        const __m128 minZ = _mm_set1_ps(aabbMin.z), maxZ = _mm_set1_ps(aabbMax.z);
+        for (; i + 4 <= lightCount; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(lights.x.data() + i);
+            __m128 y = _mm_loadu_ps(lights.y.data() + i);
+            __m128 z = _mm_loadu_ps(lights.z.data() + i);
+            __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(x, minX), maxX), x);
+            __m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(y, minY), maxY), y);
+            __m128 dz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(z, minZ), maxZ), z);
+            __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 inside = _mm_cmple_ps(distSq, _mm_loadu_ps(lights.radiusSq.data() + i));
+            for (unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(inside)); mask; mask &= mask - 1)
+                append(i + std::countr_zero(mask));
+        }
+    }
+#else
+    (void)useSimd;
+#endif
+
+    // 不足一批的剩余光源（或关闭 SIMD 时的全部光源）
+    for (; i < lightCount; ++i)
+    {
+        float dx = std::min(std::max(lights.x[i], aabbMin.x), aabbMax.x) - lights.x[i];
+        float dy = std::min(std::max(lights.y[i], aabbMin.y), aabbMax.y) - lights.y[i];
+        float dz = std::min(std::max(lights.z[i], aabbMin.z), aabbMax.z) - lights.z[i];
+        if (dx * dx + dy * dy + dz * dz <= lights.radiusSq[i])
+            append(i);
+    }
+    return count;
+}
+} // namespace
+
+void LightClusterAssigner::Clear()
+{
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    radius.clear();
+    count = 0;
+}
+
+size_t LightClusterAssigner::Add(const glm::vec4 &viewSphere)
+{
+    centerX.push_back(viewSphere.x);
+    centerY.push_back(viewSphere.y);
+    centerZ.push_back(viewSphere.z);
+    radius.push_back(viewSphere.w);
+    return count++;
+}
+
+LightClusterAssigner::Result LightClusterAssigner::Assign(const glm::mat4 &projection, float nearPlane,
+                                                          float farPlane, uint32_t indexOffset,
+                                                          std::vector<uint32_t> &data) const
+{
+    // 每个簇的光源数都会写入，光源下标只写前 count 个槽位，着色器不会读取其余槽位
+    data.resize(DATA_SIZE);
+    uint32_t *clusterCounts = data.data();
+    uint32_t *clusterIndices = data.data() + CLUSTER_COUNT;
+
+    // 图块角点的视线只取决于投影矩阵，所有切片共用；相邻图块共享角点
+    const glm::mat4 inverseProjection = glm::inverse(projection);
+    std::vector<glm::vec3> cornerRays((CLUSTER_X + 1) * (CLUSTER_Y + 1));
+    for (int y = 0; y <= CLUSTER_Y; ++y)
+    {
+        for (int x = 0; x <= CLUSTER_X; ++x)
+        {
+            float ndcX = static_cast<float>(x) / CLUSTER_X * 2.0f - 1.0f;
+            float ndcY = static_cast<float>(y) / CLUSTER_Y * 2.0f - 1.0f;
+            cornerRays[x + y * (CLUSTER_X + 1)] = ViewRay(inverseProjection, ndcX, ndcY);
+        }
+    }
+
+    std::vector<int> sliceMax(CLUSTER_Z, 0), sliceOverflow(CLUSTER_Z, 0);
+
+    // 各深度切片互不依赖；先按切片深度范围筛掉光源，再对切片内每个图块做包围盒测试
+    JobSystem::GetInstance().ParallelFor(0, CLUSTER_Z, 1, [&](size_t begin, size_t end) {
+        SliceLights sliceLights;
+        for (size_t z = begin; z < end; ++z)
+        {
+            float nearDepth = SliceDepth(nearPlane, farPlane, static_cast<int>(z));
+            float farDepth = SliceDepth(nearPlane, farPlane, static_cast<int>(z) + 1);
+
+            sliceLights.Clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                float depth = -centerZ[i];
+                if (depth + radius[i] >= nearDepth && depth - radius[i] <= farDepth)
+                {
+                    sliceLights.x.push_back(centerX[i]);
+                    sliceLights.y.push_back(centerY[i]);
+                    sliceLights.z.push_back(centerZ[i]);
+                    sliceLights.radiusSq.push_back(radius[i] * radius[i]);
+                    sliceLights.index.push_back(static_cast<uint32_t>(i));
+                }
+            }
+
+            for (int y = 0; y < CLUSTER_Y; ++y)
+            {
+                for (int x = 0; x < CLUSTER_X; ++x)
+                {
+                    // 图块四条棱线与切片前后两个平面的交点构成簇，取其包围盒
+                    const glm::vec3 rays[4] = {cornerRays[x + y * (CLUSTER_X + 1)],
+                                               cornerRays[x + 1 + y * (CLUSTER_X + 1)],
+                                               cornerRays[x + (y + 1) * (CLUSTER_X + 1)],
+                                               cornerRays[x + 1 + (y + 1) * (CLUSTER_X + 1)]};
+                    glm::vec3 aabbMin(1e30f), aabbMax(-1e30f);
+                    for (const glm::vec3 &ray : rays)
+                    {
+                        glm::vec3 nearPoint = ray * (nearDepth / -ray.z);
+                        glm::vec3 farPoint = ray * (farDepth / -ray.z);
+                        aabbMin = glm::min(aabbMin, glm::min(nearPoint, farPoint));
+                        aabbMax = glm::max(aabbMax, glm::max(nearPoint, farPoint));
+                    }
+
+                    const size_t cluster = x + y * CLUSTER_X + z * (CLUSTER_X * CLUSTER_Y);
+                    int lightCount = AssignCluster(sliceLights, aabbMin, aabbMax, useSimd, indexOffset,
+                                                   clusterIndices + cluster * MAX_LIGHTS_PER_CLUSTER);
+
+                    clusterCounts[cluster] = static_cast<uint32_t>(std::min(lightCount, MAX_LIGHTS_PER_CLUSTER));
+                    sliceMax[z] = std::max(sliceMax[z], lightCount);
+                    if (lightCount > MAX_LIGHTS_PER_CLUSTER)
+                        ++sliceOverflow[z];
+                }
+            }
+        }
+    });
+
+    Result result;
+    for (int z = 0; z < CLUSTER_Z; ++z)
+    {
+        result.maxClusterLights = std::max(result.maxClusterLights, sliceMax[z]);
+        result.overflowClusters += sliceOverflow[z];
+    }
+    return result;
+}
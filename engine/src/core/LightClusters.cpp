@@ -0,0 +1,104 @@
+#include "core/LightClusters.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+constexpr GLuint COMPUTE_GROUP_SIZE = 64; // 与 light_cluster.comp 的 local_size_x 一致
+
+// 影响半径：亮度衰减到 3/256 时的距离，与 light_data.glsl 的 LightRange 一致
+float LightRange(const GpuLightData &light)
+{
+    float maxBrightness = std::max({light.diffuse.r, light.diffuse.g, light.diffuse.b});
+    float constant = light.ambient.a - 256.0f / 3.0f * maxBrightness;
+    float linear = light.diffuse.a;
+    float quadratic = light.specular.a;
+    if (quadratic <= 0.0f)
+        return linear > 0.0f ? std::max(-constant / linear, 0.01f) : 1e30f;
+    return std::max((-linear + std::sqrt(linear * linear - 4.0f * quadratic * constant)) / (2.0f * quadratic), 0.01f);
+}
+} // namespace
+
+LightClusters::LightClusters(const std::string &computeShaderPath)
+{
+    glGenBuffers(1, &ID);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ID);
+    glBufferData(GL_SHADER_STORAGE_BUFFER,
+                 sizeof(uint32_t) * (CLUSTER_COUNT + static_cast<size_t>(CLUSTER_COUNT) * MAX_LIGHTS_PER_CLUSTER),
+                 nullptr, GL_DYNAMIC_DRAW);
+    // 第一次更新前所有簇为空
+    std::vector<uint32_t> zeros(CLUSTER_COUNT, 0);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, zeros.size() * sizeof(uint32_t), zeros.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    Bind();
+
+    computeSupported = glDispatchCompute != nullptr;
+    if (computeSupported)
+        computeShader = std::make_unique<Shader>(computeShaderPath);
+    else
+        std::cerr << "LightClusters: compute shaders not supported, using CPU light assignment" << std::endl;
+}
+
+LightClusters::~LightClusters()
+{
+    if (ID != 0)
+    {
+        glDeleteBuffers(1, &ID);
+        ID = 0;
+    }
+}
+
+void LightClusters::Update(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane,
+                           const LightBuffer &lights)
+{
+    const glm::ivec4 &counts = lights.GetCounts();
+    stats = Stats();
+    stats.lights = std::max(counts.y, 0) + std::max(counts.z, 0);
+
+    Bind();
+    lights.Bind();
+    if (IsUsingCompute())
+        UpdateCompute();
+    else
+        UpdateCpu(view, projection, nearPlane, farPlane, lights);
+}
+
+void LightClusters::Bind() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_LIGHTS_BINDING, ID);
+}
+
+void LightClusters::UpdateCompute()
+{
+    // 相机矩阵和近远平面从 FrameData 读取
+    computeShader->Use();
+
+    glDispatchCompute((CLUSTER_COUNT + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE, 1, 1);
+    // 片段着色器读取簇光源表之前等待写入完成
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void LightClusters::UpdateCpu(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane,
+                              const LightBuffer &lights)
+{
+    const std::vector<GpuLightData> &records = lights.GetRecords();
+    const glm::ivec4 &counts = lights.GetCounts();
+    const int first = std::max(counts.x, 0);
+    const int total = std::min(static_cast<int>(records.size()), first + stats.lights);
+
+    // 光源变换到视空间，w 为影响半径
+    assigner.Clear();
+    for (int i = first; i < total; ++i)
+        assigner.Add(glm::vec4(glm::vec3(view * glm::vec4(glm::vec3(records[i].position), 1.0f)),
+                               LightRange(records[i])));
+
+    LightClusterAssigner::Result result =
+        assigner.Assign(projection, nearPlane, farPlane, static_cast<uint32_t>(first), cpuData);
+    stats.maxClusterLights = result.maxClusterLights;
+    stats.overflowClusters = result.overflowClusters;
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ID);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, cpuData.size() * sizeof(uint32_t), cpuData.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
@@ -1,4 +1,5 @@
 #include "core/Material.hpp"
+#include <algorithm>
 
 Material::Material(MaterialType type) : type(type)
 {
@@ -20,91 +21,210 @@ Material::Material(MaterialType type) : type(type)
     }
 }
 
+const Material::UniformCache &Material::GetUniformCache(const Shader &shader)
+{
+    for (const auto &cache : uniformCaches)
+    {
+        if (cache.shader == &shader && cache.generation == shader.GetGeneration())
+            return cache;
+    }
+
+    // 同一地址上的旧条目属于已销毁或重新链接的程序，直接丢弃
+    uniformCaches.erase(std::remove_if(uniformCaches.begin(), uniformCaches.end(),
+                                       [&shader](const UniformCache &cache) { return cache.shader == &shader; }),
+                        uniformCaches.end());
+    // 一个材质用到的变体有限；着色器反复重建时只保留最近的条目
+    if (uniformCaches.size() >= MAX_UNIFORM_CACHES)
+        uniformCaches.erase(uniformCaches.begin());
+
+    UniformCache cache;
+    cache.shader = &shader;
+    cache.generation = shader.GetGeneration();
+    cache.diffuse = shader.GetUniformHandle("material.diffuse");
+    cache.specular = shader.GetUniformHandle("material.specular");
+    cache.shininess = shader.GetUniformHandle("material.shininess");
+    cache.diffuseMap = shader.GetUniformHandle("material.diffuseMap");
+    cache.specularMap = shader.GetUniformHandle("material.specularMap");
+    cache.normalMap = shader.GetUniformHandle("material.normalMap");
+    cache.albedo = shader.GetUniformHandle("material.albedo");
+    cache.metallic = shader.GetUniformHandle("material.metallic");
+    cache.roughness = shader.GetUniformHandle("material.roughness");
+    cache.ao = shader.GetUniformHandle("material.ao");
+    cache.albedoMap = shader.GetUniformHandle("material.albedoMap");
+    cache.metallicMap = shader.GetUniformHandle("material.metallicMap");
+    cache.roughnessMap = shader.GetUniformHandle("material.roughnessMap");
+    cache.aoMap = shader.GetUniformHandle("material.aoMap");
+    uniformCaches.push_back(cache);
+    return uniformCaches.back();
+}
+
+size_t Material::GetTextureSetHash() const
+{
+    size_t hash = static_cast<size_t>(type);
+    auto combine = [&hash](const std::shared_ptr<Texture> &texture, bool used) {
+        size_t id = (used && texture) ? texture->GetID() : 0;
+        hash ^= id + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+
+    if (type == BLINN_PHONG)
+    {
+        combine(diffuseMap, useDiffuseMap);
+        combine(specularMap, useSpecularMap);
+        combine(normalMap, useNormalMap);
+    }
+    else
+    {
+        combine(albedoMap, useAlbedoMap);
+        combine(metallicMap, useMetallicMap);
+        combine(roughnessMap, useRoughnessMap);
+        combine(aoMap, useAOMap);
+        combine(normalMap, useNormalMap);
+    }
+    return hash;
+}
+
+uint32_t Material::GetShaderFeatures() const
+{
+    // 与 Apply 绑定贴图的条件保持一致：开关打开且贴图存在
+    uint32_t features = 0;
+    auto add = [&features](const std::shared_ptr<Texture> &texture, bool used, ShaderFeature feature) {
+        if (used && texture)
+            features |= feature;
+    };
+
+    if (type == BLINN_PHONG)
+    {
+        add(diffuseMap, useDiffuseMap, SHADER_FEATURE_ALBEDO_MAP);
+        add(specularMap, useSpecularMap, SHADER_FEATURE_SPECULAR_MAP);
+        add(normalMap, useNormalMap, SHADER_FEATURE_NORMAL_MAP);
+    }
+    else
+    {
+        add(albedoMap, useAlbedoMap, SHADER_FEATURE_ALBEDO_MAP);
+        add(metallicMap, useMetallicMap, SHADER_FEATURE_METALLIC_MAP);
+        add(roughnessMap, useRoughnessMap, SHADER_FEATURE_ROUGHNESS_MAP);
+        add(aoMap, useAOMap, SHADER_FEATURE_AO_MAP);
+        add(normalMap, useNormalMap, SHADER_FEATURE_NORMAL_MAP);
+    }
+    return features;
+}
+
+void Material::RequestTextureScreenSize(float pixels) const
+{
+    auto request = [pixels](const std::shared_ptr<Texture> &texture, bool used) {
+        if (used && texture)
+            texture->RequestScreenSize(pixels);
+    };
+
+    if (type == BLINN_PHONG)
+    {
+        request(diffuseMap, useDiffuseMap);
+        request(specularMap, useSpecularMap);
+        request(normalMap, useNormalMap);
+    }
+    else
+    {
+        request(albedoMap, useAlbedoMap);
+        request(metallicMap, useMetallicMap);
+        request(roughnessMap, useRoughnessMap);
+        request(aoMap, useAOMap);
+        request(normalMap, useNormalMap);
+    }
+}
+
 void Material::Bind(Shader &shader)
 {
     shader.Use();
+    Apply(shader);
+}
+
+void Material::UnbindSamplers()
+{
+    glBindSamplers(0, MATERIAL_TEXTURE_UNITS, nullptr);
+}
+
+void Material::Apply(Shader &shader, bool bindTextures)
+{
+    const UniformCache &u = GetUniformCache(shader);
+
+    if (bindTextures)
+    {
+        // 材质贴图统一使用三线性 + 各向异性采样器，覆盖纹理对象自身的采样参数
+        GLuint sampler = Texture::GetMaterialSampler();
+        GLuint samplers[MATERIAL_TEXTURE_UNITS];
+        for (GLuint &s : samplers)
+            s = sampler;
+        glBindSamplers(0, MATERIAL_TEXTURE_UNITS, samplers);
+    }
 
     if (type == BLINN_PHONG)
     {
-        shader.SetVec3("material.diffuse", diffuse);
-        shader.SetVec3("material.specular", specular);
-        shader.SetFloat("material.shininess", shininess);
+        shader.SetVec3(u.diffuse, diffuse);
+        shader.SetVec3(u.specular, specular);
+        shader.SetFloat(u.shininess, shininess);
 
-        if (useDiffuseMap)
+        // 贴图是否启用由着色器变体决定（GetShaderFeatures），这里只绑定贴图
+        if (useDiffuseMap && diffuseMap)
         {
-            diffuseMap->Bind(1);
-            shader.SetBool("material.useDiffuseMap", 1);
-            shader.SetInt("material.diffuseMap", 1);
-        }
-        else
-        {
-            shader.SetBool("material.useDiffuseMap", 0);
+            if (bindTextures)
+                diffuseMap->Bind(1);
+            shader.SetInt(u.diffuseMap, 1);
         }
 
-        if (useSpecularMap)
+        if (useSpecularMap && specularMap)
         {
-            specularMap->Bind(2);
-            shader.SetBool("material.useSpecularMap", 1);
-            shader.SetInt("material.specularMap", 2);
-        }
-        else
-        {
-            shader.SetBool("material.useSpecularMap", 0);
+            if (bindTextures)
+                specularMap->Bind(2);
+            shader.SetInt(u.specularMap, 2);
         }
 
-        if (useNormalMap)
-        {
-            normalMap->Bind(3);
-            shader.SetBool("material.useNormalMap", 1);
-            shader.SetInt("material.normalMap", 3);
-        }
-        else
+        if (useNormalMap && normalMap)
         {
-            shader.SetBool("material.useNormalMap", 0);
+            if (bindTextures)
+                normalMap->Bind(3);
+            shader.SetInt(u.normalMap, 3);
         }
-
     }
     else
     { // PBR
-        shader.SetVec3("material.albedo", albedo);
-        shader.SetFloat("material.metallic", metallic);
-        shader.SetFloat("material.roughness", roughness);
-        shader.SetFloat("material.ao", ao);
-
-        shader.SetBool("material.useAlbedoMap", useAlbedoMap);
-        shader.SetBool("material.useMetallicMap", useMetallicMap);
-        shader.SetBool("material.useRoughnessMap", useRoughnessMap);
-        shader.SetBool("material.useAOMap", useAOMap);
-        shader.SetBool("material.useNormalMap", useNormalMap);
+        shader.SetVec3(u.albedo, albedo);
+        shader.SetFloat(u.metallic, metallic);
+        shader.SetFloat(u.roughness, roughness);
+        shader.SetFloat(u.ao, ao);
 
         if (useAlbedoMap && albedoMap)
         {
-            albedoMap->Bind(0);
-            shader.SetInt("material.albedoMap", 0);
+            if (bindTextures)
+                albedoMap->Bind(0);
+            shader.SetInt(u.albedoMap, 0);
         }
 
         if (useMetallicMap && metallicMap)
         {
-            metallicMap->Bind(1);
-            shader.SetInt("material.metallicMap", 1);
+            if (bindTextures)
+                metallicMap->Bind(1);
+            shader.SetInt(u.metallicMap, 1);
         }
 
         if (useRoughnessMap && roughnessMap)
         {
-            roughnessMap->Bind(2);
-            shader.SetInt("material.roughnessMap", 2);
+            if (bindTextures)
+                roughnessMap->Bind(2);
+            shader.SetInt(u.roughnessMap, 2);
         }
 
         if (useAOMap && aoMap)
         {
-            aoMap->Bind(3);
-            shader.SetInt("material.aoMap", 3);
+            if (bindTextures)
+                aoMap->Bind(3);
+            shader.SetInt(u.aoMap, 3);
         }
 
         if (useNormalMap && normalMap)
         {
-            normalMap->Bind(4);
-            shader.SetInt("material.normalMap", 4);
+            if (bindTextures)
+                normalMap->Bind(4);
+            shader.SetInt(u.normalMap, 4);
         }
     }
 }
\ No newline at end of file
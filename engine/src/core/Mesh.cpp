@@ -7,14 +7,33 @@ Mesh::Mesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int>
     SetupMesh();
 }
 
+Mesh::Mesh(std::vector<Vertex> &&vertices, std::vector<unsigned int> &&indices,
+           const std::shared_ptr<Material> &material, const AABB &bounds, const BoundingSphere &sphere)
+    : vertices(std::move(vertices)), indices(std::move(indices)),
+      material(material ? material : std::make_shared<Material>()), localBounds(bounds), localSphere(sphere)
+{
+    worldBounds = localBounds.Transform(modelMatrix);
+    SetupBuffers();
+}
+
 Mesh::~Mesh()
 {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
+    glDeleteVertexArrays(1, &depthVAO);
+    glDeleteBuffers(1, &positionVBO);
 }
 
 void Mesh::SetupMesh()
+{
+    localBounds = ComputeBounds(vertices);
+    localSphere = ComputeBoundingSphere(vertices, localBounds);
+    worldBounds = localBounds.Transform(modelMatrix);
+    SetupBuffers();
+}
+
+void Mesh::SetupBuffers()
 {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -49,24 +68,89 @@ void Mesh::SetupMesh()
     glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, Bitangent));
 
     glBindVertexArray(0);
+
+    // 深度绘制用的紧凑位置流：每个顶点 12 字节，而不是完整的 Vertex
+    std::vector<glm::vec3> positions;
+    positions.reserve(vertices.size());
+    for (const auto &vertex : vertices)
+    {
+        positions.push_back(vertex.Position);
+    }
+
+    glGenVertexArrays(1, &depthVAO);
+    glGenBuffers(1, &positionVBO);
+
+    glBindVertexArray(depthVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), positions.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
+
+    glBindVertexArray(0);
+}
+
+glm::mat4 Mesh::ComputeModelMatrix(const glm::vec3 &pos, const glm::vec3 &rot, const glm::vec3 &scl)
+{
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, pos);
+    model = glm::rotate(model, glm::radians(rot.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rot.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rot.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::scale(model, scl);
+    return model;
+}
+
+glm::mat3 Mesh::ComputeNormalMatrix(const glm::mat4 &model)
+{
+    return glm::transpose(glm::inverse(glm::mat3(model)));
+}
+
+void Mesh::UpdateMatrices()
+{
+    modelMatrix = ComputeModelMatrix(position, rotation, scale);
+    normalMatrix = ComputeNormalMatrix(modelMatrix);
+    worldBounds = localBounds.Transform(modelMatrix);
 }
 
 void Mesh::Draw(Shader &shader)
 {
-    material->Bind(shader);
+    Draw(shader, modelMatrix, normalMatrix);
+}
+
+void Mesh::Draw(Shader &shader, const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix)
+{
+    Draw(shader, *material, modelMatrix, normalMatrix);
+}
+
+void Mesh::Draw(Shader &shader, Material &material, const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix)
+{
+    material.Bind(shader);
 
     // 设置模型矩阵
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, position);
-    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, scale);
-
-    shader.SetMat4("model", model);
-    
+    shader.SetMat4("model", modelMatrix);
+    shader.SetMat3("normalMatrix", normalMatrix);
+
     // 绘制网格
     glBindVertexArray(VAO);
     glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+    Material::UnbindSamplers();
+}
+
+void Mesh::DrawDepthOnly(Shader &shader)
+{
+    DrawDepthOnly(shader, modelMatrix);
+}
+
+void Mesh::DrawDepthOnly(Shader &shader, const glm::mat4 &modelMatrix)
+{
+    shader.SetMat4("model", modelMatrix);
+
+    glBindVertexArray(depthVAO);
+    glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
 }
\ No newline at end of file
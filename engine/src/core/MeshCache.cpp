@@ -0,0 +1,349 @@
+#include "core/MeshCache.hpp"
+#include "core/ContentHash.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+// 文件格式、Vertex 布局或 Model 导入逻辑（材质参数、贴图选择）变化时递增
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr char CACHE_MAGIC[4] = {'A', 'M', 'S', 'H'};
+constexpr uint64_t DATA_ALIGNMENT = 16;
+
+// 贴图在材质中的位置，按下标写入缓存
+struct TextureBinding
+{
+    std::shared_ptr<Texture> Material::*map;
+    bool Material::*useFlag;
+};
+const TextureBinding TEXTURE_BINDINGS[] = {
+    {&Material::diffuseMap, &Material::useDiffuseMap},     {&Material::specularMap, &Material::useSpecularMap},
+    {&Material::normalMap, &Material::useNormalMap},       {&Material::albedoMap, &Material::useAlbedoMap},
+    {&Material::metallicMap, &Material::useMetallicMap},   {&Material::roughnessMap, &Material::useRoughnessMap},
+    {&Material::aoMap, &Material::useAOMap},
+};
+constexpr uint32_t TEXTURE_BINDING_COUNT = sizeof(TEXTURE_BINDINGS) / sizeof(TEXTURE_BINDINGS[0]);
+
+template <typename T> void WriteValue(std::ostream &out, const T &value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> bool ReadValue(std::istream &in, T &value)
+{
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void WriteString(std::ostream &out, const std::string &value)
+{
+    WriteValue(out, static_cast<uint32_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+bool ReadString(std::istream &in, std::string &value)
+{
+    uint32_t length = 0;
+    if (!ReadValue(in, length) || length > (1u << 20))
+        return false;
+    value.resize(length);
+    in.read(value.data(), length);
+    return static_cast<bool>(in);
+}
+
+uint64_t AlignUp(uint64_t value)
+{
+    return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+}
+} // namespace
+
+MeshCache &MeshCache::GetInstance()
+{
+    static MeshCache instance;
+    return instance;
+}
+
+void MeshCache::Initialize(const std::string &directory)
+{
+    this->directory = directory;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "网格缓存目录创建失败: " << directory << " 错误: " << error.message() << std::endl;
+        return;
+    }
+
+    initialized = true;
+    enabled = true;
+    std::cout << "网格缓存: " << directory << std::endl;
+}
+
+bool MeshCache::MakeKey(const std::string &path, unsigned int importFlags, uint64_t &key, int64_t &sourceTime) const
+{
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(path, error);
+    if (error)
+        return false;
+
+    sourceTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    key = ContentHash::Hash64(path.data(), path.size(), CACHE_VERSION);
+    key = ContentHash::Combine(key, static_cast<uint64_t>(sourceTime));
+    key = ContentHash::Combine(key, importFlags);
+    return true;
+}
+
+std::string MeshCache::GetFilePath(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.amsh", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool MeshCache::Load(const std::string &path, unsigned int importFlags, ModelImportData &data) const
+{
+    if (!enabled)
+        return false;
+
+    uint64_t key = 0;
+    int64_t sourceTime = 0;
+    if (!MakeKey(path, importFlags, key, sourceTime))
+        return false;
+
+    std::ifstream file(GetFilePath(key), std::ios::binary);
+    if (!file)
+        return false;
+
+    FileHeader header{};
+    std::string sourcePath;
+    if (!ReadValue(file, header) || std::memcmp(header.magic, CACHE_MAGIC, 4) != 0 ||
+        header.version != CACHE_VERSION || header.key != key || header.sourceTime != sourceTime ||
+        header.importFlags != importFlags || header.vertexSize != sizeof(Vertex) || !ReadString(file, sourcePath) ||
+        sourcePath != path)
+    {
+        return false;
+    }
+
+    std::vector<FileMesh> fileMeshes(header.meshCount);
+    file.read(reinterpret_cast<char *>(fileMeshes.data()), sizeof(FileMesh) * fileMeshes.size());
+    if (!file)
+        return false;
+
+    // 每个网格一个材质（与 Assimp 导入时相同）
+    std::vector<ModelImportData::MeshData> meshes(header.meshCount);
+    for (auto &meshData : meshes)
+    {
+        auto material = std::make_shared<Material>();
+        if (!ReadString(file, material->name) || !ReadValue(file, material->albedo) ||
+            !ReadValue(file, material->metallic) || !ReadValue(file, material->roughness))
+        {
+            return false;
+        }
+        meshData.material = material;
+    }
+
+    std::vector<ModelImportData::TextureData> textures(header.textureCount);
+    for (auto &texture : textures)
+    {
+        uint8_t srgb = 0, normalMap = 0;
+        uint32_t slotCount = 0;
+        if (!ReadString(file, texture.path) || !ReadString(file, texture.typeName) || !ReadValue(file, srgb) ||
+            !ReadValue(file, normalMap) || !ReadValue(file, slotCount))
+        {
+            return false;
+        }
+        texture.image.srgb = srgb != 0;
+        texture.image.normalMap = normalMap != 0;
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            uint32_t meshIndex = 0, binding = 0;
+            if (!ReadValue(file, meshIndex) || !ReadValue(file, binding) || meshIndex >= meshes.size() ||
+                binding >= TEXTURE_BINDING_COUNT)
+            {
+                return false;
+            }
+            texture.slots.push_back({meshes[meshIndex].material.get(), TEXTURE_BINDINGS[binding].map,
+                                     TEXTURE_BINDINGS[binding].useFlag});
+        }
+    }
+
+    // 顶点和索引整块读入，不做逐元素转换
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        const FileMesh &fileMesh = fileMeshes[i];
+        ModelImportData::MeshData &meshData = meshes[i];
+        uint64_t vertexBytes = static_cast<uint64_t>(fileMesh.vertexCount) * sizeof(Vertex);
+        uint64_t indexBytes = static_cast<uint64_t>(fileMesh.indexCount) * sizeof(unsigned int);
+        if (fileMesh.vertexOffset + vertexBytes > header.dataSize || fileMesh.indexOffset + indexBytes > header.dataSize)
+        {
+            std::cerr << "网格缓存文件损坏: " << GetFilePath(key) << std::endl;
+            return false;
+        }
+
+        meshData.vertices.resize(fileMesh.vertexCount);
+        file.seekg(static_cast<std::streamoff>(header.dataOffset + fileMesh.vertexOffset));
+        file.read(reinterpret_cast<char *>(meshData.vertices.data()), static_cast<std::streamsize>(vertexBytes));
+
+        meshData.indices.resize(fileMesh.indexCount);
+        file.seekg(static_cast<std::streamoff>(header.dataOffset + fileMesh.indexOffset));
+        file.read(reinterpret_cast<char *>(meshData.indices.data()), static_cast<std::streamsize>(indexBytes));
+        if (!file)
+            return false;
+
+        meshData.bounds.min = glm::vec3(fileMesh.boundsMin[0], fileMesh.boundsMin[1], fileMesh.boundsMin[2]);
+        meshData.bounds.max = glm::vec3(fileMesh.boundsMax[0], fileMesh.boundsMax[1], fileMesh.boundsMax[2]);
+        meshData.sphere.center =
+            glm::vec3(fileMesh.sphereCenter[0], fileMesh.sphereCenter[1], fileMesh.sphereCenter[2]);
+        meshData.sphere.radius = fileMesh.sphereRadius;
+    }
+
+    data.meshes = std::move(meshes);
+    data.textures = std::move(textures);
+    std::cout << "网格缓存命中: " << path << " 网格数: " << data.meshes.size() << std::endl;
+    return true;
+}
+
+bool MeshCache::Store(const std::string &path, unsigned int importFlags, const ModelImportData &data) const
+{
+    if (!enabled)
+        return false;
+
+    uint64_t key = 0;
+    int64_t sourceTime = 0;
+    if (!MakeKey(path, importFlags, key, sourceTime))
+        return false;
+
+    std::unordered_map<const Material *, uint32_t> materialIndices;
+    std::vector<FileMesh> fileMeshes;
+    fileMeshes.reserve(data.meshes.size());
+    uint64_t dataSize = 0;
+    for (size_t i = 0; i < data.meshes.size(); ++i)
+    {
+        const auto &meshData = data.meshes[i];
+        materialIndices.emplace(meshData.material.get(), static_cast<uint32_t>(i));
+
+        FileMesh fileMesh{};
+        fileMesh.vertexCount = static_cast<uint32_t>(meshData.vertices.size());
+        fileMesh.indexCount = static_cast<uint32_t>(meshData.indices.size());
+        fileMesh.vertexOffset = dataSize;
+        dataSize = AlignUp(dataSize + meshData.vertices.size() * sizeof(Vertex));
+        fileMesh.indexOffset = dataSize;
+        dataSize = AlignUp(dataSize + meshData.indices.size() * sizeof(unsigned int));
+        for (int c = 0; c < 3; ++c)
+        {
+            fileMesh.boundsMin[c] = meshData.bounds.min[c];
+            fileMesh.boundsMax[c] = meshData.bounds.max[c];
+            fileMesh.sphereCenter[c] = meshData.sphere.center[c];
+        }
+        fileMesh.sphereRadius = meshData.sphere.radius;
+        fileMeshes.push_back(fileMesh);
+    }
+
+    // 元数据先写入内存，确定数据区偏移后再一次写出
+    std::ostringstream meta(std::ios::binary);
+    WriteString(meta, path);
+    meta.write(reinterpret_cast<const char *>(fileMeshes.data()), sizeof(FileMesh) * fileMeshes.size());
+    for (const auto &meshData : data.meshes)
+    {
+        WriteString(meta, meshData.material->name);
+        WriteValue(meta, meshData.material->albedo);
+        WriteValue(meta, meshData.material->metallic);
+        WriteValue(meta, meshData.material->roughness);
+    }
+    for (const auto &texture : data.textures)
+    {
+        WriteString(meta, texture.path);
+        WriteString(meta, texture.typeName);
+        WriteValue(meta, static_cast<uint8_t>(texture.image.srgb));
+        WriteValue(meta, static_cast<uint8_t>(texture.image.normalMap));
+        WriteValue(meta, static_cast<uint32_t>(texture.slots.size()));
+        for (const auto &slot : texture.slots)
+        {
+            uint32_t binding = 0;
+            while (binding < TEXTURE_BINDING_COUNT && TEXTURE_BINDINGS[binding].map != slot.map)
+                ++binding;
+            auto it = materialIndices.find(slot.material);
+            if (binding == TEXTURE_BINDING_COUNT || it == materialIndices.end())
+            {
+                std::cerr << "网格缓存写入失败（未知的贴图绑定）: " << path << std::endl;
+                return false;
+            }
+            WriteValue(meta, it->second);
+            WriteValue(meta, binding);
+        }
+    }
+    const std::string metaBytes = meta.str();
+
+    FileHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.sourceTime = sourceTime;
+    header.importFlags = importFlags;
+    header.meshCount = static_cast<uint32_t>(data.meshes.size());
+    header.textureCount = static_cast<uint32_t>(data.textures.size());
+    header.vertexSize = sizeof(Vertex);
+    header.dataOffset = AlignUp(sizeof(FileHeader) + metaBytes.size());
+    header.dataSize = dataSize;
+
+    // 先写临时文件再重命名，避免其他线程读到写了一半的文件
+    std::ostringstream tempName;
+    tempName << GetFilePath(key) << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+    const std::string tempPath = tempName.str();
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "网格缓存写入失败: " << tempPath << std::endl;
+            return false;
+        }
+
+        const char padding[DATA_ALIGNMENT] = {};
+        WriteValue(file, header);
+        file.write(metaBytes.data(), static_cast<std::streamsize>(metaBytes.size()));
+        file.write(padding, static_cast<std::streamsize>(header.dataOffset - sizeof(FileHeader) - metaBytes.size()));
+
+        uint64_t written = 0;
+        for (size_t i = 0; i < data.meshes.size(); ++i)
+        {
+            const auto &meshData = data.meshes[i];
+            const FileMesh &fileMesh = fileMeshes[i];
+            file.write(padding, static_cast<std::streamsize>(fileMesh.vertexOffset - written));
+            file.write(reinterpret_cast<const char *>(meshData.vertices.data()),
+                       static_cast<std::streamsize>(meshData.vertices.size() * sizeof(Vertex)));
+            written = fileMesh.vertexOffset + meshData.vertices.size() * sizeof(Vertex);
+
+            file.write(padding, static_cast<std::streamsize>(fileMesh.indexOffset - written));
+            file.write(reinterpret_cast<const char *>(meshData.indices.data()),
+                       static_cast<std::streamsize>(meshData.indices.size() * sizeof(unsigned int)));
+            written = fileMesh.indexOffset + meshData.indices.size() * sizeof(unsigned int);
+        }
+
+        if (!file)
+        {
+            std::cerr << "网格缓存写入失败: " << tempPath << std::endl;
+            file.close();
+            // 可能在后台导入作业中执行，清理失败也不能抛出异常
+            std::error_code removeError;
+            std::filesystem::remove(tempPath, removeError);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, GetFilePath(key), error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
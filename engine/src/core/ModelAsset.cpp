@@ -0,0 +1,345 @@
+#include "core/ModelAsset.hpp"
+#include "core/Geometry.hpp"
+#include "core/JobSystem.hpp"
+#include "core/MeshCache.hpp"
+#include "core/TextureManager.hpp"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+namespace
+{
+// 导入过程中的临时状态
+struct ImportContext
+{
+    ModelImportData &data;
+    std::string directory;
+    std::unordered_map<std::string, size_t> textureIndices; // 贴图路径 -> data.textures 下标
+};
+
+// Assimp 后处理选项，也是网格缓存键的一部分
+constexpr unsigned int IMPORT_FLAGS =
+    aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace | aiProcess_FlipUVs;
+
+void RequestMaterialTexture(ImportContext &context, aiMaterial *mat, aiTextureType type, const std::string &typeName,
+                            Material *material, std::shared_ptr<Texture> Material::*map, bool Material::*useFlag)
+{
+    // 每种类型只使用第一张贴图
+    if (mat->GetTextureCount(type) == 0)
+        return;
+
+    aiString str;
+    mat->GetTexture(type, 0, &str);
+
+    std::string filename = std::string(str.C_Str());
+    filename = context.directory + '/' + filename;
+
+#ifdef _WIN32
+    std::replace(filename.begin(), filename.end(), '\\', '/'); // 替换Windows路径分隔符
+#endif
+
+    // Check if the file exists
+    if (!std::filesystem::exists(filename))
+    {
+        std::cerr << "ERROR: Texture file does not exist at path: " << filename << std::endl;
+        return;
+    }
+
+    auto it = context.textureIndices.find(filename);
+    size_t index;
+    if (it != context.textureIndices.end())
+    {
+        index = it->second;
+    }
+    else
+    {
+        index = context.data.textures.size();
+        context.data.textures.emplace_back();
+        context.data.textures[index].path = filename;
+        context.data.textures[index].typeName = typeName;
+        // 颜色贴图按 sRGB 处理，其余（法线、金属度等）是线性数据
+        context.data.textures[index].image.srgb = typeName == "texture_diffuse" || typeName == "texture_albedo";
+        context.data.textures[index].image.normalMap = typeName == "texture_normal";
+        context.textureIndices.emplace(filename, index);
+    }
+    context.data.textures[index].slots.push_back({material, map, useFlag});
+}
+
+std::shared_ptr<Material> LoadMaterial(ImportContext &context, aiMaterial *mat)
+{
+    auto material = std::make_shared<Material>();
+    
+    if (!mat)
+    {
+        std::cerr << "ERROR::ASSIMP::Material is null!" << std::endl;
+        return material;
+    }
+    aiString name;
+    mat->Get(AI_MATKEY_NAME, name); // name经常读取到空字符串
+    if (name.length == 0)
+    {
+        name.Set("Default Material");
+    }
+    material->name = name.C_Str();
+
+    Material *m = material.get();
+
+    // 漫反射、镜面反射、法线贴图（高度贴图通道在常见格式中存放的是法线）
+    RequestMaterialTexture(context, mat, aiTextureType_DIFFUSE, "texture_diffuse", m, &Material::diffuseMap,
+                           &Material::useDiffuseMap);
+    RequestMaterialTexture(context, mat, aiTextureType_SPECULAR, "texture_specular", m, &Material::specularMap,
+                           &Material::useSpecularMap);
+    RequestMaterialTexture(context, mat, aiTextureType_HEIGHT, "texture_normal", m, &Material::normalMap,
+                           &Material::useNormalMap);
+
+    // 加载金属度/粗糙度 (PBR)
+    aiColor3D color;
+    if (mat->Get(AI_MATKEY_COLOR_DIFFUSE, color) == AI_SUCCESS)
+    {
+        material->albedo = glm::vec3(color.r, color.g, color.b);
+    }
+
+    float metallic, roughness;
+    if (mat->Get(AI_MATKEY_METALLIC_FACTOR, metallic) == AI_SUCCESS)
+    {
+        material->metallic = metallic;
+    }
+
+    if (mat->Get(AI_MATKEY_ROUGHNESS_FACTOR, roughness) == AI_SUCCESS)
+    {
+        material->roughness = roughness;
+    }
+
+    // 如果PBR使用贴图
+    RequestMaterialTexture(context, mat, aiTextureType_BASE_COLOR, "texture_albedo", m, &Material::albedoMap,
+                           &Material::useAlbedoMap);
+    RequestMaterialTexture(context, mat, aiTextureType_METALNESS, "texture_metallic", m, &Material::metallicMap,
+                           &Material::useMetallicMap);
+    RequestMaterialTexture(context, mat, aiTextureType_DIFFUSE_ROUGHNESS, "texture_roughness", m,
+                           &Material::roughnessMap, &Material::useRoughnessMap);
+    RequestMaterialTexture(context, mat, aiTextureType_AMBIENT_OCCLUSION, "texture_ao", m, &Material::aoMap,
+                           &Material::useAOMap);
+    return material;
+}
+
+ModelImportData::MeshData ProcessMesh(ImportContext &context, aiMesh *mesh, const aiScene *scene)
+{
+    ModelImportData::MeshData meshData;
+    std::vector<Vertex> &vertices = meshData.vertices;
+    std::vector<unsigned int> &indices = meshData.indices;
+    vertices.reserve(mesh->mNumVertices);
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
+
+    // 处理顶点
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+    {
+        Vertex vertex;
+
+        // 位置
+        vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+
+        // 法线
+        if (mesh->HasNormals())
+        {
+            vertex.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+        }
+
+        // 纹理坐标
+        if (mesh->mTextureCoords[0])
+        {
+            vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+        }
+        else
+        {
+            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+        }
+
+        // 切线
+        if (mesh->HasTangentsAndBitangents())
+        {
+            vertex.Tangent = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+
+            vertex.Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+        }
+
+        vertices.push_back(vertex);
+    }
+
+    // 处理索引
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+    {
+        aiFace face = mesh->mFaces[i];
+        for (unsigned int j = 0; j < face.mNumIndices; j++)
+        {
+            indices.push_back(face.mIndices[j]);
+        }
+    }
+
+    meshData.bounds = ComputeBounds(vertices);
+    meshData.sphere = ComputeBoundingSphere(vertices, meshData.bounds);
+
+    // 处理材质
+    if (mesh->mMaterialIndex >= 0)
+    {
+        aiMaterial *aiMat = scene->mMaterials[mesh->mMaterialIndex];
+        meshData.material = LoadMaterial(context, aiMat);
+    }
+    else
+    {
+        meshData.material = std::make_shared<Material>();
+    }
+
+    return meshData;
+}
+
+void ProcessNode(ImportContext &context, aiNode *node, const aiScene *scene)
+{
+    for (unsigned int i = 0; i < node->mNumMeshes; i++)
+    {
+        aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
+        context.data.meshes.push_back(ProcessMesh(context, mesh, scene));
+    }
+
+    for (unsigned int i = 0; i < node->mNumChildren; i++)
+    {
+        ProcessNode(context, node->mChildren[i], scene);
+    }
+}
+} // namespace
+
+std::shared_ptr<ModelAsset> ModelAsset::Load(const std::string &path)
+{
+    std::shared_ptr<ModelAsset> asset(new ModelAsset());
+    asset->path = path;
+
+    auto data = Import(path);
+    if (!data->success)
+    {
+        asset->loadState = LOAD_FAILED;
+        return asset;
+    }
+    while (!asset->UploadStep(*data))
+    {
+    }
+    return asset;
+}
+
+std::shared_ptr<ModelAsset> ModelAsset::CreatePlaceholder(const std::string &path)
+{
+    std::shared_ptr<ModelAsset> asset(new ModelAsset());
+    asset->path = path;
+    asset->loadState = LOAD_PENDING;
+
+    // 占位网格：灰色立方体，导入完成前代替真实模型显示
+    auto placeholder = Geometry::CreateCube();
+    placeholder->GetMaterial()->diffuse = glm::vec3(0.5f);
+    placeholder->GetMaterial()->name = "Loading";
+    asset->meshes.push_back(placeholder);
+    return asset;
+}
+
+std::shared_ptr<ModelImportData> ModelAsset::Import(const std::string &path)
+{
+    auto data = std::make_shared<ModelImportData>();
+    data->path = path;
+
+    // 网格缓存命中时直接得到最终的顶点、索引、材质和包围体
+    MeshCache &cache = MeshCache::GetInstance();
+    if (!cache.Load(path, IMPORT_FLAGS, *data))
+    {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path, IMPORT_FLAGS);
+
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        {
+            std::cerr << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
+            return data;
+        }
+
+        ImportContext context{*data};
+        // 第一个\\或者/
+        context.directory = path.substr(0, path.find_last_of("\\/"));
+        ProcessNode(context, scene->mRootNode, scene);
+
+        cache.Store(path, IMPORT_FLAGS, *data);
+    }
+
+    // 贴图解码互不依赖，分发到作业系统并行执行（模型贴图不翻转）；
+    // 异步导入时运行在后台线程，解码作业也留在后台队列，不会被主线程的 Wait 执行
+    JobSystem::GetInstance().ParallelFor(0, data->textures.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Texture::DecodeFile(data->textures[i].path, false, data->textures[i].image);
+        }
+    });
+
+    data->success = true;
+    return data;
+}
+
+bool ModelAsset::UploadStep(ModelImportData &data)
+{
+    // 先上传贴图，保证网格出现时材质已经完整
+    if (uploadTextureIndex < data.textures.size())
+    {
+        auto &textureData = data.textures[uploadTextureIndex++];
+        if (textureData.image.IsValid())
+        {
+            // 经由 TextureManager 上传，其他模型或材质已加载过的同一贴图直接共享（模型贴图不翻转）
+            auto texture = TextureManager::GetInstance().AddTexture(textureData.path, false, textureData.image);
+            if (texture)
+            {
+                texture->type = textureData.typeName;
+                texturesLoaded.push_back(texture);
+                for (const auto &slot : textureData.slots)
+                {
+                    slot.material->*slot.map = texture;
+                    slot.material->*slot.useFlag = true;
+                }
+            }
+        }
+        textureData.image = TextureImage(); // 上传后释放 CPU 端像素
+        return false;
+    }
+
+    if (uploadMeshIndex < data.meshes.size())
+    {
+        auto &meshData = data.meshes[uploadMeshIndex++];
+        auto &material = meshData.material;
+
+        // 设置材质类型
+        if (!material->albedoMap && !material->metallicMap && !material->roughnessMap && !material->aoMap)
+        {
+            material->type = BLINN_PHONG;
+        }
+        else
+        {
+            material->type = PBR;
+        }
+
+        pendingMeshes.push_back(std::make_shared<Mesh>(std::move(meshData.vertices), std::move(meshData.indices),
+                                                       material, meshData.bounds, meshData.sphere));
+        meshData = ModelImportData::MeshData();
+        if (uploadMeshIndex < data.meshes.size())
+            return false;
+    }
+
+    // 全部上传完成，替换占位网格
+    meshes = std::move(pendingMeshes);
+    pendingMeshes.clear();
+    loadState = LOAD_RESIDENT;
+    ++version;
+    return true;
+}
+
+void ModelAsset::MarkLoadFailed()
+{
+    meshes.clear();
+    pendingMeshes.clear();
+    loadState = LOAD_FAILED;
+    ++version;
+}
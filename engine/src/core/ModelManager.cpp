@@ -0,0 +1,155 @@
+#include "core/ModelManager.hpp"
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+ModelManager& ModelManager::GetInstance()
+{
+    static ModelManager instance;
+    return instance;
+}
+
+std::shared_ptr<ModelAsset> ModelManager::FindCached(const std::string& path)
+{
+    auto it = assetCache.find(path);
+    if (it == assetCache.end())
+        return nullptr;
+
+    auto asset = it->second.lock();
+    if (!asset)
+    {
+        assetCache.erase(it);
+        return nullptr;
+    }
+    // 加载失败的资源不复用，允许重新导入（文件可能已修复）
+    if (asset->GetLoadState() == ModelAsset::LOAD_FAILED)
+        return nullptr;
+    return asset;
+}
+
+std::shared_ptr<ModelAsset> ModelManager::Load(const std::string& path)
+{
+    if (auto cached = FindCached(path))
+    {
+        // 调用者（如场景加载）随后要读取网格和材质，不能拿到占位资源
+        if (cached->GetLoadState() == ModelAsset::LOAD_PENDING)
+            FinishPending(cached);
+        return cached;
+    }
+
+    auto asset = ModelAsset::Load(path);
+    assetCache[path] = asset;
+    return asset;
+}
+
+std::shared_ptr<ModelAsset> ModelManager::LoadAsync(const std::string& path)
+{
+    if (auto cached = FindCached(path))
+        return cached;
+
+    auto asset = ModelAsset::CreatePlaceholder(path);
+    assetCache[path] = asset;
+
+    auto task = std::make_shared<ImportTask>();
+    task->counter = std::make_shared<JobCounter>();
+    pendingLoads.push_back({asset, task});
+
+    // 导入可能耗时数秒，放入后台队列，主线程的 Wait 不会执行它
+    JobSystem::GetInstance().ScheduleBackground(
+        [task, path]() {
+            task->data = ModelAsset::Import(path);
+            task->ready.store(true, std::memory_order_release);
+        },
+        task->counter);
+    return asset;
+}
+
+void ModelManager::FinishPending(const std::shared_ptr<ModelAsset>& asset)
+{
+    auto it = std::find_if(pendingLoads.begin(), pendingLoads.end(),
+                           [&asset](const PendingLoad &load) { return load.asset == asset; });
+    if (it == pendingLoads.end())
+        return;
+
+    // 后台作业可能还在排队，Wait 期间当前线程只执行帧内作业
+    PendingLoad load = std::move(*it);
+    pendingLoads.erase(it);
+    JobSystem::GetInstance().Wait(load.task->counter);
+
+    if (!load.task->data || !load.task->data->success)
+    {
+        std::cerr << "Failed to load model: " << asset->GetPath() << std::endl;
+        asset->MarkLoadFailed();
+        return;
+    }
+    ModelImportData &data = *load.task->data;
+    while (!asset->UploadStep(data))
+    {
+    }
+    std::cout << "Model loaded: " << data.path << " (" << asset->GetMeshes().size() << " meshes)" << std::endl;
+}
+
+void ModelManager::ProcessUploads(float budgetMs)
+{
+    if (pendingLoads.empty())
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    for (auto it = pendingLoads.begin(); it != pendingLoads.end();)
+    {
+        if (!it->task->ready.load(std::memory_order_acquire))
+        {
+            ++it;
+            continue;
+        }
+
+        ModelAsset &asset = *it->asset;
+        ModelImportData &data = *it->task->data;
+
+        // 导入期间引用该资源的实例都已被移出场景，直接丢弃
+        if (it->asset.use_count() == 1)
+        {
+            it = pendingLoads.erase(it);
+            continue;
+        }
+
+        if (!data.success)
+        {
+            std::cerr << "Failed to load model: " << data.path << std::endl;
+            asset.MarkLoadFailed();
+            it = pendingLoads.erase(it);
+            continue;
+        }
+
+        // 每帧至少推进一步，之后在预算内继续上传
+        bool finished = asset.UploadStep(data);
+        while (!finished && elapsedMs() < budgetMs)
+        {
+            finished = asset.UploadStep(data);
+        }
+
+        if (!finished)
+            break;
+
+        std::cout << "Model loaded: " << data.path << " (" << asset.GetMeshes().size() << " meshes)" << std::endl;
+        it = pendingLoads.erase(it);
+        if (elapsedMs() >= budgetMs)
+            break;
+    }
+}
+
+size_t ModelManager::GetAssetCount() const
+{
+    size_t count = 0;
+    for (const auto &[path, asset] : assetCache)
+    {
+        if (!asset.expired())
+            ++count;
+    }
+    return count;
+}
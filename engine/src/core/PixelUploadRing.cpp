@@ -0,0 +1,105 @@
+#include "core/PixelUploadRing.hpp"
+#include <iostream>
+
+namespace
+{
+constexpr size_t UPLOAD_ALIGNMENT = 16;
+}
+
+PixelUploadRing::PixelUploadRing(size_t segmentSize, int segmentCount)
+    : segmentSize(segmentSize), segmentCount(segmentCount), fences(segmentCount, nullptr)
+{
+    GLsizeiptr totalSize = static_cast<GLsizeiptr>(segmentSize * segmentCount);
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &ID);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, totalSize, nullptr, flags);
+    mappedBase = static_cast<unsigned char *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, totalSize, flags));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!mappedBase)
+    {
+        std::cerr << "PixelUploadRing: failed to map pixel unpack buffer, falling back to direct uploads" << std::endl;
+    }
+}
+
+PixelUploadRing::~PixelUploadRing()
+{
+    for (auto &fence : fences)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
+
+    if (ID != 0)
+    {
+        if (mappedBase)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &ID);
+        ID = 0;
+    }
+}
+
+bool PixelUploadRing::Allocate(size_t size, size_t &offset, void *&mapped)
+{
+    if (!mappedBase)
+        return false;
+
+    size_t alignedUsed = (used + UPLOAD_ALIGNMENT - 1) & ~(UPLOAD_ALIGNMENT - 1);
+    if (alignedUsed + size > segmentSize)
+        return false;
+
+    // 本帧第一次写入该段：等待上一轮对该段的传输完成
+    if (!segmentAcquired)
+    {
+        WaitForSegment(current);
+        segmentAcquired = true;
+    }
+
+    offset = static_cast<size_t>(current) * segmentSize + alignedUsed;
+    mapped = mappedBase + offset;
+    used = alignedUsed + size;
+    return true;
+}
+
+void PixelUploadRing::EndFrame()
+{
+    if (used == 0)
+        return;
+
+    fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    current = (current + 1) % segmentCount;
+    used = 0;
+    segmentAcquired = false;
+}
+
+void PixelUploadRing::Bind() const
+{
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, ID);
+}
+
+void PixelUploadRing::Unbind()
+{
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void PixelUploadRing::WaitForSegment(int index)
+{
+    GLsync &fence = fences[index];
+    if (!fence)
+        return;
+
+    // 正常情况下段在两帧前提交，早已完成；最多等待 1 秒
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+    {
+        std::cerr << "PixelUploadRing: timed out waiting for upload segment " << index << std::endl;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
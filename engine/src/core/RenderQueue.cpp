@@ -0,0 +1,234 @@
+#include "core/RenderQueue.hpp"
+#include "core/LightBuffer.hpp"
+#include <algorithm>
+
+namespace
+{
+constexpr int PASS_SHIFT = 60;
+constexpr int SHADER_SHIFT = 52;
+constexpr int TEXTURE_SET_SHIFT = 36;
+constexpr int MATERIAL_SHIFT = 22;
+constexpr int MESH_SHIFT = 10;
+
+constexpr uint64_t PASS_MASK = (1ull << 4) - 1;
+constexpr uint64_t SHADER_MASK = (1ull << 8) - 1;
+constexpr uint64_t TEXTURE_SET_MASK = (1ull << 16) - 1;
+constexpr uint64_t MATERIAL_MASK = (1ull << 14) - 1;
+constexpr uint64_t MESH_MASK = (1ull << 12) - 1;
+constexpr uint64_t DEPTH_MASK = (1ull << 10) - 1;
+
+uint64_t Field(uint64_t value, uint64_t mask, int shift)
+{
+    return std::min(value, mask) << shift;
+}
+} // namespace
+
+RenderQueue::~RenderQueue()
+{
+    if (instanceBuffer)
+        glDeleteBuffers(1, &instanceBuffer);
+}
+
+void RenderQueue::Clear()
+{
+    packets.clear();
+    order.clear();
+    shaders.clear();
+    shaderIndices.clear();
+    textureSetIndices.clear();
+    materialIndices.clear();
+    meshIndices.clear();
+}
+
+void RenderQueue::SetView(const glm::vec3 &viewPos, float farPlane)
+{
+    this->viewPos = viewPos;
+    this->farPlane = std::max(farPlane, 0.001f);
+}
+
+void RenderQueue::Add(Shader &shader, Mesh &mesh, Material &material, const glm::mat4 &world, const glm::mat3 &normal,
+                      Pass pass)
+{
+    if (mesh.GetIndexCount() == 0)
+        return;
+
+    DrawPacket packet;
+    packet.shader = &shader;
+    packet.material = &material;
+    packet.textureSet = material.GetTextureSetHash();
+    packet.vao = mesh.GetVAO();
+    packet.indexCount = mesh.GetIndexCount();
+    packet.world = &world;
+    packet.normal = &normal;
+
+    // 以物体原点到相机的距离近似深度，不透明物体由近到远绘制以减少过度绘制；
+    // 深度位于网格之后，同一网格的实例保持连续以便合并
+    glm::vec3 origin = glm::vec3(world[3]);
+    float depth = glm::clamp(glm::length(origin - viewPos) / farPlane, 0.0f, 1.0f);
+
+    packet.sortKey = Field(pass, PASS_MASK, PASS_SHIFT) | Field(GetShaderIndex(&shader), SHADER_MASK, SHADER_SHIFT) |
+                     Field(GetTextureSetIndex(packet.textureSet), TEXTURE_SET_MASK, TEXTURE_SET_SHIFT) |
+                     Field(GetMaterialIndex(&material), MATERIAL_MASK, MATERIAL_SHIFT) |
+                     Field(GetMeshIndex(packet.vao), MESH_MASK, MESH_SHIFT) |
+                     static_cast<uint64_t>(depth * DEPTH_MASK);
+
+    packets.push_back(packet);
+}
+
+void RenderQueue::Sort()
+{
+    order.resize(packets.size());
+    for (size_t i = 0; i < packets.size(); ++i)
+        order[i] = {packets[i].sortKey, static_cast<uint32_t>(i)};
+    std::sort(order.begin(), order.end());
+}
+
+void RenderQueue::Submit()
+{
+    stats = Stats();
+    if (order.size() != packets.size())
+        Sort();
+    if (order.empty())
+        return;
+
+    UploadInstances();
+
+    Shader *currentShader = nullptr;
+    Material *currentMaterial = nullptr;
+    size_t currentTextureSet = 0;
+    bool texturesBound = false;
+    unsigned int currentVAO = 0;
+
+    for (size_t first = 0; first < order.size();)
+    {
+        const DrawPacket &packet = packets[order[first].second];
+
+        // 着色器、材质和网格都相同的连续绘制包合并为一次实例化绘制
+        size_t last = first + 1;
+        while (last < order.size())
+        {
+            const DrawPacket &next = packets[order[last].second];
+            if (next.shader != packet.shader || next.material != packet.material || next.vao != packet.vao ||
+                next.indexCount != packet.indexCount)
+                break;
+            ++last;
+        }
+        GLsizei instanceCount = static_cast<GLsizei>(last - first);
+
+        if (packet.shader != currentShader)
+        {
+            currentShader = packet.shader;
+            currentShader->Use();
+            currentShader->SetBool(shaders[shaderIndices[currentShader]].useInstanceData, true);
+            currentMaterial = nullptr; // uniform 属于程序对象，切换程序后需要重新设置材质
+            ++stats.programBinds;
+        }
+
+        if (packet.material != currentMaterial)
+        {
+            // 贴图单元是全局状态，贴图组合未变化时只更新材质 uniform
+            bool bindTextures = !texturesBound || packet.textureSet != currentTextureSet;
+            packet.material->Apply(*currentShader, bindTextures);
+            if (bindTextures)
+            {
+                currentTextureSet = packet.textureSet;
+                texturesBound = true;
+                ++stats.textureSetBinds;
+            }
+            currentMaterial = packet.material;
+            ++stats.materialBinds;
+        }
+
+        if (packet.vao != currentVAO)
+        {
+            glBindVertexArray(packet.vao);
+            currentVAO = packet.vao;
+            ++stats.vaoBinds;
+        }
+
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(packet.indexCount), GL_UNSIGNED_INT, 0,
+                                            instanceCount, static_cast<GLuint>(first));
+        ++stats.drawCalls;
+        stats.instances += instanceCount;
+        if (instanceCount > 1)
+            ++stats.instancedBatches;
+
+        first = last;
+    }
+
+    glBindVertexArray(0);
+    Material::UnbindSamplers();
+
+    // 队列之外的绘制（编辑器、阴影等）仍使用 model / normalMatrix uniform
+    for (const auto &entry : shaders)
+    {
+        entry.shader->Use();
+        entry.shader->SetBool(entry.useInstanceData, false);
+    }
+}
+
+void RenderQueue::UploadInstances()
+{
+    instanceData.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const DrawPacket &packet = packets[order[i].second];
+        instanceData[i].model = *packet.world;
+        instanceData[i].normalMatrix = glm::mat4(*packet.normal);
+    }
+
+    if (!instanceBuffer)
+        glGenBuffers(1, &instanceBuffer);
+
+    // 每帧整体重新分配（孤立旧存储），避免等待上一帧仍在使用的缓冲
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, instanceBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, instanceData.size() * sizeof(InstanceTransform), instanceData.data(),
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INSTANCE_DATA_BINDING, instanceBuffer);
+}
+
+uint32_t RenderQueue::GetShaderIndex(Shader *shader)
+{
+    auto it = shaderIndices.find(shader);
+    if (it != shaderIndices.end())
+        return it->second;
+
+    uint32_t index = static_cast<uint32_t>(shaders.size());
+    shaders.push_back({shader, shader->GetUniformHandle("useInstanceData")});
+    shaderIndices.emplace(shader, index);
+    return index;
+}
+
+uint32_t RenderQueue::GetTextureSetIndex(size_t textureSetHash)
+{
+    auto it = textureSetIndices.find(textureSetHash);
+    if (it != textureSetIndices.end())
+        return it->second;
+
+    uint32_t index = static_cast<uint32_t>(textureSetIndices.size());
+    textureSetIndices.emplace(textureSetHash, index);
+    return index;
+}
+
+uint32_t RenderQueue::GetMaterialIndex(const Material *material)
+{
+    auto it = materialIndices.find(material);
+    if (it != materialIndices.end())
+        return it->second;
+
+    uint32_t index = static_cast<uint32_t>(materialIndices.size());
+    materialIndices.emplace(material, index);
+    return index;
+}
+
+uint32_t RenderQueue::GetMeshIndex(unsigned int vao)
+{
+    auto it = meshIndices.find(vao);
+    if (it != meshIndices.end())
+        return it->second;
+
+    uint32_t index = static_cast<uint32_t>(meshIndices.size());
+    meshIndices.emplace(vao, index);
+    return index;
+}
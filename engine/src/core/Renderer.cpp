@@ -1,11 +1,15 @@
 #include "core/Renderer.hpp"
 #include "core/Camera.hpp"
+#include "core/ContentHash.hpp"
 #include "core/Framebuffer.hpp"
+#include "core/ShaderCache.hpp"
+#include <chrono>
 #include <fstream>
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 #include <iostream>
 #include <random>
+#include <unordered_set>
 #include "utils/FileSystem.hpp"
 #include "core/Texture.hpp"
 #include "core/TextureManager.hpp"
@@ -59,13 +63,15 @@ void Renderer::SaveScene(const std::string& path)
         };
         // 保存模型的材质信息
         modelJson["materials"] = json::array();
-        const auto& meshes = model->GetMeshes();
-        for (size_t i = 0; i < meshes.size(); ++i) {
-            const auto& materialPtr = meshes[i]->GetMaterial();
+        // override 为 true 表示该实例独有的材质，否则是同一模型文件的所有实例共享的材质
+        const auto& materials = model->GetMaterials();
+        for (size_t i = 0; i < materials.size(); ++i) {
+            const auto& materialPtr = materials[i];
             if (materialPtr) {
                 const auto& material = *materialPtr;
                 json materialJson = {
                     {"meshIndex", i},
+                    {"override", model->HasMaterialOverride(i)},
                     {"type", static_cast<int>(material.type)},
                     {"albedo", {material.albedo.r, material.albedo.g, material.albedo.b}},
                     {"metallic", material.metallic},
@@ -291,6 +297,10 @@ void Renderer::SaveScene(const std::string& path)
     j["renderSettings"] = {
         {"renderMode", static_cast<int>(currentMode)},
         {"shadowEnabled", shadowEnabled},
+        {"shadowCascades", cascadedShadowMap ? cascadedShadowMap->GetCascadeCount() : 3},
+        {"shadowSplitLambda", cascadedShadowMap ? cascadedShadowMap->GetSplitLambda() : 0.75f},
+        {"shadowDistance", cascadedShadowMap ? cascadedShadowMap->GetShadowDistance() : 100.0f},
+        {"shadowResolution", cascadedShadowMap ? cascadedShadowMap->GetResolution() : 1024},
         {"hdrEnabled", hdrEnabled},
         {"bloomEnabled", bloomEnabled},
         {"ssaoEnabled", ssaoEnabled},
@@ -371,7 +381,8 @@ void Renderer::LoadScene(const std::string& path)
                         try {
                             size_t meshIndex = materialData["meshIndex"].get<size_t>();
                             if (meshIndex < meshes.size()) {
-                                auto materialPtr = meshes[meshIndex]->GetMaterial();
+                                bool overridden = materialData.contains("override") && materialData["override"].get<bool>();
+                                auto materialPtr = overridden ? model->OverrideMaterial(meshIndex) : model->GetMaterial(meshIndex);
                                 if (materialPtr) {
                                     // 更新材质属性
                                     if (materialData.contains("type")) {
@@ -430,7 +441,7 @@ void Renderer::LoadScene(const std::string& path)
                                         !materialData["albedoMapPath"].get<std::string>().empty()) {
                                         std::string texturePath = toAbsolutePath(materialData["albedoMapPath"].get<std::string>());
                                         bool flipY = materialData.contains("albedoMapFlipY") ? materialData["albedoMapFlipY"].get<bool>() : true;
-                                        materialPtr->albedoMap = TextureManager::GetInstance().GetTexture(texturePath, flipY);
+                                        materialPtr->albedoMap = TextureManager::GetInstance().GetTexture(texturePath, flipY, true);
                                     }
                                     if (materialData.contains("metallicMapPath") && 
                                         !materialData["metallicMapPath"].get<std::string>().empty()) {
@@ -448,7 +459,7 @@ void Renderer::LoadScene(const std::string& path)
                                         !materialData["normalMapPath"].get<std::string>().empty()) {
                                         std::string texturePath = toAbsolutePath(materialData["normalMapPath"].get<std::string>());
                                         bool flipY = materialData.contains("normalMapFlipY") ? materialData["normalMapFlipY"].get<bool>() : true;
-                                        materialPtr->normalMap = TextureManager::GetInstance().GetTexture(texturePath, flipY);
+                                        materialPtr->normalMap = TextureManager::GetInstance().GetTexture(texturePath, flipY, false, true);
                                     }
                                     if (materialData.contains("aoMapPath") && 
                                         !materialData["aoMapPath"].get<std::string>().empty()) {
@@ -460,7 +471,7 @@ void Renderer::LoadScene(const std::string& path)
                                         !materialData["diffuseMapPath"].get<std::string>().empty()) {
                                         std::string texturePath = toAbsolutePath(materialData["diffuseMapPath"].get<std::string>());
                                         bool flipY = materialData.contains("diffuseMapFlipY") ? materialData["diffuseMapFlipY"].get<bool>() : true;
-                                        materialPtr->diffuseMap = TextureManager::GetInstance().GetTexture(texturePath, flipY);
+                                        materialPtr->diffuseMap = TextureManager::GetInstance().GetTexture(texturePath, flipY, true);
                                     }
                                     if (materialData.contains("specularMapPath") && 
                                         !materialData["specularMapPath"].get<std::string>().empty()) {
@@ -627,7 +638,7 @@ void Renderer::LoadScene(const std::string& path)
                         std::string texturePath = toAbsolutePath(mat["diffuseMapPath"].get<std::string>());
                         bool flipY = mat.contains("diffuseMapFlipY") ? mat["diffuseMapFlipY"].get<bool>() : true;
                         std::cout << "正在加载几何体diffuse贴图: " << texturePath << " (flipY=" << flipY << ")" << std::endl;
-                        defaultMaterial.diffuseMap = TextureManager::GetInstance().GetTexture(texturePath, flipY);
+                        defaultMaterial.diffuseMap = TextureManager::GetInstance().GetTexture(texturePath, flipY, true);
                     }
                     if (mat.contains("specularMapPath") && !mat["specularMapPath"].get<std::string>().empty()) {
                         std::string texturePath = toAbsolutePath(mat["specularMapPath"].get<std::string>());
@@ -638,7 +649,7 @@ void Renderer::LoadScene(const std::string& path)
                     if (mat.contains("normalMapPath") && !mat["normalMapPath"].get<std::string>().empty()) {
                         std::string texturePath = toAbsolutePath(mat["normalMapPath"].get<std::string>());
                         bool flipY = mat.contains("normalMapFlipY") ? mat["normalMapFlipY"].get<bool>() : true;
-                        defaultMaterial.normalMap = TextureManager::GetInstance().GetTexture(texturePath, flipY);
+                        defaultMaterial.normalMap = TextureManager::GetInstance().GetTexture(texturePath, flipY, false, true);
                     }
                 }
                 
@@ -775,6 +786,12 @@ void Renderer::LoadScene(const std::string& path)
                 SetRenderMode(static_cast<RenderMode>(settings["renderMode"].get<int>()));
             }
             if (settings.contains("shadowEnabled")) SetShadow(settings["shadowEnabled"]);
+            if (cascadedShadowMap) {
+                if (settings.contains("shadowCascades")) cascadedShadowMap->SetCascadeCount(settings["shadowCascades"]);
+                if (settings.contains("shadowSplitLambda")) cascadedShadowMap->SetSplitLambda(settings["shadowSplitLambda"]);
+                if (settings.contains("shadowDistance")) cascadedShadowMap->SetShadowDistance(settings["shadowDistance"]);
+                if (settings.contains("shadowResolution")) cascadedShadowMap->SetResolution(settings["shadowResolution"]);
+            }
             if (settings.contains("hdrEnabled")) SetHDR(settings["hdrEnabled"]);
             if (settings.contains("bloomEnabled")) SetBloom(settings["bloomEnabled"]);
             if (settings.contains("ssaoEnabled")) SetSSAO(settings["ssaoEnabled"]);
@@ -831,6 +848,10 @@ Renderer::~Renderer()
     
     // 清理多光源阴影缓冲区
     ClearLightShadowBuffers();
+
+    frameDataBuffer.reset();
+    lightBuffer.reset();
+    lightClusters.reset();
     
     for (auto &model : models)
     {
@@ -864,7 +885,9 @@ Renderer::~Renderer()
     }
     primitives.clear();
     gBuffer.reset();
-    shadowBuffer.reset();
+    gBufferDebugBuffer.reset();
+    shadowAtlas.reset();
+    cascadedShadowMap.reset();
     hdrBuffer.reset();
     hdrBufferMS.reset();
     bloomPrefilterBuffer.reset();
@@ -873,11 +896,12 @@ Renderer::~Renderer()
         blurBuffer.reset();
     }
     ssaoBuffer.reset();
-    forwardShader.reset();
-    pbrShader.reset();
-    deferredGeometryShader.reset();
-    deferredLightingShader.reset();
-    pbrDeferredGeometryShader.reset();
+    forwardShaders.reset();
+    pbrShaders.reset();
+    deferredGeometryShaders.reset();
+    deferredLightingShaders.reset();
+    pbrDeferredGeometryShaders.reset();
+    tiledLightingShaders.reset();
     shadowDepthShader.reset();
     skyboxShader.reset();
     hdrShader.reset();
@@ -886,6 +910,7 @@ Renderer::~Renderer()
     bloomPreShader.reset();
     bloomBlurShader.reset();
     ssaoShader.reset();
+    gBufferDebugShader.reset();
     equirectangularToCubemapShader.reset();
     irradianceShader.reset();
     prefilterShader.reset();
@@ -904,11 +929,26 @@ void Renderer::EndFrame()
 {
 }
 
+void Renderer::PresentViewport(int windowWidth, int windowHeight)
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, viewportBuffer->GetID());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 void Renderer::Update(float deltaTime)
 {
+    frameTime += deltaTime;
+    frameDeltaTime = deltaTime;
+
     // 更新相机
     mainCamera->Update(deltaTime);
 
+    // 上传已完成导入的异步模型和已解码的异步纹理
+    ProcessModelUploads();
+    TextureManager::GetInstance().ProcessUploads();
+
     // // 更新光源
     // for (auto &light : lights)
     // {
@@ -930,24 +970,44 @@ void Renderer::Update(float deltaTime)
 
 void Renderer::Initialize()
 {
-    // 加载着色器
-    forwardShader = std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/forward/blinn_phong.vert"),
-                                             FileSystem::GetPath("resources/shaders/forward/blinn_phong.frag"));
+    // 提交所有着色器的编译（统计耗时，用于比较着色器缓存冷启动和热启动）；
+    // 编译在驱动中并行进行，IBL 预计算用到的着色器在第一次使用时等待完成，
+    // 场景着色器在渲染循环中逐帧检查，编辑器窗口不必等待全部编译结束
+    shaderLoadStart = std::chrono::steady_clock::now();
 
-    pbrShader = std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/forward/pbr.vert"),
-                                         FileSystem::GetPath("resources/shaders/forward/pbr.frag"));
+    // 场景着色器变体：每组只声明着色器实际使用的特性，变体在第一次需要时编译
+    const uint32_t blinnPhongMaps = SHADER_FEATURE_ALBEDO_MAP | SHADER_FEATURE_SPECULAR_MAP | SHADER_FEATURE_NORMAL_MAP;
+    const uint32_t pbrMaps = SHADER_FEATURE_ALBEDO_MAP | SHADER_FEATURE_METALLIC_MAP | SHADER_FEATURE_ROUGHNESS_MAP |
+                             SHADER_FEATURE_AO_MAP | SHADER_FEATURE_NORMAL_MAP;
 
-    deferredGeometryShader =
-        std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/deferred/geometry_pass.vert"),
-                                 FileSystem::GetPath("resources/shaders/deferred/geometry_pass.frag"));
+    forwardShaders = std::make_unique<ShaderVariants>(
+        FileSystem::GetPath("resources/shaders/forward/blinn_phong.vert"),
+        FileSystem::GetPath("resources/shaders/forward/blinn_phong.frag"),
+        blinnPhongMaps | SHADER_FEATURE_SHADOWS | SHADER_FEATURE_CLUSTERED_LIGHTS);
 
-    deferredLightingShader =
-        std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/deferred/lighting_pass.vert"),
-                                 FileSystem::GetPath("resources/shaders/deferred/lighting_pass.frag"));
+    pbrShaders = std::make_unique<ShaderVariants>(
+        FileSystem::GetPath("resources/shaders/forward/pbr.vert"), FileSystem::GetPath("resources/shaders/forward/pbr.frag"),
+        pbrMaps | SHADER_FEATURE_SHADOWS | SHADER_FEATURE_IBL | SHADER_FEATURE_CLUSTERED_LIGHTS);
 
-    pbrDeferredGeometryShader =
-        std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/deferred/pbr_geometry_pass.vert"),
-                                 FileSystem::GetPath("resources/shaders/deferred/pbr_geometry_pass.frag"));
+    deferredGeometryShaders = std::make_unique<ShaderVariants>(
+        FileSystem::GetPath("resources/shaders/deferred/geometry_pass.vert"),
+        FileSystem::GetPath("resources/shaders/deferred/geometry_pass.frag"), blinnPhongMaps);
+
+    deferredLightingShaders = std::make_unique<ShaderVariants>(
+        FileSystem::GetPath("resources/shaders/deferred/lighting_pass.vert"),
+        FileSystem::GetPath("resources/shaders/deferred/lighting_pass.frag"),
+        SHADER_FEATURE_SHADOWS | SHADER_FEATURE_IBL | SHADER_FEATURE_SSAO);
+
+    pbrDeferredGeometryShaders = std::make_unique<ShaderVariants>(
+        FileSystem::GetPath("resources/shaders/deferred/pbr_geometry_pass.vert"),
+        FileSystem::GetPath("resources/shaders/deferred/pbr_geometry_pass.frag"), pbrMaps);
+
+    if (glDispatchCompute != nullptr)
+    {
+        tiledLightingShaders =
+            std::make_unique<ShaderVariants>(FileSystem::GetPath("resources/shaders/compute/tiled_lighting.comp"),
+                                             SHADER_FEATURE_SHADOWS | SHADER_FEATURE_IBL | SHADER_FEATURE_SSAO);
+    }
 
     lightsShader = std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/utility/light.vert"),
                                             FileSystem::GetPath("resources/shaders/utility/light.frag"));
@@ -972,6 +1032,8 @@ void Renderer::Initialize()
     fxaaShader = std::make_unique<Shader>(
         FileSystem::GetPath("resources/shaders/postprocess/quad.vert"),
         FileSystem::GetPath("resources/shaders/postprocess/fxaa.frag"));
+    gBufferDebugShader = std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/postprocess/quad.vert"),
+                                                  FileSystem::GetPath("resources/shaders/deferred/gbuffer_debug.frag"));
     
     // IBL着色器
     equirectangularToCubemapShader = std::make_unique<Shader>(
@@ -989,6 +1051,11 @@ void Renderer::Initialize()
     brdfShader = std::make_unique<Shader>(FileSystem::GetPath("resources/shaders/postprocess/quad.vert"),
                                           FileSystem::GetPath("resources/shaders/ibl/brdf_lut.frag"));
 
+    double submitMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - shaderLoadStart).count();
+    std::cout << "着色器提交耗时: " << submitMs << " ms，并行编译: "
+              << (Shader::IsParallelCompileSupported() ? "支持" : "不支持") << std::endl;
+
     // 初始化环境贴图数组
     envmapnow = 0;
     for (int i = 0; i < envmapcount; i++)
@@ -998,6 +1065,12 @@ void Renderer::Initialize()
         prefilterMap[i] = nullptr;
     }
 
+    // 每帧共享数据（相机矩阵、全局开关）的UBO，所有着色器通过 binding = 0 读取
+    frameDataBuffer = std::make_unique<UniformBuffer>(sizeof(FrameData), FRAME_DATA_BINDING);
+    lightBuffer = std::make_unique<LightBuffer>();
+    lightClusters =
+        std::make_unique<LightClusters>(FileSystem::GetPath("resources/shaders/compute/light_cluster.comp"));
+
     // 初始化帧缓冲
     SetupShadowBuffer();
     SetupGBuffer();
@@ -1019,31 +1092,105 @@ void Renderer::Initialize()
 
     // 设置相机
     mainCamera = std::make_shared<Camera>();
+
+    // 预先提交当前全局开关下不带贴图的变体，其余变体在场景需要时编译
+    uint32_t globalFeatures = GetGlobalShaderFeatures();
+    for (ShaderVariants *variants : {forwardShaders.get(), pbrShaders.get(), deferredGeometryShaders.get(),
+                                     deferredLightingShaders.get(), pbrDeferredGeometryShaders.get()})
+    {
+        pendingShaders.push_back(variants->Get(globalFeatures).get());
+    }
+    if (tiledLightingShaders && currentMode == TILED_DEFERRED)
+        pendingShaders.push_back(tiledLightingShaders->Get(globalFeatures).get());
+    for (Shader *shader : {lightsShader.get(), shadowDepthShader.get(), postProcessShader.get(), postShaderMS.get(),
+                           ssaoShader.get(), ssaoBlurShader.get(), bloomPreShader.get(), bloomBlurShader.get(),
+                           fxaaShader.get(), skyboxShader.get(), gBufferDebugShader.get()})
+    {
+        pendingShaders.push_back(shader);
+    }
+    if (Shader *clusterShader = lightClusters->GetComputeShader())
+        pendingShaders.push_back(clusterShader);
+}
+
+uint32_t Renderer::GetGlobalShaderFeatures() const
+{
+    uint32_t features = 0;
+    if (shadowEnabled && shadowAtlas && cascadedShadowMap)
+        features |= SHADER_FEATURE_SHADOWS;
+    if (iblEnabled && irradianceMap[envmapnow] && prefilterMap[envmapnow] && brdfLUTTexture)
+        features |= SHADER_FEATURE_IBL;
+    if (ssaoEnabled)
+        features |= SHADER_FEATURE_SSAO;
+    if (clusteredLighting && lightClusters)
+        features |= SHADER_FEATURE_CLUSTERED_LIGHTS;
+    return features;
+}
+
+size_t Renderer::GetShaderVariantCount() const
+{
+    size_t count = 0;
+    for (const ShaderVariants *variants : {forwardShaders.get(), pbrShaders.get(), deferredGeometryShaders.get(),
+                                           deferredLightingShaders.get(), pbrDeferredGeometryShaders.get(),
+                                           tiledLightingShaders.get()})
+    {
+        if (variants)
+            count += variants->GetVariantCount();
+    }
+    return count;
+}
+
+bool Renderer::UpdateShaderCompilation()
+{
+    if (pendingShaders.empty())
+        return true;
+
+    // 有并行编译扩展时解析所有已完成的着色器；否则每帧只解析一个，避免长时间卡住编辑器
+    bool parallel = Shader::IsParallelCompileSupported();
+    for (auto it = pendingShaders.begin(); it != pendingShaders.end();)
+    {
+        if (!(*it)->IsReady())
+        {
+            ++it;
+            continue;
+        }
+        (*it)->Resolve();
+        it = pendingShaders.erase(it);
+        if (!parallel)
+            break;
+    }
+
+    if (!pendingShaders.empty())
+        return false;
+
+    shaderLoadMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - shaderLoadStart).count();
+    const ShaderCache::Stats &cacheStats = ShaderCache::GetInstance().GetStats();
+    std::cout << "着色器加载完成，耗时: " << shaderLoadMs << " ms，缓存命中 " << cacheStats.hits << "，未命中 "
+              << cacheStats.misses << "，驱动拒绝 " << cacheStats.rejected << std::endl;
+    return true;
 }
 
 void Renderer::SetupGBuffer()
 {
     gBuffer = std::make_unique<Framebuffer>(width, height);
 
-    // 位置、法线、反照率、金属度/粗糙度/ao、漫反射/镜面反射贴图
-    gBuffer->AddColorTexture(GL_RGBA16F, GL_RGBA, GL_FLOAT);      // 位置 + 深度
-    gBuffer->AddColorTexture(GL_RGBA16F, GL_RGBA, GL_FLOAT);      // 法线
-    gBuffer->AddColorTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE); // 漫反射贴图
-    gBuffer->AddColorTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE); // 镜面反射贴图
-    gBuffer->AddColorTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE); // 金属度
-    gBuffer->AddColorTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE); // 粗糙度
-    gBuffer->AddColorTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE); // AO
-    gBuffer->AddColorTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE); // 环境光贴图
-
-    gBuffer->AddDepthBuffer();
+    // 紧凑布局（每像素 16 字节颜色 + 4 字节深度），编码方式见 shaders/common/gbuffer.glsl；
+    // 位置由深度重建，Blinn-Phong 的环境光颜色即反照率
+    gBuffer->AddColorTexture(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE); // 反照率 + AO
+    gBuffer->AddColorTexture(GL_RGBA16F, GL_RGBA, GL_FLOAT);       // 八面体法线 + 粗糙度 + 金属度
+    gBuffer->AddColorTexture(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE); // 镜面反射颜色 + 材质类型
+
+    // 可采样的深度/模板纹理，格式与 HDR 缓冲的深度附件相同以便 blit
+    gBuffer->AddDepthStencilTexture();
     gBuffer->CheckComplete();
 }
 
 void Renderer::SetupShadowBuffer()
 {
-    shadowBuffer = std::make_unique<Framebuffer>(2048, 2048);
-    shadowBuffer->AddDepthTexture();
-    shadowBuffer->CheckComplete();
+    // 单元格 1024，点光源/聚光灯占 1 个单元格
+    shadowAtlas = std::make_unique<ShadowAtlas>(1024, 2, 8);
+    // 方向光使用 3 级 1024 的级联，近处的纹素密度远高于原先覆盖整个场景的单张 2048 阴影图
+    cascadedShadowMap = std::make_unique<CascadedShadowMap>(1024, 3);
 }
 
 void Renderer::SetupHDRBuffer()
@@ -1110,17 +1257,41 @@ void Renderer::SetupSkybox()
 
 void Renderer::RenderScene()
 {
+    // 着色器仍在编译时只清空视口，编辑器照常显示
+    if (!UpdateShaderCompilation())
+    {
+        viewportBuffer->Bind();
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        viewportBuffer->Unbind();
+        return;
+    }
+
+    gpuTimer.BeginFrame();
+
+    // 每帧只上传一次相机与全局参数
+    SetGlobalUniforms(*mainCamera);
+    UpdateVisibility();
+    RequestTextureResolutions();
+
     if (shadowEnabled)
     {
+        GpuTimer::Scope scope(gpuTimer, "Shadows");
         RenderShadows();
     }
 
+    // 阴影图块分配完成后同步光源表，只上传参数变化的光源
+    lightBuffer->Update(directionalLights, pointLights, spotLights);
+
     switch (currentMode)
     {
-    case FORWARD:
+    case FORWARD: {
+        GpuTimer::Scope scope(gpuTimer, "Forward");
         RenderForward();
         break;
+    }
     case DEFERRED:
+    case TILED_DEFERRED:
         RenderDeferred();
         break;
     }
@@ -1131,7 +1302,19 @@ void Renderer::RenderScene()
         RenderLights();
     }
 
-    RenderPostProcessing();
+    {
+        GpuTimer::Scope scope(gpuTimer, "PostProcess");
+        RenderPostProcessing();
+    }
+
+    // 调试视口每帧重新请求，关闭后不再解码
+    if (gBufferDebugRequested && currentMode != FORWARD)
+    {
+        DecodeGBufferDebugView();
+    }
+    gBufferDebugRequested = false;
+
+    gpuTimer.EndFrame();
 }
 
 void Renderer::RenderForward()
@@ -1149,163 +1332,31 @@ void Renderer::RenderForward()
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
-    // 分别处理Blinn-Phong材质和PBR材质的物体
-    
-    // 1. 渲染Blinn-Phong材质的物体
-    forwardShader->Use();
-    // 设置相机、光照等uniform
-    glm::mat4 view = mainCamera->GetViewMatrix();
-    glm::mat4 projection = mainCamera->GetProjectionMatrix(static_cast<float>(width) / height);
-    forwardShader->SetMat4("view", view);
-    forwardShader->SetMat4("projection", projection);
-    forwardShader->SetVec3("viewPos", mainCamera->Position);
-
-    // 设置光源
-    forwardShader->SetInt("numLights[0]", directionalLights.size()); // 方向光数量
-    forwardShader->SetInt("numLights[1]", pointLights.size());       // 点光
-    forwardShader->SetInt("numLights[2]", spotLights.size());        // 聚光灯数量
-    
-    // 启用阴影
-    if (shadowEnabled)
-    {
-        forwardShader->SetBool("shadowEnabled", true);
-    }
-    else
-    {
-        forwardShader->SetBool("shadowEnabled", false);
-    }
-    for (size_t i = 0; i < pointLights.size(); ++i)
-    {
-        pointLights[i]->SetupShader(*forwardShader, i, shadowEnabled);
-    }
-    for (size_t i = 0; i < directionalLights.size(); ++i)
-    {
-        directionalLights[i]->SetupShader(*forwardShader, i, shadowEnabled);
-    }
-    for (size_t i = 0; i < spotLights.size(); ++i)
-    {
-        spotLights[i]->SetupShader(*forwardShader, i, shadowEnabled);
-    }
-    
-    // 渲染Blinn-Phong材质的模型
-    for (auto &model : models)
-    {
-        model->DrawWithMaterialType(*forwardShader, BLINN_PHONG);
-    }
-
-    // 渲染Blinn-Phong材质的几何体
-    for (auto &primitive : primitives)
+    // 相机矩阵与全局开关来自 FrameData UBO，光源参数来自光源表（SSBO）；
+    // 阴影图集和 IBL 贴图绑定到各变体在着色器中声明的固定纹理单元，只需绑定一次
+    uint32_t globalFeatures = GetGlobalShaderFeatures();
+    if (globalFeatures & SHADER_FEATURE_SHADOWS)
     {
-        if (primitive.mesh->GetMaterial()->type == BLINN_PHONG)
-        {
-            primitive.mesh->Draw(*forwardShader);
-        }
+        glActiveTexture(GL_TEXTURE10);
+        glBindTexture(GL_TEXTURE_2D, shadowAtlas->GetDepthTexture());
+        glActiveTexture(GL_TEXTURE11);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, cascadedShadowMap->GetDepthTexture());
     }
-
-    // 2. 渲染PBR材质的物体
-    pbrShader->Use();
-    
-    // 设置相机矩阵
-    pbrShader->SetMat4("view", view);
-    pbrShader->SetMat4("projection", projection);
-    pbrShader->SetVec3("viewPos", mainCamera->Position);
-
-    // 设置光源数量
-    pbrShader->SetInt("numLights[0]", directionalLights.size());
-    pbrShader->SetInt("numLights[1]", pointLights.size());
-    pbrShader->SetInt("numLights[2]", spotLights.size());
-    
-    // 设置阴影
-    pbrShader->SetBool("shadowEnabled", shadowEnabled);
-    
-    // 设置光源参数
-    for (size_t i = 0; i < directionalLights.size(); ++i)
+    if (globalFeatures & SHADER_FEATURE_IBL)
     {
-        auto& light = directionalLights[i];
-        std::string base = "dirLights[" + std::to_string(i) + "]";
-        pbrShader->SetVec3(base + ".direction", light->direction);
-        pbrShader->SetVec3(base + ".color", light->diffuse);
-        pbrShader->SetFloat(base + ".intensity", light->intensity);
-        pbrShader->SetBool(base + ".shadowEnabled", light->HasShadows() && shadowEnabled);
-        if (light->HasShadows() && shadowEnabled)
-        {
-            pbrShader->SetMat4(base + ".lightSpaceMatrix", light->GetLightSpaceMatrix());
-            // 绑定阴影贴图
-            glActiveTexture(GL_TEXTURE10 + i);
-            glBindTexture(GL_TEXTURE_2D, light->GetShadowMap());
-            pbrShader->SetInt(base + ".shadowMap", 10 + i);
-        }
-    }
-    
-    for (size_t i = 0; i < pointLights.size(); ++i)
-    {
-        auto& light = pointLights[i];
-        std::string base = "pointLights[" + std::to_string(i) + "]";
-        pbrShader->SetVec3(base + ".position", light->position);
-        pbrShader->SetVec3(base + ".color", light->diffuse);
-        pbrShader->SetFloat(base + ".intensity", light->intensity);
-        pbrShader->SetFloat(base + ".constant", light->constant);
-        pbrShader->SetFloat(base + ".linear", light->linear);
-        pbrShader->SetFloat(base + ".quadratic", light->quadratic);
-        pbrShader->SetBool(base + ".shadowEnabled", light->HasShadows() && shadowEnabled);
-    }
-    
-    for (size_t i = 0; i < spotLights.size(); ++i)
-    {
-        auto& light = spotLights[i];
-        std::string base = "spotLights[" + std::to_string(i) + "]";
-        pbrShader->SetVec3(base + ".position", light->position);
-        pbrShader->SetVec3(base + ".direction", light->direction);
-        pbrShader->SetVec3(base + ".color", light->diffuse);
-        pbrShader->SetFloat(base + ".intensity", light->intensity);
-        pbrShader->SetFloat(base + ".constant", light->constant);
-        pbrShader->SetFloat(base + ".linear", light->linear);
-        pbrShader->SetFloat(base + ".quadratic", light->quadratic);
-        pbrShader->SetFloat(base + ".cutOff", light->cutOff);
-        pbrShader->SetFloat(base + ".outerCutOff", light->outerCutOff);
-        pbrShader->SetBool(base + ".shadowEnabled", light->HasShadows() && shadowEnabled);
-        if (light->HasShadows() && shadowEnabled)
-        {
-            pbrShader->SetMat4(base + ".lightSpaceMatrix", light->GetLightSpaceMatrix());
-        }
+        BindIBLTextures();
     }
-
-    // 设置IBL
-    pbrShader->SetBool("iblEnabled", iblEnabled);
-    if (iblEnabled && irradianceMap[envmapnow] && prefilterMap[envmapnow])
+    if (globalFeatures & SHADER_FEATURE_CLUSTERED_LIGHTS)
     {
-        glActiveTexture(GL_TEXTURE20);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap[envmapnow]->GetID());
-        pbrShader->SetInt("irradianceMap", 20);
-
-        glActiveTexture(GL_TEXTURE21);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap[envmapnow]->GetID());
-        pbrShader->SetInt("prefilterMap", 21);
-
-        glActiveTexture(GL_TEXTURE22);
-        glBindTexture(GL_TEXTURE_2D, brdfLUTTexture->GetID());
-        pbrShader->SetInt("brdfLUT", 22);
-    }
-    else
-    {
-        // 禁用IBL如果贴图不可用
-        pbrShader->SetBool("iblEnabled", false);
+        // 光源表已在本帧更新，分簇结果供下面的前向着色器读取
+        lightClusters->Update(mainCamera->GetViewMatrix(),
+                              mainCamera->GetProjectionMatrix(static_cast<float>(width) / height),
+                              mainCamera->GetNearPlane(), mainCamera->GetFarPlane(), *lightBuffer);
     }
 
-    // 渲染PBR材质的模型
-    for (auto &model : models)
-    {
-        model->DrawWithMaterialType(*pbrShader, PBR);
-    }
-
-    // 渲染PBR材质的几何体
-    for (auto &primitive : primitives)
-    {
-        if (primitive.mesh->GetMaterial()->type == PBR)
-        {
-            primitive.mesh->Draw(*pbrShader);
-        }
-    }
+    // Blinn-Phong 和 PBR 材质的物体按各自的变体统一排序后提交
+    BuildRenderQueue(*forwardShaders, *pbrShaders, globalFeatures);
+    renderQueue.Submit();
 
     if (iblEnabled)
     {
@@ -1316,61 +1367,27 @@ void Renderer::RenderForward()
 void Renderer::RenderDeferred()
 {
     // 几何处理阶段
-    gBuffer->Bind();
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
-
-    auto view = mainCamera->GetViewMatrix();
-    auto projection = mainCamera->GetProjectionMatrix(static_cast<float>(width) / height);
-
-    // 1. 渲染Blinn-Phong材质的物体
-    deferredGeometryShader->Use();
-    deferredGeometryShader->SetMat4("view", view);
-    deferredGeometryShader->SetMat4("projection", projection);
-    deferredGeometryShader->SetVec3("viewPos", mainCamera->Position);
-
-    // 渲染Blinn-Phong材质的模型
-    for (auto &model : models)
-    {
-        model->DrawWithMaterialType(*deferredGeometryShader, BLINN_PHONG);
-    }
-
-    // 渲染Blinn-Phong材质的几何体
-    for (auto &primitive : primitives)
-    {
-        if (primitive.mesh->GetMaterial()->type == BLINN_PHONG)
-        {
-            primitive.mesh->Draw(*deferredGeometryShader);
-        }
-    }
-
-    // 2. 渲染PBR材质的物体
-    pbrDeferredGeometryShader->Use();
-    pbrDeferredGeometryShader->SetMat4("view", view);
-    pbrDeferredGeometryShader->SetMat4("projection", projection);
-    pbrDeferredGeometryShader->SetVec3("viewPos", mainCamera->Position);
-
-    // 渲染PBR材质的模型
-    for (auto &model : models)
     {
-        model->DrawWithMaterialType(*pbrDeferredGeometryShader, PBR);
-    }
+        GpuTimer::Scope scope(gpuTimer, "GBuffer");
+        gBuffer->Bind();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_CULL_FACE);
 
-    // 渲染PBR材质的几何体
-    for (auto &primitive : primitives)
-    {
-        if (primitive.mesh->GetMaterial()->type == PBR)
-        {
-            primitive.mesh->Draw(*pbrDeferredGeometryShader);
-        }
+        // Blinn-Phong 与 PBR 材质的物体统一排序后写入G缓冲（几何阶段的变体只取决于材质贴图）
+        BuildRenderQueue(*deferredGeometryShaders, *pbrDeferredGeometryShaders, 0);
+        renderQueue.Submit();
     }
 
     if (ssaoEnabled)
     {
+        GpuTimer::Scope scope(gpuTimer, "SSAO");
         RenderSSAO();
     }
 
+    // 光照阶段（含深度复制和天空盒）计入 Lighting
+    GpuTimer::Scope lightingScope(gpuTimer, "Lighting");
+
     // 光照处理阶段
     GLuint targetFBO = msaaEnabled ? hdrBufferMS->GetID() : hdrBuffer->GetID();
     glBindFramebuffer(GL_FRAMEBUFFER, targetFBO);
@@ -1380,60 +1397,55 @@ void Renderer::RenderDeferred()
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFBO);
     glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
 
-    glClear(GL_STENCIL_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
-
-    glDepthMask(GL_FALSE);     // 不写入深度
-    glEnable(GL_STENCIL_TEST); // 全程开模板
-    glDisable(GL_CULL_FACE);   // 由每个 pass 自己决定
-
-    deferredLightingShader->Use();
-    // 绑定GBuffer纹理并设置uniform
-
-    // 设置相机
-    deferredLightingShader->SetMat4("view", mainCamera->GetViewMatrix());
-    deferredLightingShader->SetMat4("projection", mainCamera->GetProjectionMatrix(static_cast<float>(width) / height));
-    deferredLightingShader->SetVec3("viewPos", mainCamera->Position);
-    deferredLightingShader->SetVec2("screenSize", glm::vec2(width, height));
-    
-    // 设置全局阴影开关
-    deferredLightingShader->SetBool("shadowEnabled", shadowEnabled);
-
-    // 设置IBL参数
-    deferredLightingShader->SetBool("iblEnabled", iblEnabled);
-    if (iblEnabled && irradianceMap[envmapnow] && prefilterMap[envmapnow])
+    // 按全局开关选择光照阶段的变体，纹理单元在着色器中以 binding 固定
+    uint32_t globalFeatures = GetGlobalShaderFeatures();
+    if (globalFeatures & SHADER_FEATURE_IBL)
     {
-        glActiveTexture(GL_TEXTURE20);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap[envmapnow]->GetID());
-        deferredLightingShader->SetInt("irradianceMap", 20);
-
-        glActiveTexture(GL_TEXTURE21);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap[envmapnow]->GetID());
-        deferredLightingShader->SetInt("prefilterMap", 21);
+        BindIBLTextures();
+    }
 
-        glActiveTexture(GL_TEXTURE22);
-        glBindTexture(GL_TEXTURE_2D, brdfLUTTexture->GetID());
-        deferredLightingShader->SetInt("brdfLUT", 22);
+    // G缓冲的三个颜色目标绑定到单元 0..2，深度绑定到单元 3
+    for (int i = 0; i < 3; ++i)
+    {
+        gBuffer->BindTexture(i, i);
     }
-    else
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, gBuffer->GetDepthTexture());
+    if (globalFeatures & SHADER_FEATURE_SSAO)
     {
-        // 禁用IBL如果贴图不可用
-        deferredLightingShader->SetBool("iblEnabled", false);
+        ssaoBlurBuffer->BindTexture(0, 8); // 将模糊后的SSAO纹理绑定到槽8
     }
 
-    const int texSlots[8] = {0, 1, 2, 3, 4, 5, 6, 7};
-    const char *texNames[8] = {"gPosition", "gNormal", "gAlbedo", "gSpecular", "gMetallic", "gRoughness", "gAo", "gAmbient"};
-    for (int i = 0; i < 8; ++i)
+    // 阴影图集和级联阴影绑定到延迟渲染专用的纹理单元，光源参数来自光源表
+    if (globalFeatures & SHADER_FEATURE_SHADOWS)
     {
-        deferredLightingShader->SetInt(texNames[i], texSlots[i]);
-        gBuffer->BindTexture(i, texSlots[i]);
+        glActiveTexture(GL_TEXTURE30);
+        glBindTexture(GL_TEXTURE_2D, shadowAtlas->GetDepthTexture());
+        glActiveTexture(GL_TEXTURE31);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, cascadedShadowMap->GetDepthTexture());
     }
-    deferredLightingShader->SetBool("ssaoEnabled", ssaoEnabled);
-    if (ssaoEnabled)
+
+    // 分块光照写入单采样的 HDR 纹理，开启 MSAA 时仍逐光源绘制光体积
+    if (currentMode == TILED_DEFERRED && tiledLightingShaders && !msaaEnabled)
     {
-        ssaoBlurBuffer->BindTexture(0, 8); // 将模糊后的SSAO纹理绑定到槽8
-        deferredLightingShader->SetInt("ssao", 8);
+        RenderTiledDeferredLighting(globalFeatures);
+        if (iblEnabled)
+        {
+            RenderSkybox();
+        }
+        return;
     }
 
+    glClear(GL_STENCIL_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+
+    glDepthMask(GL_FALSE);     // 不写入深度
+    glEnable(GL_STENCIL_TEST); // 全程开模板
+    glDisable(GL_CULL_FACE);   // 由每个 pass 自己决定
+
+    const std::unique_ptr<Shader> &deferredLightingShader = deferredLightingShaders->Get(
+        shaderPermutations ? globalFeatures : deferredLightingShaders->GetSupportedFeatures());
+    deferredLightingShader->Use();
+
     for (const auto &light : GetLights())
     {
         if (light->getType() != 1)
@@ -1503,198 +1515,229 @@ void Renderer::RenderDeferred()
     }
 }
 
-void Renderer::RenderShadows()
+void Renderer::RenderTiledDeferredLighting(uint32_t globalFeatures)
 {
-    if (!shadowEnabled) return;
+    // 每个像素都会被写入（背景像素写 0），不需要清除颜色；深度已从G缓冲复制，供天空盒使用
+    const std::unique_ptr<Shader> &tiledLightingShader = tiledLightingShaders->Get(globalFeatures);
+    tiledLightingShader->Use();
 
-    // 保存当前OpenGL状态
-    GLint prevViewport[4];
-    glGetIntegerv(GL_VIEWPORT, prevViewport);
-    GLint prevFramebuffer;
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
+    glBindImageTexture(0, hdrBuffer->GetColorTexture(0), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
 
-    shadowDepthShader->Use();
+    // 图块大小与 tiled_lighting.comp 的 TILE_SIZE 一致
+    const GLuint tileSize = 16;
+    glDispatchCompute((width + tileSize - 1) / tileSize, (height + tileSize - 1) / tileSize, 1);
+
+    // 之后的天空盒绘制和后处理采样都要看到计算着色器的写入
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+}
 
-    // 渲染定向光阴影
-    for (size_t i = 0; i < directionalLights.size(); ++i)
+void Renderer::UpdateVisibility()
+{
+    cullItems.clear();
+    culler.Clear();
+    sceneBounds = AABB();
+
+    for (auto &model : models)
     {
-        auto &dirLight = directionalLights[i];
-        if (dirLight->HasShadows())
+        const auto &meshes = model->GetMeshes();
+        for (size_t i = 0; i < meshes.size(); ++i)
         {
-            // 为每个光源创建独立的阴影缓冲区
-            std::unique_ptr<Framebuffer> lightShadowBuffer = std::make_unique<Framebuffer>(2048, 2048);
-            lightShadowBuffer->AddDepthTexture();
-            lightShadowBuffer->CheckComplete();
-            
-            lightShadowBuffer->Bind();
-            glViewport(0, 0, lightShadowBuffer->GetWidth(), lightShadowBuffer->GetHeight());
-            glClear(GL_DEPTH_BUFFER_BIT);
+            // 异步加载完成后网格会被替换，资源版本号参与签名
+            size_t casterKey = ContentHash::Combine(reinterpret_cast<uintptr_t>(meshes[i].get()),
+                                                    model->GetAsset()->GetVersion());
+            cullItems.push_back({meshes[i].get(), model->GetMaterial(i).get(), &model->GetMeshWorldBounds(i),
+                                 &model->GetModelMatrix(), &model->GetNormalMatrix(), casterKey});
+            culler.Add(model->GetMeshWorldBounds(i));
+            sceneBounds.Expand(model->GetMeshWorldBounds(i));
+        }
+    }
 
-            // 设置光源空间矩阵
-            glm::mat4 lightSpaceMatrix = dirLight->GetLightSpaceMatrix();
-            shadowDepthShader->SetMat4("lightSpaceMatrix", lightSpaceMatrix);
+    for (auto &primitive : primitives)
+    {
+        Mesh *mesh = primitive.mesh.get();
+        // 修改几何参数会重建网格顶点，参数参与签名
+        size_t casterKey = ContentHash::Combine(reinterpret_cast<uintptr_t>(mesh), mesh->GetIndexCount());
+        casterKey = ContentHash::Combine(casterKey, ContentHash::Hash64(&primitive.params, sizeof(primitive.params)));
+        cullItems.push_back({mesh, mesh->GetMaterial().get(), &mesh->GetWorldBounds(), &mesh->GetModelMatrix(),
+                             &mesh->GetNormalMatrix(), casterKey});
+        culler.Add(mesh->GetWorldBounds());
+        sceneBounds.Expand(mesh->GetWorldBounds());
+    }
 
-            // 渲染所有模型和几何体
-            for (auto &model : models)
-            {
-                // 构建模型矩阵
-                glm::mat4 modelMatrix = glm::mat4(1.0f);
-                modelMatrix = glm::translate(modelMatrix, model->GetPosition());
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().x), glm::vec3(1.0f, 0.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().y), glm::vec3(0.0f, 1.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().z), glm::vec3(0.0f, 0.0f, 1.0f));
-                modelMatrix = glm::scale(modelMatrix, model->GetScale());
-                
-                shadowDepthShader->SetMat4("model", modelMatrix);
-                model->Draw(*shadowDepthShader);
-            }
+    cullingStats = CullingStats();
+    cullingStats.objects = static_cast<int>(cullItems.size());
+    cullingStats.cameraVisible = static_cast<int>(culler.Cull(cameraFrustum, cameraVisibility));
+    cullingStats.cameraCulled = cullingStats.objects - cullingStats.cameraVisible;
+}
 
-            for (auto &primitive : primitives)
-            {
-                // 构建几何体矩阵
-                glm::mat4 modelMatrix = glm::mat4(1.0f);
-                modelMatrix = glm::translate(modelMatrix, primitive.position);
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-                modelMatrix = glm::scale(modelMatrix, primitive.scale);
-                
-                shadowDepthShader->SetMat4("model", modelMatrix);
-                primitive.mesh->Draw(*shadowDepthShader);
-            }
+void Renderer::RequestTextureResolutions()
+{
+    // 视口高度上每单位 tan 对应的像素数：物体直径 d、距离 z 时投影约为 d / z * pixelsPerTan 像素
+    float pixelsPerTan = height / (2.0f * std::tan(glm::radians(mainCamera->GetFov()) * 0.5f));
+    float nearPlane = mainCamera->GetNearPlane();
 
-            // 将阴影贴图绑定到光源
-            unsigned int shadowMap = lightShadowBuffer->GetDepthTexture();
-            dirLight->SetShadowMap(shadowMap);
-            
-            // 将缓冲区保存到管理容器中（临时方案）
-            if (lightShadowBuffers.size() <= i) {
-                lightShadowBuffers.resize(i + 1);
-            }
-            lightShadowBuffers[i] = std::move(lightShadowBuffer);
-        }
+    for (size_t i = 0; i < cullItems.size(); ++i)
+    {
+        if (!cameraVisibility[i])
+            continue;
+
+        const CullItem &item = cullItems[i];
+        glm::vec3 center = (item.bounds->min + item.bounds->max) * 0.5f;
+        float diameter = glm::length(item.bounds->max - item.bounds->min);
+        // 相机位于包围盒内时按近平面距离计算，得到最高分辨率
+        float distance = std::max(glm::length(center - mainCamera->Position) - diameter * 0.5f, nearPlane);
+        item.material->RequestTextureScreenSize(diameter / distance * pixelsPerTan);
     }
+}
 
-    // 渲染点光源阴影
-    for (size_t i = 0; i < pointLights.size(); ++i)
-    {
-        auto &pointLight = pointLights[i];
-        if (pointLight->HasShadows())
-        {
-            // 为每个点光源创建独立的阴影缓冲区
-            std::unique_ptr<Framebuffer> lightShadowBuffer = std::make_unique<Framebuffer>(1024, 1024);
-            lightShadowBuffer->AddDepthTexture();
-            lightShadowBuffer->CheckComplete();
+void Renderer::BindIBLTextures()
+{
+    glActiveTexture(GL_TEXTURE20);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap[envmapnow]->GetID());
+    glActiveTexture(GL_TEXTURE21);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap[envmapnow]->GetID());
+    glActiveTexture(GL_TEXTURE22);
+    glBindTexture(GL_TEXTURE_2D, brdfLUTTexture->GetID());
+}
 
-            lightShadowBuffer->Bind();
-            glViewport(0, 0, lightShadowBuffer->GetWidth(), lightShadowBuffer->GetHeight());
-            glClear(GL_DEPTH_BUFFER_BIT);
+void Renderer::BuildRenderQueue(ShaderVariants &blinnPhongShaders, ShaderVariants &pbrShaders, uint32_t globalFeatures)
+{
+    renderQueue.Clear();
+    renderQueue.SetView(mainCamera->Position, mainCamera->GetFarPlane());
 
-            // 设置光源空间矩阵（使用透视投影）
-            glm::mat4 lightSpaceMatrix = pointLight->GetLightSpaceMatrix();
-            shadowDepthShader->SetMat4("lightSpaceMatrix", lightSpaceMatrix);
+    for (size_t i = 0; i < cullItems.size(); ++i)
+    {
+        if (!cameraVisibility[i])
+            continue;
 
-            // 渲染所有模型和几何体
-            for (auto &model : models)
-            {
-                // 构建模型矩阵
-                glm::mat4 modelMatrix = glm::mat4(1.0f);
-                modelMatrix = glm::translate(modelMatrix, model->GetPosition());
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().x), glm::vec3(1.0f, 0.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().y), glm::vec3(0.0f, 1.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().z), glm::vec3(0.0f, 0.0f, 1.0f));
-                modelMatrix = glm::scale(modelMatrix, model->GetScale());
-                
-                shadowDepthShader->SetMat4("model", modelMatrix);
-                model->Draw(*shadowDepthShader);
-            }
+        const CullItem &item = cullItems[i];
+        ShaderVariants &variants = item.material->type == PBR ? pbrShaders : blinnPhongShaders;
+        uint32_t materialFeatures =
+            shaderPermutations ? item.material->GetShaderFeatures() : SHADER_FEATURE_MATERIAL_MAPS;
+        Shader &shader = *variants.Get(materialFeatures | globalFeatures);
+        renderQueue.Add(shader, *item.mesh, *item.material, *item.world, *item.normal);
+    }
 
-            for (auto &primitive : primitives)
-            {
-                // 构建几何体矩阵
-                glm::mat4 modelMatrix = glm::mat4(1.0f);
-                modelMatrix = glm::translate(modelMatrix, primitive.position);
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-                modelMatrix = glm::scale(modelMatrix, primitive.scale);
-                
-                shadowDepthShader->SetMat4("model", modelMatrix);
-                primitive.mesh->Draw(*shadowDepthShader);
-            }
+    renderQueue.Sort();
+}
 
-            // 将阴影贴图绑定到光源
-            unsigned int shadowMap = lightShadowBuffer->GetDepthTexture();
-            pointLight->SetShadowMap(shadowMap);
-            
-            // 保存缓冲区，使用偏移索引以避免与定向光冲突
-            size_t bufferIndex = directionalLights.size() + i;
-            if (lightShadowBuffers.size() <= bufferIndex) {
-                lightShadowBuffers.resize(bufferIndex + 1);
-            }
-            lightShadowBuffers[bufferIndex] = std::move(lightShadowBuffer);
+void Renderer::RenderShadows()
+{
+    shadowTilesUpdated = 0;
+    shadowCascadesUpdated = 0;
+    if (!shadowEnabled || !shadowAtlas || !cascadedShadowMap) return;
+
+    // 1. 为所有投射阴影的光源分配图块和级联槽位（先分配再渲染，避免本帧扩容后已绘制的内容失效）
+    std::vector<std::pair<Light *, ShadowAtlas::Tile *>> shadowLights;
+    std::vector<std::pair<DirectionalLight *, int>> cascadeLights;
+    std::unordered_set<const Light *> alive;
+
+    auto acquireTile = [&](Light *light, int cells) {
+        alive.insert(light);
+        ShadowAtlas::Tile *tile = shadowAtlas->Acquire(light, cells);
+        if (tile)
+        {
+            shadowLights.emplace_back(light, tile);
         }
-    }
+        else
+        {
+            light->SetShadowMap(0); // 图集已满，该光源本帧不投射阴影
+        }
+    };
 
-    // 渲染聚光灯阴影
-    for (size_t i = 0; i < spotLights.size(); ++i)
+    for (auto &dirLight : directionalLights)
     {
-        auto &spotLight = spotLights[i];
-        if (spotLight->HasShadows())
+        if (!dirLight->HasShadows())
+            continue;
+        alive.insert(dirLight.get());
+        int slot = cascadedShadowMap->Acquire(dirLight.get());
+        if (slot >= 0)
         {
-            // 为每个聚光灯创建独立的阴影缓冲区
-            std::unique_ptr<Framebuffer> lightShadowBuffer = std::make_unique<Framebuffer>(1024, 1024);
-            lightShadowBuffer->AddDepthTexture();
-            lightShadowBuffer->CheckComplete();
+            cascadeLights.emplace_back(dirLight.get(), slot);
+        }
+        else
+        {
+            dirLight->SetShadowMap(0); // 超过级联阴影的方向光上限，该光源本帧不投射阴影
+        }
+    }
+    for (auto &pointLight : pointLights)
+    {
+        if (pointLight->HasShadows())
+            acquireTile(pointLight.get(), 1);
+    }
+    for (auto &spotLight : spotLights)
+    {
+        if (spotLight->HasShadows())
+            acquireTile(spotLight.get(), 1);
+    }
 
-            lightShadowBuffer->Bind();
-            glViewport(0, 0, lightShadowBuffer->GetWidth(), lightShadowBuffer->GetHeight());
-            glClear(GL_DEPTH_BUFFER_BIT);
+    // 已删除或关闭阴影的光源归还图块和槽位
+    shadowAtlas->ReleaseUnused(alive);
+    cascadedShadowMap->ReleaseUnused(alive);
 
-            // 设置光源空间矩阵
-            glm::mat4 lightSpaceMatrix = spotLight->GetLightSpaceMatrix();
-            shadowDepthShader->SetMat4("lightSpaceMatrix", lightSpaceMatrix);
+    if (shadowLights.empty() && cascadeLights.empty()) return;
 
-            // 渲染所有模型和几何体
-            for (auto &model : models)
-            {
-                // 构建模型矩阵
-                glm::mat4 modelMatrix = glm::mat4(1.0f);
-                modelMatrix = glm::translate(modelMatrix, model->GetPosition());
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().x), glm::vec3(1.0f, 0.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().y), glm::vec3(0.0f, 1.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(model->GetRotation().z), glm::vec3(0.0f, 0.0f, 1.0f));
-                modelMatrix = glm::scale(modelMatrix, model->GetScale());
-                
-                shadowDepthShader->SetMat4("model", modelMatrix);
-                model->Draw(*shadowDepthShader);
-            }
+    // 2. 只重绘光源矩阵或其视锥内的投射体发生变化的图块和级联
+    unsigned int atlasTexture = shadowAtlas->GetDepthTexture();
 
-            for (auto &primitive : primitives)
-            {
-                // 构建几何体矩阵
-                glm::mat4 modelMatrix = glm::mat4(1.0f);
-                modelMatrix = glm::translate(modelMatrix, primitive.position);
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-                modelMatrix = glm::rotate(modelMatrix, glm::radians(primitive.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-                modelMatrix = glm::scale(modelMatrix, primitive.scale);
-                
-                shadowDepthShader->SetMat4("model", modelMatrix);
-                primitive.mesh->Draw(*shadowDepthShader);
-            }
+    // 保存当前OpenGL状态
+    GLint prevViewport[4];
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+    GLint prevFramebuffer;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFramebuffer);
 
-            // 将阴影贴图绑定到光源
-            unsigned int shadowMap = lightShadowBuffer->GetDepthTexture();
-            spotLight->SetShadowMap(shadowMap);
-            
-            // 保存缓冲区，使用偏移索引
-            size_t bufferIndex = directionalLights.size() + pointLights.size() + i;
-            if (lightShadowBuffers.size() <= bufferIndex) {
-                lightShadowBuffers.resize(bufferIndex + 1);
+    shadowDepthShader->Use();
+
+    for (auto &[light, tile] : shadowLights)
+    {
+        // 图集扩容后图块归一化坐标会变化，每帧同步给光源
+        light->SetShadowMap(atlasTexture);
+        light->SetShadowAtlasRect(shadowAtlas->GetTileRect(*tile));
+
+        glm::mat4 lightSpaceMatrix = light->GetLightSpaceMatrix();
+        size_t casterSignature = CullShadowCasters(lightSpaceMatrix);
+        if (!tile->dirty && tile->lightSpaceMatrix == lightSpaceMatrix && tile->casterSignature == casterSignature)
+            continue;
+
+        shadowAtlas->BeginTile(*tile);
+        shadowDepthShader->SetMat4("lightSpaceMatrix", lightSpaceMatrix);
+        RenderShadowCasters();
+        shadowAtlas->EndTile();
+
+        tile->lightSpaceMatrix = lightSpaceMatrix;
+        tile->casterSignature = casterSignature;
+        tile->dirty = false;
+        ++shadowTilesUpdated;
+    }
+
+    // 级联矩阵随相机变化，每帧重新计算并上传；按纹素对齐后相机小幅移动时矩阵不变，可以沿用上次的结果
+    if (!cascadeLights.empty())
+    {
+        cascadedShadowMap->UpdateSplits(*mainCamera, static_cast<float>(width) / height);
+        for (auto &[light, slot] : cascadeLights)
+        {
+            // 纹理数组扩容后纹理对象会变化，每帧同步给光源
+            light->SetShadowMap(cascadedShadowMap->GetDepthTexture());
+            light->SetShadowCascadeSlot(slot);
+
+            for (int cascade = 0; cascade < cascadedShadowMap->GetCascadeCount(); ++cascade)
+            {
+                glm::mat4 lightSpaceMatrix =
+                    cascadedShadowMap->ComputeMatrix(slot, light->direction, cascade, sceneBounds);
+                // 每个级联只绘制与自身正交视锥相交的投射体
+                size_t casterSignature = CullShadowCasters(lightSpaceMatrix);
+                if (!cascadedShadowMap->NeedsRedraw(slot, cascade, casterSignature))
+                    continue;
+
+                cascadedShadowMap->BeginCascade(slot, cascade);
+                shadowDepthShader->SetMat4("lightSpaceMatrix", lightSpaceMatrix);
+                RenderShadowCasters();
+                cascadedShadowMap->EndCascade(slot, cascade, casterSignature);
+                ++shadowCascadesUpdated;
             }
-            lightShadowBuffers[bufferIndex] = std::move(lightShadowBuffer);
         }
+        cascadedShadowMap->Upload();
     }
 
     // 恢复OpenGL状态
@@ -1702,6 +1745,35 @@ void Renderer::RenderShadows()
     glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
 }
 
+size_t Renderer::CullShadowCasters(const glm::mat4 &lightSpaceMatrix)
+{
+    int visibleCount = static_cast<int>(culler.Cull(Frustum::FromMatrix(lightSpaceMatrix), shadowVisibility));
+    cullingStats.shadowVisible += visibleCount;
+    cullingStats.shadowCulled += static_cast<int>(cullItems.size()) - visibleCount;
+
+    // 视锥外的物体不参与签名，移动它们不会让该光源重绘；物体进出视锥时可见集合变化，签名同样改变
+    uint64_t signature = static_cast<uint64_t>(visibleCount);
+    for (size_t i = 0; i < cullItems.size(); ++i)
+    {
+        if (!shadowVisibility[i])
+            continue;
+        signature = ContentHash::Combine(signature, cullItems[i].casterKey);
+        signature = ContentHash::Combine(signature, ContentHash::Hash64(cullItems[i].world, sizeof(glm::mat4)));
+    }
+    return static_cast<size_t>(signature);
+}
+
+void Renderer::RenderShadowCasters()
+{
+    for (size_t i = 0; i < cullItems.size(); ++i)
+    {
+        if (shadowVisibility[i])
+        {
+            cullItems[i].mesh->DrawDepthOnly(*shadowDepthShader, *cullItems[i].world);
+        }
+    }
+}
+
 void Renderer::RenderSkybox()
 {
     // 检查当前环境槽位是否有效
@@ -1714,21 +1786,10 @@ void Renderer::RenderSkybox()
     glDisable(GL_CULL_FACE);
     
     skyboxShader->Use();
-    
-    // 设置视图矩阵(移除平移部分)
-    glm::mat4 view = glm::mat4(glm::mat3(mainCamera->GetViewMatrix()));
-    skyboxShader->SetMat4("view", view);
-    skyboxShader->SetMat4("projection", mainCamera->GetProjectionMatrix(static_cast<float>(width) / height));
-    
+    // 视图矩阵的平移部分在着色器中移除
+
     // 使用背景贴图专用的gamma校正设置
-    if (backgroundGammaCorrection)
-    {
-        skyboxShader->SetBool("gammaEnabled", true);
-    }
-    else
-    {
-        skyboxShader->SetBool("gammaEnabled", false);
-    }
+    skyboxShader->SetBool("backgroundGammaEnabled", backgroundGammaCorrection);
 
     glActiveTexture(GL_TEXTURE0);
     
@@ -1742,6 +1803,32 @@ void Renderer::RenderSkybox()
     glEnable(GL_CULL_FACE);
 }
 
+void Renderer::DecodeGBufferDebugView()
+{
+    if (!gBufferDebugBuffer)
+    {
+        gBufferDebugBuffer = std::make_unique<Framebuffer>(width, height);
+        gBufferDebugBuffer->AddColorTexture(GL_RGBA16F, GL_RGBA, GL_FLOAT); // 位置
+        gBufferDebugBuffer->AddColorTexture(GL_RGBA16F, GL_RGBA, GL_FLOAT); // 法线
+        for (int i = 0; i < 6; ++i)                                          // 反照率、镜面反射、金属度、粗糙度、AO、环境光
+            gBufferDebugBuffer->AddColorTexture(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+        gBufferDebugBuffer->CheckComplete();
+    }
+
+    gBufferDebugBuffer->Bind();
+    glDisable(GL_DEPTH_TEST);
+    gBufferDebugShader->Use();
+    for (int i = 0; i < 3; ++i)
+    {
+        gBuffer->BindTexture(i, i);
+    }
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, gBuffer->GetDepthTexture());
+    RenderQuad();
+    glEnable(GL_DEPTH_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 void Renderer::RenderSSAO()
 {
     // 第一步：生成SSAO纹理
@@ -1749,11 +1836,12 @@ void Renderer::RenderSSAO()
     glClear(GL_COLOR_BUFFER_BIT);
     ssaoShader->Use();
 
-    // 绑定GBuffer纹理
-    gBuffer->BindTexture(0, 0); // 位置
-    gBuffer->BindTexture(1, 1); // 法线
-    ssaoShader->SetInt("gPosition", 0);
-    ssaoShader->SetInt("gNormal", 1);
+    // 绑定GBuffer纹理：深度重建位置，法线来自法线/材质目标
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, gBuffer->GetDepthTexture());
+    gBuffer->BindTexture(1, 1);
+    ssaoShader->SetInt("gDepth", 0);
+    ssaoShader->SetInt("gNormalMaterial", 1);
 
     // 绑定噪声纹理
     glActiveTexture(GL_TEXTURE2);
@@ -1766,11 +1854,6 @@ void Renderer::RenderSSAO()
         ssaoShader->SetVec3("samples[" + std::to_string(i) + "]", ssaoKernel[i]);
     }
 
-    // 设置矩阵
-    glm::mat4 projection = mainCamera->GetProjectionMatrix(static_cast<float>(width) / height);
-    ssaoShader->SetMat4("projection", projection);
-    ssaoShader->SetMat4("view", mainCamera->GetViewMatrix());
-
     // 设置参数
     ssaoShader->SetVec2("noiseScale", glm::vec2(width / (float)ssaoNoiseSize, height / (float)ssaoNoiseSize));
     ssaoShader->SetInt("kernelSize", ssaoKernelSize);
@@ -1808,8 +1891,6 @@ void Renderer::RenderLights()
     glDepthMask(GL_FALSE);
 
     lightsShader->Use();
-    lightsShader->SetMat4("view", mainCamera->GetViewMatrix());
-    lightsShader->SetMat4("projection", mainCamera->GetProjectionMatrix(width * 1.0f / height));
 
     for (const std::shared_ptr<Light> &light : GetLights())
     {
@@ -2107,9 +2188,32 @@ void Renderer::UseShader(const std::shared_ptr<Shader> &shader)
 }
 void Renderer::SetGlobalUniforms(const Camera &camera)
 {
-    forwardShader->SetMat4("view", camera.GetViewMatrix());
-    forwardShader->SetMat4("projection", camera.GetProjectionMatrix(static_cast<float>(width) / height));
-    forwardShader->SetVec3("viewPos", camera.Position);
+    if (!frameDataBuffer)
+        return;
+
+    FrameData data{};
+    data.view = camera.GetViewMatrix();
+    data.projection = camera.GetProjectionMatrix(static_cast<float>(width) / height);
+    data.viewProj = data.projection * data.view;
+    data.inverseProjection = glm::inverse(data.projection);
+    data.inverseView = glm::inverse(data.view);
+    cameraFrustum = Frustum::FromMatrix(data.viewProj);
+    data.viewPos = camera.Position;
+    data.time = frameTime;
+    data.screenSize = glm::vec2(width, height);
+    data.nearPlane = camera.GetNearPlane();
+    data.farPlane = camera.GetFarPlane();
+
+    data.shadowEnabled = shadowEnabled;
+    data.ssaoEnabled = ssaoEnabled;
+    // 环境贴图未加载完成时关闭IBL
+    data.iblEnabled = iblEnabled && irradianceMap[envmapnow] && prefilterMap[envmapnow] && brdfLUTTexture;
+    data.hdrEnabled = hdrEnabled;
+    data.bloomEnabled = bloomEnabled;
+    data.gammaEnabled = gammaCorrection;
+    data.deltaTime = frameDeltaTime;
+
+    frameDataBuffer->Update(&data, sizeof(FrameData));
 }
 
 void Renderer::RenderPostProcessing()
@@ -2152,7 +2256,6 @@ void Renderer::RenderPostProcessing()
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         fxaaShader->Use();
         fxaaShader->SetInt("screenTexture", 0);
-        fxaaShader->SetVec2("resolution", glm::vec2(width, height));
         hdrBuffer->BindTexture(0, 0);
         RenderQuad();
     }
@@ -2161,9 +2264,6 @@ void Renderer::RenderPostProcessing()
     viewportBuffer->Bind();
     glClear(GL_COLOR_BUFFER_BIT);
     postProcessShader->Use();
-    postProcessShader->SetBool("hdrEnabled", hdrEnabled);
-    postProcessShader->SetBool("bloomEnabled", bloomEnabled);
-    postProcessShader->SetBool("gammaEnabled", gammaCorrection);
     postProcessShader->SetFloat("exposure", 1.0f);
 
     // 绑定 HDR、Bloom、SSAO 纹理
@@ -2187,11 +2287,30 @@ void Renderer::RenderPostProcessing()
 
 std::shared_ptr<Model> Renderer::LoadModel(const std::string &path)
 {
-    auto model = std::make_shared<Model>(path);
+    auto model = std::make_shared<Model>(ModelManager::GetInstance().Load(path));
+    models.push_back(model);
+    return model;
+}
+
+std::shared_ptr<Model> Renderer::LoadModelAsync(const std::string &path)
+{
+    // 同一路径的模型共享资源，只有第一次会真正导入
+    auto model = std::make_shared<Model>(ModelManager::GetInstance().LoadAsync(path));
     models.push_back(model);
     return model;
 }
 
+void Renderer::ProcessModelUploads()
+{
+    ModelManager::GetInstance().ProcessUploads(modelUploadBudgetMs);
+
+    // 资源网格被替换后，各实例重建材质列表和包围盒
+    for (auto &model : models)
+    {
+        model->SyncWithAsset();
+    }
+}
+
 void Renderer::AddLight(const std::shared_ptr<Light> &light)
 {
     if (std::dynamic_pointer_cast<PointLight>(light))
@@ -2293,8 +2412,14 @@ void Renderer::SetShadow(bool enabled)
 // 多光源阴影管理函数实现
 void Renderer::ClearLightShadowBuffers()
 {
-    lightShadowBuffers.clear();
-    lightToShadowMap.clear();
+    if (shadowAtlas)
+    {
+        shadowAtlas->ReleaseAll();
+    }
+    if (cascadedShadowMap)
+    {
+        cascadedShadowMap->ReleaseAll();
+    }
 }
 
 void Renderer::SetIBL(bool enabled)
@@ -2326,6 +2451,8 @@ void Renderer::Resize(int newWidth, int newHeight)
 
     // 更新帧缓冲和着色器
     gBuffer->Resize(newWidth, newHeight);
+    if (gBufferDebugBuffer)
+        gBufferDebugBuffer->Resize(newWidth, newHeight);
     hdrBuffer->Resize(newWidth, newHeight);
     hdrBufferMS->Resize(newWidth, newHeight);
     bloomBlurBuffers[0]->Resize(newWidth, newHeight);
@@ -2333,7 +2460,6 @@ void Renderer::Resize(int newWidth, int newHeight)
     bloomPrefilterBuffer->Resize(newWidth, newHeight);
     ssaoBuffer->Resize(newWidth, newHeight);
     ssaoBlurBuffer->Resize(newWidth, newHeight);
-    shadowBuffer->Resize(2048, 2048); // 阴影缓冲大小固定
     fxaaBuffer->Resize(newWidth, newHeight);
     viewportBuffer->Resize(newWidth, newHeight);
 }
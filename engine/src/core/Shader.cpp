@@ -1,69 +1,132 @@
 #include "core/Shader.hpp"
+#include "core/ShaderCache.hpp"
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
+// 并行编译扩展的常量（核心头文件可能没有定义）
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
-Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath)
-{
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
+bool Shader::parallelCompileSupported = false;
+std::atomic<uint64_t> Shader::nextGeneration{1};
 
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 
-    try
+// 读取着色器源码，并展开 #include "file"（路径相对于当前文件所在目录）
+static std::string ReadShaderSource(const std::string &path, int depth = 0)
+{
+    if (depth > 8)
     {
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
+        std::cerr << "ERROR::SHADER::INCLUDE_DEPTH_EXCEEDED: " << path << std::endl;
+        return "";
+    }
 
-        vShaderFile.close();
-        fShaderFile.close();
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << path << std::endl;
+        return "";
+    }
 
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+    std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+    std::stringstream source;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t start = line.find_first_not_of(" \t");
+        if (start != std::string::npos && line.compare(start, 8, "#include") == 0)
+        {
+            size_t open = line.find('"', start);
+            size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close != std::string::npos)
+            {
+                source << ReadShaderSource(directory + line.substr(open + 1, close - open - 1), depth + 1) << '\n';
+                continue;
+            }
+        }
+        source << line << '\n';
     }
-    catch (std::ifstream::failure &e)
+    return source.str();
+}
+
+// 在 #version 行之后插入宏定义（#version 必须是第一条语句）
+static void InjectDefines(std::string &source, const std::string &defines)
+{
+    if (defines.empty())
+        return;
+
+    size_t insert = 0;
+    size_t version = source.find("#version");
+    if (version != std::string::npos)
     {
-        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+        size_t lineEnd = source.find('\n', version);
+        insert = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
     }
+    source.insert(insert, defines);
+}
 
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
+Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath, uint32_t features)
+    : features(features)
+{
+    std::string vertexCode = ReadShaderSource(vertexPath);
+    std::string fragmentCode = ReadShaderSource(fragmentPath);
 
-    unsigned int vertex, fragment;
+    std::string defines = GetFeatureDefines(features);
+    InjectDefines(vertexCode, defines);
+    InjectDefines(fragmentCode, defines);
 
-    // 顶点着色器
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    CheckCompileErrors(vertex, "VERTEX");
+    Submit({{GL_VERTEX_SHADER, vertexCode}, {GL_FRAGMENT_SHADER, fragmentCode}});
+}
 
-    // 片段着色器
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
-    CheckCompileErrors(fragment, "FRAGMENT");
+Shader::Shader(const std::string &computePath, uint32_t features) : features(features)
+{
+    std::string computeCode = ReadShaderSource(computePath);
+    InjectDefines(computeCode, GetFeatureDefines(features));
 
-    // 着色器程序
+    Submit({{GL_COMPUTE_SHADER, computeCode}});
+}
+
+void Shader::Submit(const std::vector<std::pair<GLenum, std::string>> &sources)
+{
     ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    CheckCompileErrors(ID, "PROGRAM");
+    generation = nextGeneration.fetch_add(1, std::memory_order_relaxed);
+
+    // 源码未变且驱动相同时直接恢复缓存的程序二进制
+    ShaderCache &cache = ShaderCache::GetInstance();
+    cacheKey = cache.GetBaseKey();
+    for (const auto &[type, code] : sources)
+        cacheKey = cache.AddSource(cacheKey, type, code);
+    if (cache.Load(cacheKey, ID))
+    {
+        resolved = true;
+        ReflectUniforms();
+        return;
+    }
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    // 提交阶段：只发出编译和链接命令，不查询状态，驱动可以在后台线程并行编译；
+    // 编译错误和链接结果在第一次使用时（Resolve）检查
+    for (const auto &[type, code] : sources)
+    {
+        const char *shaderCode = code.c_str();
+        unsigned int shader = glCreateShader(type);
+        glShaderSource(shader, 1, &shaderCode, NULL);
+        glCompileShader(shader);
+        glAttachShader(ID, shader);
+        stages.push_back({type, shader});
+    }
+
+    // 着色器程序
+    if (cache.IsEnabled())
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(ID);
 }
 
 Shader::~Shader()
 {
+    for (const auto &stage : stages)
+        glDeleteShader(stage.shader);
     if (ID != 0)
     {
         glDeleteProgram(ID);
@@ -71,57 +134,247 @@ Shader::~Shader()
     }
 }
 
+std::string Shader::GetFeatureDefines(uint32_t features)
+{
+    static const char *const names[SHADER_FEATURE_COUNT] = {
+        "HAS_ALBEDO_MAP",    "HAS_SPECULAR_MAP", "HAS_NORMAL_MAP", "HAS_METALLIC_MAP", "HAS_ROUGHNESS_MAP",
+        "HAS_AO_MAP",        "USE_SHADOWS",      "USE_IBL",        "USE_SSAO",         "USE_CLUSTERED_LIGHTS"};
+
+    std::string defines;
+    for (int i = 0; i < SHADER_FEATURE_COUNT; ++i)
+    {
+        if (features & (1u << i))
+        {
+            defines += "#define ";
+            defines += names[i];
+            defines += '\n';
+        }
+    }
+    return defines;
+}
+
+bool Shader::InitializeParallelCompile(void *(*loadProc)(const char *name))
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count && !parallelCompileSupported; ++i)
+    {
+        const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+        parallelCompileSupported = extension && (std::strcmp(extension, "GL_KHR_parallel_shader_compile") == 0 ||
+                                                 std::strcmp(extension, "GL_ARB_parallel_shader_compile") == 0);
+    }
+    if (!parallelCompileSupported)
+        return false;
+
+    // 0xFFFFFFFF 表示由驱动决定编译线程数
+    using MaxShaderCompilerThreadsProc = void(APIENTRY *)(GLuint count);
+    auto maxShaderCompilerThreads =
+        reinterpret_cast<MaxShaderCompilerThreadsProc>(loadProc("glMaxShaderCompilerThreadsKHR"));
+    if (!maxShaderCompilerThreads)
+        maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loadProc("glMaxShaderCompilerThreadsARB"));
+    if (maxShaderCompilerThreads)
+        maxShaderCompilerThreads(0xFFFFFFFFu);
+    return true;
+}
+
+bool Shader::IsReady() const
+{
+    if (resolved)
+        return true;
+    // 没有并行编译扩展时无法在不阻塞的情况下查询，视为就绪，由 Resolve 等待完成
+    if (!parallelCompileSupported)
+        return true;
+
+    GLint completed = GL_FALSE;
+    glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_TRUE;
+}
+
+void Shader::Resolve() const
+{
+    if (resolved)
+        return;
+    resolved = true;
+
+    // 解析阶段：检查编译和链接结果（编译尚未完成时在这里等待驱动）
+    for (const auto &stage : stages)
+    {
+        const char *typeName = stage.type == GL_VERTEX_SHADER     ? "VERTEX"
+                               : stage.type == GL_FRAGMENT_SHADER ? "FRAGMENT"
+                                                                  : "COMPUTE";
+        CheckCompileErrors(stage.shader, typeName);
+    }
+    bool linked = CheckCompileErrors(ID, "PROGRAM");
+
+    for (const auto &stage : stages)
+    {
+        glDetachShader(ID, stage.shader);
+        glDeleteShader(stage.shader);
+    }
+    stages.clear();
+
+    if (linked)
+        ShaderCache::GetInstance().Store(cacheKey, ID);
+
+    ReflectUniforms();
+}
+
 void Shader::Use() const
 {
+    Resolve();
     glUseProgram(ID);
 }
 
 void Shader::SetBool(const std::string &name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    glUniform1i(GetUniformLocation(name), (int)value);
 }
 
 void Shader::SetInt(const std::string &name, int value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::SetFloat(const std::string &name, float value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::SetVec2(const std::string &name, const glm::vec2 &value) const
 {
-    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    glUniform2fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::SetVec3(const std::string &name, const glm::vec3 &value) const
 {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    glUniform3fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::SetVec4(const std::string &name, const glm::vec4 &value) const
 {
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    glUniform4fv(GetUniformLocation(name), 1, &value[0]);
 }
 
 void Shader::SetMat2(const std::string &name, const glm::mat2 &mat) const
 {
-    glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::SetMat3(const std::string &name, const glm::mat3 &mat) const
 {
-    glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::SetMat4(const std::string &name, const glm::mat4 &mat) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+}
+
+UniformHandle Shader::GetUniformHandle(const std::string &name) const
+{
+    Resolve();
+    return UniformHandle{GetUniformLocation(name)};
+}
+
+void Shader::SetBool(UniformHandle handle, bool value) const
+{
+    glUniform1i(handle.location, (int)value);
+}
+
+void Shader::SetInt(UniformHandle handle, int value) const
+{
+    glUniform1i(handle.location, value);
+}
+
+void Shader::SetFloat(UniformHandle handle, float value) const
+{
+    glUniform1f(handle.location, value);
+}
+
+void Shader::SetVec2(UniformHandle handle, const glm::vec2 &value) const
+{
+    glUniform2fv(handle.location, 1, &value[0]);
+}
+
+void Shader::SetVec3(UniformHandle handle, const glm::vec3 &value) const
+{
+    glUniform3fv(handle.location, 1, &value[0]);
+}
+
+void Shader::SetVec4(UniformHandle handle, const glm::vec4 &value) const
+{
+    glUniform4fv(handle.location, 1, &value[0]);
+}
+
+void Shader::SetMat2(UniformHandle handle, const glm::mat2 &mat) const
+{
+    glUniformMatrix2fv(handle.location, 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::SetMat3(UniformHandle handle, const glm::mat3 &mat) const
+{
+    glUniformMatrix3fv(handle.location, 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::SetMat4(UniformHandle handle, const glm::mat4 &mat) const
+{
+    glUniformMatrix4fv(handle.location, 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::ReflectUniforms() const
+{
+    uniformLocations.clear();
+
+    GLint count = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    GLint maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    if (count <= 0 || maxLength <= 0)
+        return;
+
+    std::string buffer(maxLength, '\0');
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, i, maxLength, &length, &size, &type, buffer.data());
+        std::string name(buffer.data(), length);
+
+        GLint location = glGetUniformLocation(ID, name.c_str());
+        if (location < 0)
+            continue; // uniform block 成员等没有独立位置
+
+        uniformLocations[name] = location;
+
+        // 基本类型数组只报告 "name[0]"，补全其余元素以及不带下标的名称
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+        {
+            std::string base = name.substr(0, name.size() - 3);
+            uniformLocations[base] = location;
+            for (GLint element = 1; element < size; ++element)
+            {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                uniformLocations[elementName] = glGetUniformLocation(ID, elementName.c_str());
+            }
+        }
+    }
+}
+
+GLint Shader::GetUniformLocation(const std::string &name) const
+{
+    Resolve();
+    auto it = uniformLocations.find(name);
+    if (it != uniformLocations.end())
+        return it->second;
+
+    // 反射表之外的名称（如未使用被优化掉的 uniform）查询一次后缓存
+    GLint location = glGetUniformLocation(ID, name.c_str());
+    uniformLocations.emplace(name, location);
+    return location;
 }
 
-void Shader::CheckCompileErrors(unsigned int shader, std::string type)
+bool Shader::CheckCompileErrors(unsigned int shader, std::string type) const
 {
     int success;
     char infoLog[1024];
@@ -144,4 +397,5 @@ void Shader::CheckCompileErrors(unsigned int shader, std::string type)
             std::cerr << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << std::endl;
         }
     }
+    return success != 0;
 }
\ No newline at end of file
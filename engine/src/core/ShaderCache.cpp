@@ -0,0 +1,192 @@
+#include "core/ShaderCache.hpp"
+#include "core/ContentHash.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// 文件格式变化时递增，旧缓存自动失效
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr char CACHE_MAGIC[4] = {'A', 'M', 'P', 'B'};
+
+std::string GetGLString(GLenum name)
+{
+    const char *value = reinterpret_cast<const char *>(glGetString(name));
+    return value ? value : "";
+}
+} // namespace
+
+ShaderCache &ShaderCache::GetInstance()
+{
+    static ShaderCache instance;
+    return instance;
+}
+
+void ShaderCache::Initialize(const std::string &directory)
+{
+    this->directory = directory;
+
+    // 驱动至少支持一种程序二进制格式时才启用
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0)
+    {
+        std::cout << "着色器缓存: 驱动不支持程序二进制，已禁用" << std::endl;
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "着色器缓存目录创建失败: " << directory << " 错误: " << error.message() << std::endl;
+        return;
+    }
+
+    // 二进制只在同一驱动上有效，驱动信息变化时所有键随之变化
+    std::string vendor = GetGLString(GL_VENDOR);
+    std::string renderer = GetGLString(GL_RENDERER);
+    std::string version = GetGLString(GL_VERSION);
+    driverKey = ContentHash::Hash64(vendor.data(), vendor.size(), CACHE_VERSION);
+    driverKey = ContentHash::Combine(driverKey, ContentHash::Hash64(renderer.data(), renderer.size()));
+    driverKey = ContentHash::Combine(driverKey, ContentHash::Hash64(version.data(), version.size()));
+
+    initialized = true;
+    enabled = true;
+    std::cout << "着色器缓存: " << directory << " 驱动: " << renderer << " / " << version << std::endl;
+}
+
+uint64_t ShaderCache::AddSource(uint64_t key, unsigned int stage, const std::string &source) const
+{
+    return ContentHash::Combine(ContentHash::Combine(key, stage), ContentHash::Hash64(source.data(), source.size()));
+}
+
+void ShaderCache::Clear()
+{
+    if (!initialized)
+        return;
+
+    std::error_code error;
+    int removed = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.path().extension() == ".ampb" && std::filesystem::remove(entry.path(), error))
+            ++removed;
+    }
+    stats = Stats();
+    std::cout << "着色器缓存: 已清除 " << removed << " 个程序二进制" << std::endl;
+}
+
+std::string ShaderCache::GetFilePath(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.ampb", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool ShaderCache::Load(uint64_t key, unsigned int program)
+{
+    if (!enabled)
+        return false;
+
+    std::ifstream file(GetFilePath(key), std::ios::binary);
+    if (!file)
+    {
+        ++stats.misses;
+        return false;
+    }
+
+    FileHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, CACHE_MAGIC, 4) != 0 || header.version != CACHE_VERSION ||
+        header.key != key || header.size == 0)
+    {
+        ++stats.misses;
+        return false;
+    }
+
+    std::vector<char> binary(header.size);
+    file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file)
+    {
+        ++stats.misses;
+        return false;
+    }
+
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        // 驱动拒绝时删除旧文件，重新编译后会写入新的二进制
+        ++stats.rejected;
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(GetFilePath(key), error);
+        return false;
+    }
+
+    ++stats.hits;
+    return true;
+}
+
+bool ShaderCache::Store(uint64_t key, unsigned int program)
+{
+    if (!enabled)
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, length, &written, &binaryFormat, binary.data());
+    if (written <= 0)
+        return false;
+
+    FileHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.binaryFormat = binaryFormat;
+    header.size = static_cast<uint32_t>(written);
+
+    // 先写临时文件再重命名，写到一半退出时不会留下损坏的缓存
+    const std::string path = GetFilePath(key);
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "着色器缓存写入失败: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file)
+        {
+            std::cerr << "着色器缓存写入失败: " << tempPath << std::endl;
+            file.close();
+            // 缓存写入失败不影响启动，清理临时文件失败同样忽略
+            std::error_code removeError;
+            std::filesystem::remove(tempPath, removeError);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#include "core/ShaderVariants.hpp"
+#include <iostream>
+
+ShaderVariants::ShaderVariants(const std::string &vertexPath, const std::string &fragmentPath,
+                               uint32_t supportedFeatures)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath), supportedFeatures(supportedFeatures)
+{
+}
+
+ShaderVariants::ShaderVariants(const std::string &computePath, uint32_t supportedFeatures)
+    : computePath(computePath), supportedFeatures(supportedFeatures)
+{
+}
+
+const std::unique_ptr<Shader> &ShaderVariants::Get(uint32_t features)
+{
+    features &= supportedFeatures;
+
+    auto it = variants.find(features);
+    if (it != variants.end())
+        return it->second;
+
+    std::cout << "编译着色器变体: " << (computePath.empty() ? fragmentPath : computePath) << " 特性 0x" << std::hex
+              << features << std::dec << std::endl;
+    auto result = variants.emplace(features, computePath.empty()
+                                                 ? std::make_unique<Shader>(vertexPath, fragmentPath, features)
+                                                 : std::make_unique<Shader>(computePath, features));
+    return result.first->second;
+}
@@ -0,0 +1,168 @@
+#include "core/ShadowAtlas.hpp"
+#include <algorithm>
+#include <iostream>
+
+ShadowAtlas::ShadowAtlas(int cellSize, int initialCells, int maxCells)
+    : cellSize(cellSize), cellsPerSide(initialCells), maxCellsPerSide(maxCells)
+{
+    // 受硬件纹理尺寸限制
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize > 0)
+    {
+        maxCellsPerSide = std::max(1, std::min(maxCellsPerSide, maxTextureSize / cellSize));
+        cellsPerSide = std::min(cellsPerSide, maxCellsPerSide);
+    }
+
+    framebuffer = std::make_unique<Framebuffer>(GetSize(), GetSize());
+    framebuffer->AddDepthTexture();
+    framebuffer->CheckComplete();
+
+    occupied.assign(cellsPerSide * cellsPerSide, false);
+}
+
+ShadowAtlas::Tile *ShadowAtlas::Acquire(const Light *light, int cells)
+{
+    auto it = tiles.find(light);
+    if (it != tiles.end())
+    {
+        if (it->second.cells == cells)
+            return &it->second;
+        // 分辨率需求变化，重新分配
+        Release(light);
+    }
+
+    int x = 0, y = 0;
+    while (!FindFreeBlock(cells, x, y))
+    {
+        if (!Grow())
+        {
+            std::cerr << "ShadowAtlas: no free tile for " << cells << "x" << cells
+                      << " cells, atlas size " << GetSize() << std::endl;
+            return nullptr;
+        }
+    }
+
+    Tile tile;
+    tile.x = x;
+    tile.y = y;
+    tile.cells = cells;
+    MarkCells(tile, true);
+    return &(tiles[light] = tile);
+}
+
+void ShadowAtlas::Release(const Light *light)
+{
+    auto it = tiles.find(light);
+    if (it == tiles.end())
+        return;
+    MarkCells(it->second, false);
+    tiles.erase(it);
+}
+
+void ShadowAtlas::ReleaseAll()
+{
+    tiles.clear();
+    std::fill(occupied.begin(), occupied.end(), false);
+}
+
+void ShadowAtlas::ReleaseUnused(const std::unordered_set<const Light *> &alive)
+{
+    for (auto it = tiles.begin(); it != tiles.end();)
+    {
+        if (alive.count(it->first) == 0)
+        {
+            MarkCells(it->second, false);
+            it = tiles.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ShadowAtlas::Invalidate()
+{
+    for (auto &[light, tile] : tiles)
+        tile.dirty = true;
+}
+
+glm::vec4 ShadowAtlas::GetTileRect(const Tile &tile) const
+{
+    float inv = 1.0f / static_cast<float>(cellsPerSide);
+    return glm::vec4(tile.x * inv, tile.y * inv, tile.cells * inv, tile.cells * inv);
+}
+
+void ShadowAtlas::BeginTile(const Tile &tile) const
+{
+    framebuffer->Bind();
+
+    int px = tile.x * cellSize;
+    int py = tile.y * cellSize;
+    int size = tile.cells * cellSize;
+    glViewport(px, py, size, size);
+
+    // 只清除当前图块，其他光源的阴影保持不变
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(px, py, size, size);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void ShadowAtlas::EndTile() const
+{
+    glDisable(GL_SCISSOR_TEST);
+}
+
+bool ShadowAtlas::FindFreeBlock(int cells, int &outX, int &outY) const
+{
+    if (cells > cellsPerSide)
+        return false;
+
+    // 按图块大小对齐扫描，避免碎片
+    for (int y = 0; y + cells <= cellsPerSide; y += cells)
+    {
+        for (int x = 0; x + cells <= cellsPerSide; x += cells)
+        {
+            bool free = true;
+            for (int j = y; j < y + cells && free; ++j)
+                for (int i = x; i < x + cells && free; ++i)
+                    free = !occupied[j * cellsPerSide + i];
+            if (free)
+            {
+                outX = x;
+                outY = y;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ShadowAtlas::MarkCells(const Tile &tile, bool used)
+{
+    for (int j = tile.y; j < tile.y + tile.cells; ++j)
+        for (int i = tile.x; i < tile.x + tile.cells; ++i)
+            occupied[j * cellsPerSide + i] = used;
+}
+
+bool ShadowAtlas::Grow()
+{
+    if (cellsPerSide * 2 > maxCellsPerSide)
+        return false;
+
+    // 边长翻倍：已有图块的像素位置不变，只需扩展占用表
+    int newCells = cellsPerSide * 2;
+    std::vector<bool> newOccupied(newCells * newCells, false);
+    for (int j = 0; j < cellsPerSide; ++j)
+        for (int i = 0; i < cellsPerSide; ++i)
+            newOccupied[j * newCells + i] = occupied[j * cellsPerSide + i];
+
+    cellsPerSide = newCells;
+    occupied = std::move(newOccupied);
+
+    // 深度纹理重建后内容丢失，所有图块需要重绘
+    framebuffer->Resize(GetSize(), GetSize());
+    Invalidate();
+    return true;
+}
@@ -1,8 +1,50 @@
 #include "core/Texture.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include "core/TextureCache.hpp"
+#include "core/TextureCompressor.hpp"
+#include "core/TextureManager.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 
+namespace
+{
+// sRGB 8 位值 -> 线性浮点
+const std::array<float, 256> &SRGBToLinearTable()
+{
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> t{};
+        for (int i = 0; i < 256; ++i)
+        {
+            float c = i / 255.0f;
+            t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// 线性浮点 -> sRGB 8 位值（4096 级查表）
+unsigned char LinearToSRGB(float linear)
+{
+    static const std::array<unsigned char, 4096> table = []() {
+        std::array<unsigned char, 4096> t{};
+        for (int i = 0; i < 4096; ++i)
+        {
+            float c = i / 4095.0f;
+            float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            t[i] = static_cast<unsigned char>(std::clamp(s, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+        return t;
+    }();
+    int index = static_cast<int>(std::clamp(linear, 0.0f, 1.0f) * 4095.0f + 0.5f);
+    return table[index];
+}
+} // namespace
+
 // 初始化静态成员，从100000开始以避免与ImGui等系统纹理ID冲突
 unsigned int Texture::nextTextureID = 100000;
 
@@ -20,7 +62,8 @@ Texture::Texture()
 
 Texture::~Texture()
 {
-    if (ID != 0)
+    // 共享存储时 GL 纹理属于 storageOwner
+    if (ID != 0 && !storageOwner)
     {
         glDeleteTextures(1, &ID);
         ID = 0;
@@ -29,11 +72,21 @@ Texture::~Texture()
 
 void Texture::Generate(unsigned int width, unsigned int height, unsigned char *data)
 {
+    DetachStorage();
+    streamSource.reset();
     Width = width;
     Height = height;
+    int channels = Image_Format == GL_RGBA ? 4 : Image_Format == GL_RGB ? 3 : Image_Format == GL_RG ? 2 : 1;
+    memorySize = static_cast<size_t>(width) * height * channels;
 
     glBindTexture(GL_TEXTURE_2D, ID);
+    // 单通道、三通道图像的行宽不一定是 4 字节对齐
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glTexImage2D(GL_TEXTURE_2D, 0, Internal_Format, width, height, 0, Image_Format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    // 只有第 0 级，避免沿用之前上传的 mip 级别数导致纹理不完整
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, Wrap_S);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, Wrap_T);
@@ -56,43 +109,395 @@ bool Texture::LoadFromFile(const std::string &path)
         std::cerr << "Texture path is empty!" << std::endl;
         return false;
     }
-    
-    
-    stbi_set_flip_vertically_on_load(flipY); // 使用实例的flipY设置
-    // 中文读取，防止乱码
-    setlocale(LC_ALL, "zh_CN.UTF-8");
 
-    unsigned char *data = stbi_load(path.c_str(), &Width, &Height, &nrComponents, 0);
-    if (data)
+    TextureImage image;
+    image.srgb = srgb;
+    image.normalMap = normalMap;
+    if (!DecodeFile(path, flipY, image))
     {
-        std::cout << "成功读取纹理文件: " << path << " 尺寸: " << Width << "x" << Height << " 通道数: " << nrComponents << " flipY: " << flipY << std::endl;
-        
-        if (nrComponents == 1)
+        return false;
+    }
+    return Upload(image);
+}
+
+bool Texture::DecodeFile(const std::string &path, bool flipY, TextureImage &image)
+{
+    if (path.empty())
+    {
+        std::cerr << "Texture path is empty!" << std::endl;
+        return false;
+    }
+
+    // 一次读入文件内容，既用于计算缓存键也用于解码
+    std::vector<unsigned char> fileData;
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
         {
-            Internal_Format = GL_RED;
-            Image_Format = GL_RED;
+            std::cerr << "纹理加载失败: " << path << " 错误: 无法打开文件" << std::endl;
+            return false;
         }
-        else if (nrComponents == 3)
+        fileData.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(fileData.data()), static_cast<std::streamsize>(fileData.size()));
+    }
+
+    // 内容哈希总是计算（用于去重），启用纹理缓存时同时作为缓存键
+    const uint64_t cacheKey = TextureCache::MakeKey(fileData, flipY, image.srgb, image.normalMap);
+    image.contentHash = cacheKey;
+
+    TextureCache &cache = TextureCache::GetInstance();
+    if (cache.IsEnabled())
+    {
+        if (cache.Load(cacheKey, image))
         {
-            Internal_Format = GL_RGB;
-            Image_Format = GL_RGB;
+            image.path = path;
+            std::cout << "纹理缓存命中: " << path << " 尺寸: " << image.width << "x" << image.height
+                      << " mip: " << image.levels.size() << std::endl;
+            return true;
         }
-        else if (nrComponents == 4)
+    }
+
+    // 翻转设置只对当前线程生效，工作线程之间互不影响
+    stbi_set_flip_vertically_on_load_thread(flipY);
+
+    int width, height, components;
+    unsigned char *data = stbi_load_from_memory(fileData.data(), static_cast<int>(fileData.size()), &width, &height,
+                                                &components, 0);
+    if (!data)
+    {
+        std::cerr << "纹理加载失败: " << path << " 错误: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+
+    std::cout << "成功读取纹理文件: " << path << " 尺寸: " << width << "x" << height << " 通道数: " << components << " flipY: " << flipY << std::endl;
+
+    image.path = path;
+    image.width = width;
+    image.height = height;
+    image.components = components;
+    image.pixels.assign(data, data + static_cast<size_t>(width) * height * components);
+    stbi_image_free(data);
+    fileData = std::vector<unsigned char>();
+
+    BuildMipChain(image);
+
+    // 块压缩后写入缓存，下次直接读取压缩结果
+    if (cache.IsEnabled())
+    {
+        unsigned int format = TextureCompressor::ChooseFormat(image, cache.IsS3TCSupported());
+        if (format != 0 && TextureCompressor::Compress(image, format))
+            cache.Store(cacheKey, image);
+    }
+    return true;
+}
+
+void Texture::BuildMipChain(TextureImage &image)
+{
+    if (!image.IsValid())
+        return;
+
+    const int channels = image.components;
+    // sRGB 只作用于颜色通道，alpha 始终是线性的
+    const int colorChannels = image.srgb ? std::min(channels, 3) : 0;
+    const auto &toLinear = SRGBToLinearTable();
+
+    // 先计算全部级别的尺寸和偏移，一次性分配
+    image.levels.clear();
+    size_t totalSize = 0;
+    int w = image.width, h = image.height;
+    while (true)
+    {
+        size_t size = static_cast<size_t>(w) * h * channels;
+        image.levels.push_back({w, h, totalSize, size});
+        totalSize += size;
+        if (w == 1 && h == 1)
+            break;
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    image.pixels.resize(totalSize);
+
+    for (size_t level = 1; level < image.levels.size(); ++level)
+    {
+        const TextureImage::Level &src = image.levels[level - 1];
+        const TextureImage::Level &dst = image.levels[level];
+        const unsigned char *srcPixels = image.pixels.data() + src.offset;
+        unsigned char *dstPixels = image.pixels.data() + dst.offset;
+
+        for (int y = 0; y < dst.height; ++y)
         {
-            Internal_Format = GL_RGBA;
-            Image_Format = GL_RGBA;
+            // 奇数尺寸时最后一行/列与自身平均
+            int y0 = std::min(y * 2, src.height - 1);
+            int y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x)
+            {
+                int x0 = std::min(x * 2, src.width - 1);
+                int x1 = std::min(x * 2 + 1, src.width - 1);
+                const unsigned char *p00 = srcPixels + (static_cast<size_t>(y0) * src.width + x0) * channels;
+                const unsigned char *p10 = srcPixels + (static_cast<size_t>(y0) * src.width + x1) * channels;
+                const unsigned char *p01 = srcPixels + (static_cast<size_t>(y1) * src.width + x0) * channels;
+                const unsigned char *p11 = srcPixels + (static_cast<size_t>(y1) * src.width + x1) * channels;
+                unsigned char *out = dstPixels + (static_cast<size_t>(y) * dst.width + x) * channels;
+
+                for (int c = 0; c < channels; ++c)
+                {
+                    if (c < colorChannels)
+                    {
+                        float sum = toLinear[p00[c]] + toLinear[p10[c]] + toLinear[p01[c]] + toLinear[p11[c]];
+                        out[c] = LinearToSRGB(sum * 0.25f);
+                    }
+                    else
+                    {
+                        out[c] = static_cast<unsigned char>((p00[c] + p10[c] + p01[c] + p11[c] + 2) / 4);
+                    }
+                }
+            }
         }
+    }
+}
 
-        Generate(Width, Height, data);
-        stbi_image_free(data);
-        Path = path;
-        std::cout << "纹理加载成功: " << path << " ID: " << ID << " flipY: " << flipY << std::endl;
-        return true;
+bool Texture::Upload(const TextureImage &image)
+{
+    if (!image.IsValid())
+    {
+        std::cerr << "纹理数据为空: " << image.path << std::endl;
+        return false;
     }
+    return UploadPixels(image, image.pixels.data());
+}
 
-    std::cerr << "纹理加载失败: " << path << " 错误: " << stbi_failure_reason() << std::endl;
-    stbi_image_free(data);
-    return false;
+bool Texture::UploadPixels(const TextureImage &image, const void *pixels, int firstLevel)
+{
+    return UploadLevels(image, static_cast<const unsigned char *>(pixels), 0, firstLevel);
+}
+
+bool Texture::UploadPixels(const TextureImage &image, size_t pboOffset, int firstLevel)
+{
+    return UploadLevels(image, nullptr, pboOffset, firstLevel);
+}
+
+bool Texture::UploadLevels(const TextureImage &image, const unsigned char *pixels, size_t pboOffset, int firstLevel)
+{
+    DetachStorage();
+    // 重新上传会替换全部级别，之前的流式状态失效（需要时由调用者重新设置）
+    streamSource.reset();
+    if (image.levels.empty())
+        firstLevel = 0;
+    firstLevel = std::clamp(firstLevel, 0, std::max(static_cast<int>(image.levels.size()) - 1, 0));
+    residentLevel = firstLevel;
+    tailLevel = firstLevel;
+    nrComponents = image.components;
+    srgb = image.srgb;
+    normalMap = image.normalMap;
+    if (image.compressedFormat != 0)
+    {
+        Internal_Format = image.compressedFormat;
+        Image_Format = image.compressedFormat;
+    }
+    else if (nrComponents == 1)
+    {
+        Internal_Format = GL_RED;
+        Image_Format = GL_RED;
+    }
+    else if (nrComponents == 2)
+    {
+        Internal_Format = GL_RG;
+        Image_Format = GL_RG;
+    }
+    else if (nrComponents == 3)
+    {
+        Internal_Format = srgb ? GL_SRGB8 : GL_RGB;
+        Image_Format = GL_RGB;
+    }
+    else if (nrComponents == 4)
+    {
+        Internal_Format = srgb ? GL_SRGB8_ALPHA8 : GL_RGBA;
+        Image_Format = GL_RGBA;
+    }
+
+    Width = image.width;
+    Height = image.height;
+    Filter_Min = GL_LINEAR_MIPMAP_LINEAR;
+
+    // 各级数据的来源：内存中按完整 mip 链的 offset 寻址；PBO 中只有从 firstLevel 开始的后缀，
+    // 按相对 firstLevel 的偏移寻址（GL 约定把缓冲内偏移作为指针参数传入）
+    size_t firstOffset = image.levels.empty() ? 0 : image.levels[firstLevel].offset;
+    auto source = [&](size_t offset) -> const void * {
+        if (pixels)
+            return pixels + offset;
+        return reinterpret_cast<const void *>(pboOffset + (offset - firstOffset));
+    };
+
+    glBindTexture(GL_TEXTURE_2D, ID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    memorySize = 0;
+    if (image.compressedFormat != 0)
+    {
+        // 块压缩数据直接上传全部 mip 级别，显存占用与文件中的数据相同
+        for (size_t level = firstLevel; level < image.levels.size(); ++level)
+        {
+            const TextureImage::Level &l = image.levels[level];
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.compressedFormat, l.width,
+                                   l.height, 0, static_cast<GLsizei>(l.size), source(l.offset));
+            memorySize += l.size;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstLevel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1));
+    }
+    else if (!image.levels.empty())
+    {
+        for (size_t level = firstLevel; level < image.levels.size(); ++level)
+        {
+            const TextureImage::Level &l = image.levels[level];
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), Internal_Format, l.width, l.height, 0, Image_Format,
+                         GL_UNSIGNED_BYTE, source(l.offset));
+            memorySize += l.size;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstLevel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1));
+    }
+    else
+    {
+        // 没有预生成的 mip 链时退回驱动生成
+        glTexImage2D(GL_TEXTURE_2D, 0, Internal_Format, Width, Height, 0, Image_Format, GL_UNSIGNED_BYTE, source(0));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        memorySize = image.pixels.size() * 4 / 3;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // 纹理自身参数与材质采样器一致，未绑定采样器时（如编辑器预览）同样使用三线性过滤
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, Wrap_S);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, Wrap_T);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, Filter_Min);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, Filter_Max);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    Path = image.path;
+    std::cout << "纹理加载成功: " << Path << " ID: " << ID << " flipY: " << flipY << " mip: "
+              << std::max<size_t>(image.levels.size(), 1) << (firstLevel > 0 ? " 流式起始级: " + std::to_string(firstLevel) : "")
+              << (srgb ? " sRGB" : "")
+              << (image.compressedFormat != 0 ? " 块压缩" : "") << " 显存: " << memorySize / 1024 << " KB" << std::endl;
+    return true;
+}
+
+void Texture::ShareStorage(const std::shared_ptr<Texture> &owner, const std::string &path)
+{
+    if (!owner || owner.get() == this)
+        return;
+    if (ID != 0 && !storageOwner)
+        glDeleteTextures(1, &ID);
+
+    // 始终指向真正拥有存储的对象，避免形成共享链
+    storageOwner = owner->storageOwner ? owner->storageOwner : owner;
+    ID = storageOwner->ID;
+    Width = storageOwner->Width;
+    Height = storageOwner->Height;
+    nrComponents = storageOwner->nrComponents;
+    Internal_Format = storageOwner->Internal_Format;
+    Image_Format = storageOwner->Image_Format;
+    srgb = storageOwner->srgb;
+    normalMap = storageOwner->normalMap;
+    memorySize = 0;
+    Path = path;
+}
+
+bool Texture::StreamInLevel(const void *levelPixels)
+{
+    if (!streamSource || residentLevel <= 0 || storageOwner)
+        return false;
+
+    const int level = residentLevel - 1;
+    const TextureImage::Level &l = streamSource->levels[level];
+
+    glBindTexture(GL_TEXTURE_2D, ID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (streamSource->compressedFormat != 0)
+    {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, streamSource->compressedFormat, l.width, l.height, 0,
+                               static_cast<GLsizei>(l.size), levelPixels);
+    }
+    else
+    {
+        glTexImage2D(GL_TEXTURE_2D, level, Internal_Format, l.width, l.height, 0, Image_Format, GL_UNSIGNED_BYTE,
+                     levelPixels);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    // 新级别上传完成后才放开采样范围
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    residentLevel = level;
+    memorySize += l.size;
+    return true;
+}
+
+bool Texture::DropFinestLevel()
+{
+    if (!streamSource || residentLevel >= tailLevel || storageOwner)
+        return false;
+
+    const int level = residentLevel;
+    glBindTexture(GL_TEXTURE_2D, ID);
+    // 先收紧采样范围，再把该级重新指定为空图像以释放显存
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+    if (streamSource->compressedFormat != 0)
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, streamSource->compressedFormat, 0, 0, 0, 0, nullptr);
+    else
+        glTexImage2D(GL_TEXTURE_2D, level, Internal_Format, 0, 0, 0, Image_Format, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    residentLevel = level + 1;
+    memorySize -= streamSource->levels[level].size;
+    return true;
+}
+
+void Texture::RequestScreenSize(float pixels)
+{
+    Texture *target = storageOwner ? storageOwner.get() : this;
+    target->requestedScreenSize = std::max(target->requestedScreenSize, pixels);
+}
+
+void Texture::DetachStorage()
+{
+    if (!storageOwner)
+        return;
+    storageOwner.reset();
+    glGenTextures(1, &ID);
+}
+
+std::shared_ptr<Texture> Texture::LoadCopy(const Texture &source)
+{
+    return TextureManager::GetInstance().GetTexture(source.GetPath(), source.flipY, source.srgb, source.normalMap);
+}
+
+unsigned int Texture::GetMaterialSampler()
+{
+    static unsigned int sampler = 0;
+    if (sampler == 0)
+    {
+        GLfloat maxAnisotropy = 1.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+
+        glGenSamplers(1, &sampler);
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, std::min(maxAnisotropy, 16.0f));
+    }
+    return sampler;
+}
+
+void Texture::SetMaterialSamplerFiltering(bool useMipmaps, float maxAnisotropy)
+{
+    GLuint sampler = GetMaterialSampler();
+    GLfloat supported = 1.0f;
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &supported);
+
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, useMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, std::clamp(maxAnisotropy, 1.0f, supported));
 }
 
 void Texture::CreateSolidColor(const glm::vec3 &color)
@@ -115,6 +520,7 @@ void Texture::CreateNormalMap()
 
 void Texture::LoadCubemap(const std::vector<std::string> &faces)
 {
+    DetachStorage();
     stbi_set_flip_vertically_on_load(false);
     if (faces.size() != 6)
     {
@@ -160,6 +566,7 @@ void Texture::LoadCubemap(const std::vector<std::string> &faces)
 
 void Texture::CreateCubemap(unsigned int width, unsigned int height, unsigned int internalFormat)
 {
+    DetachStorage();
     Width = width;
     Height = height;
     Internal_Format = internalFormat;
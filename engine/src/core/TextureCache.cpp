@@ -0,0 +1,184 @@
+#include "core/TextureCache.hpp"
+#include "core/ContentHash.hpp"
+#include "core/TextureCompressor.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+// 编码器或文件格式变化时递增，旧缓存自动失效
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr char CACHE_MAGIC[4] = {'A', 'M', 'T', 'X'};
+
+bool HasExtension(const char *name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
+} // namespace
+
+TextureCache &TextureCache::GetInstance()
+{
+    static TextureCache instance;
+    return instance;
+}
+
+void TextureCache::Initialize(const std::string &directory)
+{
+    this->directory = directory;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "纹理缓存目录创建失败: " << directory << " 错误: " << error.message() << std::endl;
+        return;
+    }
+
+    // sRGB 颜色贴图需要 S3TC 的 sRGB 变体
+    s3tcSupported = HasExtension("GL_EXT_texture_compression_s3tc") &&
+                    (HasExtension("GL_EXT_texture_sRGB") || HasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+
+    initialized = true;
+    enabled = true;
+    std::cout << "纹理缓存: " << directory << " S3TC: " << (s3tcSupported ? "支持" : "不支持") << std::endl;
+}
+
+uint64_t TextureCache::MakeKey(const std::vector<unsigned char> &fileData, bool flipY, bool srgb, bool normalMap)
+{
+    uint64_t hash = ContentHash::Hash64(fileData.data(), fileData.size());
+    uint64_t options = (flipY ? 1u : 0u) | (srgb ? 2u : 0u) | (normalMap ? 4u : 0u) |
+                       (static_cast<uint64_t>(CACHE_VERSION) << 8);
+    return ContentHash::Combine(hash, options);
+}
+
+std::string TextureCache::GetFilePath(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.amtx", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool TextureCache::Load(uint64_t key, TextureImage &image) const
+{
+    if (!enabled)
+        return false;
+
+    std::ifstream file(GetFilePath(key), std::ios::binary);
+    if (!file)
+        return false;
+
+    FileHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, CACHE_MAGIC, 4) != 0 || header.version != CACHE_VERSION ||
+        header.key != key || TextureCompressor::GetBlockBytes(header.format) == 0 || header.levelCount == 0)
+    {
+        return false;
+    }
+
+    std::vector<FileLevel> fileLevels(header.levelCount);
+    file.read(reinterpret_cast<char *>(fileLevels.data()), sizeof(FileLevel) * header.levelCount);
+    if (!file)
+        return false;
+
+    uint64_t totalSize = 0;
+    std::vector<TextureImage::Level> levels;
+    levels.reserve(fileLevels.size());
+    for (const auto &level : fileLevels)
+    {
+        // 偏移必须连续，尺寸必须与格式一致，防止损坏的文件导致越界
+        if (level.offset != totalSize ||
+            level.size != TextureCompressor::GetLevelSize(header.format, level.width, level.height))
+        {
+            std::cerr << "纹理缓存文件损坏: " << GetFilePath(key) << std::endl;
+            return false;
+        }
+        levels.push_back({level.width, level.height, static_cast<size_t>(level.offset), static_cast<size_t>(level.size)});
+        totalSize += level.size;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(totalSize));
+    file.read(reinterpret_cast<char *>(pixels.data()), static_cast<std::streamsize>(totalSize));
+    if (!file)
+        return false;
+
+    image.width = header.width;
+    image.height = header.height;
+    image.components = header.components;
+    image.srgb = (header.flags & 1u) != 0;
+    image.normalMap = (header.flags & 2u) != 0;
+    image.compressedFormat = header.format;
+    image.pixels = std::move(pixels);
+    image.levels = std::move(levels);
+    return true;
+}
+
+bool TextureCache::Store(uint64_t key, const TextureImage &image) const
+{
+    if (!enabled || image.compressedFormat == 0 || image.levels.empty())
+        return false;
+
+    FileHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.format = image.compressedFormat;
+    header.width = image.width;
+    header.height = image.height;
+    header.components = image.components;
+    header.flags = (image.srgb ? 1u : 0u) | (image.normalMap ? 2u : 0u);
+    header.levelCount = static_cast<uint32_t>(image.levels.size());
+
+    std::vector<FileLevel> fileLevels;
+    fileLevels.reserve(image.levels.size());
+    for (const auto &level : image.levels)
+        fileLevels.push_back({level.width, level.height, level.offset, level.size});
+
+    // 先写临时文件再重命名，多个线程同时写入同一内容时不会读到写了一半的文件
+    std::ostringstream tempName;
+    tempName << GetFilePath(key) << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+    const std::string tempPath = tempName.str();
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "纹理缓存写入失败: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(fileLevels.data()), sizeof(FileLevel) * fileLevels.size());
+        file.write(reinterpret_cast<const char *>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+        if (!file)
+        {
+            std::cerr << "纹理缓存写入失败: " << tempPath << std::endl;
+            file.close();
+            // 在贴图解码作业中执行，清理失败也不能抛出异常
+            std::error_code removeError;
+            std::filesystem::remove(tempPath, removeError);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, GetFilePath(key), error);
+    if (error)
+    {
+        // 其他线程已经写入了同一个缓存文件
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
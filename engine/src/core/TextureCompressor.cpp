@@ -0,0 +1,318 @@
+#include "core/TextureCompressor.hpp"
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{
+// 一个 4x4 块展开为 RGBA，缺失通道补齐（单通道放在 r，alpha 默认 255）
+struct BlockPixels
+{
+    uint8_t rgba[16][4];
+};
+
+void FetchBlock(const unsigned char *pixels, int width, int height, int components, int blockX, int blockY,
+                BlockPixels &block)
+{
+    for (int y = 0; y < 4; ++y)
+    {
+        // 不足 4 像素的边缘块重复最后一行/列
+        int sy = std::min(blockY * 4 + y, height - 1);
+        for (int x = 0; x < 4; ++x)
+        {
+            int sx = std::min(blockX * 4 + x, width - 1);
+            const unsigned char *p = pixels + (static_cast<size_t>(sy) * width + sx) * components;
+            uint8_t *out = block.rgba[y * 4 + x];
+            out[0] = p[0];
+            out[1] = components > 1 ? p[1] : 0;
+            out[2] = components > 2 ? p[2] : 0;
+            out[3] = components > 3 ? p[3] : 255;
+        }
+    }
+}
+
+uint16_t PackRGB565(const int color[3])
+{
+    int r = (color[0] * 31 + 127) / 255;
+    int g = (color[1] * 63 + 127) / 255;
+    int b = (color[2] * 31 + 127) / 255;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRGB565(uint16_t packed, int color[3])
+{
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+void WriteU16(uint8_t *out, uint16_t value)
+{
+    out[0] = static_cast<uint8_t>(value & 0xFF);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+// BC1 颜色块（始终使用 4 色模式，BC3 的颜色部分同样适用）
+void EncodeColorBlock(const BlockPixels &block, uint8_t *out)
+{
+    int minColor[3] = {255, 255, 255};
+    int maxColor[3] = {0, 0, 0};
+    int mean[3] = {0, 0, 0};
+    for (const auto &p : block.rgba)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            minColor[c] = std::min(minColor[c], static_cast<int>(p[c]));
+            maxColor[c] = std::max(maxColor[c], static_cast<int>(p[c]));
+            mean[c] += p[c];
+        }
+    }
+    for (int c = 0; c < 3; ++c)
+        mean[c] = (mean[c] + 8) / 16;
+
+    // 包围盒对角线不一定是主方向：以范围最大的通道为基准，协方差为负的通道交换端点
+    int mainChannel = 0;
+    for (int c = 1; c < 3; ++c)
+    {
+        if (maxColor[c] - minColor[c] > maxColor[mainChannel] - minColor[mainChannel])
+            mainChannel = c;
+    }
+    for (int c = 0; c < 3; ++c)
+    {
+        if (c == mainChannel)
+            continue;
+        int covariance = 0;
+        for (const auto &p : block.rgba)
+            covariance += (p[mainChannel] - mean[mainChannel]) * (p[c] - mean[c]);
+        if (covariance < 0)
+            std::swap(minColor[c], maxColor[c]);
+    }
+
+    // 端点向内收缩 1/16，减小量化误差
+    for (int c = 0; c < 3; ++c)
+    {
+        int inset = (maxColor[c] - minColor[c]) / 16;
+        maxColor[c] -= inset;
+        minColor[c] += inset;
+    }
+
+    uint16_t color0 = PackRGB565(maxColor);
+    uint16_t color1 = PackRGB565(minColor);
+    if (color0 < color1)
+        std::swap(color0, color1);
+
+    WriteU16(out, color0);
+    WriteU16(out + 2, color1);
+
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        int palette[4][3];
+        UnpackRGB565(color0, palette[0]);
+        UnpackRGB565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i)
+        {
+            const uint8_t *p = block.rgba[i];
+            int best = 0, bestError = INT32_MAX;
+            for (int j = 0; j < 4; ++j)
+            {
+                int dr = p[0] - palette[j][0], dg = p[1] - palette[j][1], db = p[2] - palette[j][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = j;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+    }
+    // 两个端点相同时所有索引为 0
+    out[4] = static_cast<uint8_t>(indices);
+    out[5] = static_cast<uint8_t>(indices >> 8);
+    out[6] = static_cast<uint8_t>(indices >> 16);
+    out[7] = static_cast<uint8_t>(indices >> 24);
+}
+
+// BC4 单通道块（BC3 的 alpha 和 BC5 的每个通道格式相同），使用 8 值模式
+void EncodeSingleChannelBlock(const BlockPixels &block, int channel, uint8_t *out)
+{
+    int minValue = 255, maxValue = 0;
+    for (const auto &p : block.rgba)
+    {
+        minValue = std::min(minValue, static_cast<int>(p[channel]));
+        maxValue = std::max(maxValue, static_cast<int>(p[channel]));
+    }
+
+    out[0] = static_cast<uint8_t>(maxValue);
+    out[1] = static_cast<uint8_t>(minValue);
+
+    uint64_t indices = 0;
+    if (maxValue != minValue)
+    {
+        // 索引 0、1 为端点，2..7 为由 max 到 min 的插值
+        int palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (int j = 1; j < 7; ++j)
+            palette[j + 1] = ((7 - j) * maxValue + j * minValue) / 7;
+
+        for (int i = 0; i < 16; ++i)
+        {
+            int value = block.rgba[i][channel];
+            int best = 0, bestError = INT32_MAX;
+            for (int j = 0; j < 8; ++j)
+            {
+                int error = std::abs(value - palette[j]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = j;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; ++i)
+        out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+}
+
+void EncodeBlock(const BlockPixels &block, unsigned int format, uint8_t *out)
+{
+    switch (format)
+    {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        EncodeColorBlock(block, out);
+        break;
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        EncodeSingleChannelBlock(block, 3, out);
+        EncodeColorBlock(block, out + 8);
+        break;
+    case GL_COMPRESSED_RED_RGTC1:
+        EncodeSingleChannelBlock(block, 0, out);
+        break;
+    case GL_COMPRESSED_RG_RGTC2:
+        EncodeSingleChannelBlock(block, 0, out);
+        EncodeSingleChannelBlock(block, 1, out + 8);
+        break;
+    default:
+        break;
+    }
+}
+
+bool HasTransparency(const TextureImage &image)
+{
+    if (image.components != 4)
+        return false;
+    // 只检查第 0 级，下采样不会产生新的透明像素
+    size_t count = static_cast<size_t>(image.width) * image.height;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (image.pixels[i * 4 + 3] != 255)
+            return true;
+    }
+    return false;
+}
+} // namespace
+
+unsigned int TextureCompressor::ChooseFormat(const TextureImage &image, bool s3tcSupported)
+{
+    if (!image.IsValid() || image.compressedFormat != 0)
+        return 0;
+
+    if (image.normalMap && image.components >= 3)
+        return GL_COMPRESSED_RG_RGTC2;
+    if (image.components == 1)
+        return GL_COMPRESSED_RED_RGTC1;
+    if (image.components == 2 || !s3tcSupported)
+        return 0;
+
+    if (HasTransparency(image))
+        return image.srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    return image.srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+}
+
+bool TextureCompressor::Compress(TextureImage &image, unsigned int format)
+{
+    const size_t blockBytes = GetBlockBytes(format);
+    if (blockBytes == 0 || !image.IsValid() || image.compressedFormat != 0)
+        return false;
+
+    // 没有 mip 链时按第 0 级处理
+    std::vector<TextureImage::Level> sourceLevels = image.levels;
+    if (sourceLevels.empty())
+        sourceLevels.push_back({image.width, image.height, 0, image.pixels.size()});
+
+    std::vector<TextureImage::Level> levels;
+    levels.reserve(sourceLevels.size());
+    size_t totalSize = 0;
+    for (const auto &level : sourceLevels)
+    {
+        size_t size = GetLevelSize(format, level.width, level.height);
+        levels.push_back({level.width, level.height, totalSize, size});
+        totalSize += size;
+    }
+
+    std::vector<unsigned char> compressed(totalSize);
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        const TextureImage::Level &src = sourceLevels[i];
+        const TextureImage::Level &dst = levels[i];
+        const unsigned char *srcPixels = image.pixels.data() + src.offset;
+        unsigned char *dstBlocks = compressed.data() + dst.offset;
+        const int blocksX = (src.width + 3) / 4;
+        const int blocksY = (src.height + 3) / 4;
+
+        // 块行互不依赖，按行分发到作业系统
+        JobSystem::GetInstance().ParallelFor(0, blocksY, 8, [&](size_t begin, size_t end) {
+            BlockPixels block;
+            for (size_t by = begin; by < end; ++by)
+            {
+                for (int bx = 0; bx < blocksX; ++bx)
+                {
+                    FetchBlock(srcPixels, src.width, src.height, image.components, bx, static_cast<int>(by), block);
+                    EncodeBlock(block, format, dstBlocks + (by * blocksX + bx) * blockBytes);
+                }
+            }
+        });
+    }
+
+    image.pixels = std::move(compressed);
+    image.levels = std::move(levels);
+    image.compressedFormat = format;
+    return true;
+}
+
+size_t TextureCompressor::GetBlockBytes(unsigned int format)
+{
+    switch (format)
+    {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RED_RGTC1:
+        return 8;
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_RG_RGTC2:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+size_t TextureCompressor::GetLevelSize(unsigned int format, int width, int height)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(format);
+}
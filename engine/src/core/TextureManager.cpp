@@ -1,4 +1,8 @@
 #include "core/TextureManager.hpp"
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
 TextureManager& TextureManager::GetInstance()
@@ -12,27 +16,34 @@ std::shared_ptr<Texture> TextureManager::GetTexture(const std::string& path)
     return GetTexture(path, true); // 默认翻转
 }
 
-std::shared_ptr<Texture> TextureManager::GetTexture(const std::string& path, bool flipY)
+std::shared_ptr<Texture> TextureManager::GetTexture(const std::string& path, bool flipY, bool srgb, bool normalMap)
 {
     if (path.empty()) {
         return nullptr;
     }
     
-    // 创建包含flipY信息的缓存键
-    std::string cacheKey = path + "_flip_" + (flipY ? "1" : "0");
+    std::string cacheKey = MakeCacheKey(path, flipY, srgb, normalMap);
     
     // Check if texture already exists in cache
     auto it = textureCache.find(cacheKey);
     if (it != textureCache.end()) {
-        return it->second;
+        ++stats.hits;
+        it->second.lastUsedFrame = frameIndex;
+        return it->second.texture;
     }
+    ++stats.misses;
     
     // Create new texture
     auto texture = std::make_shared<Texture>();
     texture->flipY = flipY; // 设置翻转状态
+    texture->srgb = srgb;
+    texture->normalMap = normalMap;
     
-    if (texture->LoadFromFile(path)) {
-        textureCache[cacheKey] = texture;
+    TextureImage image;
+    image.srgb = srgb;
+    image.normalMap = normalMap;
+    if (Texture::DecodeFile(path, flipY, image) && UploadOrShare(texture, image)) {
+        textureCache[cacheKey] = {texture, frameIndex};
     } else {
         std::cerr << "Texture failed to load, not cached: " << path << std::endl;
         return nullptr;
@@ -41,12 +52,386 @@ std::shared_ptr<Texture> TextureManager::GetTexture(const std::string& path, boo
     return texture;
 }
 
+std::shared_ptr<Texture> TextureManager::GetTextureAsync(const std::string& path, bool flipY, bool srgb, bool normalMap)
+{
+    if (path.empty()) {
+        return nullptr;
+    }
+
+    std::string cacheKey = MakeCacheKey(path, flipY, srgb, normalMap);
+    auto it = textureCache.find(cacheKey);
+    if (it != textureCache.end()) {
+        ++stats.hits;
+        it->second.lastUsedFrame = frameIndex;
+        return it->second.texture;
+    }
+    ++stats.misses;
+
+    // 先放入缓存，重复请求直接得到同一个占位纹理
+    auto texture = std::make_shared<Texture>();
+    texture->flipY = flipY;
+    texture->srgb = srgb;
+    texture->normalMap = normalMap;
+    texture->CreateSolidColor(glm::vec3(1.0f));
+    textureCache[cacheKey] = {texture, frameIndex};
+
+    auto task = std::make_shared<DecodeTask>();
+    task->path = path;
+    task->flipY = flipY;
+    task->image.srgb = srgb;
+    task->image.normalMap = normalMap;
+    pendingUploads.push_back({cacheKey, texture, task});
+
+    // 读文件与解码放入后台队列，不占用帧内工作线程
+    JobSystem::GetInstance().ScheduleBackground([task]() {
+        Texture::DecodeFile(task->path, task->flipY, task->image);
+        task->ready.store(true, std::memory_order_release);
+    });
+    return texture;
+}
+
+bool TextureManager::UploadImage(Texture& texture, const TextureImage& image, int firstLevel)
+{
+    if (!image.IsValid()) {
+        return false;
+    }
+
+    if (!uploadRing) {
+        uploadRing = std::make_unique<PixelUploadRing>(uploadBudgetBytes);
+    }
+
+    // 各级 mip 连续存放且第 0 级在最前，从 firstLevel 开始的级别是 pixels 的一段后缀
+    size_t skip = firstLevel > 0 && firstLevel < static_cast<int>(image.levels.size()) ? image.levels[firstLevel].offset : 0;
+    size_t bytes = image.pixels.size() - skip;
+    frameUploadBytes += bytes;
+
+    size_t offset = 0;
+    void* mapped = nullptr;
+    if (!uploadRing->Allocate(bytes, offset, mapped)) {
+        // 超出当前段容量：直接从内存上传
+        return texture.UploadPixels(image, image.pixels.data(), firstLevel);
+    }
+
+    // 像素拷贝进持久映射缓冲，glTexImage2D 从缓冲偏移读取，由驱动异步传输；
+    // 缓冲中 offset 处是第 firstLevel 级，更粗的级别紧随其后
+    std::memcpy(mapped, image.pixels.data() + skip, bytes);
+    uploadRing->Bind();
+    bool result = texture.UploadPixels(image, offset, firstLevel);
+    PixelUploadRing::Unbind();
+    return result;
+}
+
+std::shared_ptr<Texture> TextureManager::AddTexture(const std::string& path, bool flipY, TextureImage& image)
+{
+    std::string cacheKey = MakeCacheKey(path, flipY, image.srgb, image.normalMap);
+    auto it = textureCache.find(cacheKey);
+    if (it != textureCache.end()) {
+        ++stats.hits;
+        it->second.lastUsedFrame = frameIndex;
+        return it->second.texture;
+    }
+    ++stats.misses;
+
+    auto texture = std::make_shared<Texture>();
+    texture->flipY = flipY;
+    texture->srgb = image.srgb;
+    texture->normalMap = image.normalMap;
+    if (!UploadOrShare(texture, image)) {
+        std::cerr << "Texture failed to load, not cached: " << path << std::endl;
+        return nullptr;
+    }
+    textureCache[cacheKey] = {texture, frameIndex};
+    return texture;
+}
+
+bool TextureManager::UploadOrShare(const std::shared_ptr<Texture>& texture, TextureImage& image)
+{
+    if (image.contentHash != 0) {
+        auto it = contentIndex.find(image.contentHash);
+        if (it != contentIndex.end()) {
+            if (auto owner = it->second.lock()) {
+                texture->ShareStorage(owner, image.path);
+                ++stats.dedupHits;
+                stats.dedupBytes += owner->GetMemorySize();
+                std::cout << "纹理内容重复，共用已有纹理: " << image.path << " -> " << owner->GetPath() << std::endl;
+                return true;
+            }
+        }
+    }
+
+    const uint64_t contentHash = image.contentHash;
+    int tailLevel = streamingEnabled ? ChooseTailLevel(image) : 0;
+    if (!UploadImage(*texture, image, tailLevel)) {
+        return false;
+    }
+    if (tailLevel > 0) {
+        // 只上传了 mip 尾部：保留完整 mip 链，更细的级别按屏幕尺寸流入
+        texture->SetStreamSource(std::make_shared<TextureImage>(std::move(image)));
+        streamingTextures.push_back({texture});
+    }
+    if (contentHash != 0) {
+        contentIndex[contentHash] = texture;
+    }
+    return true;
+}
+
+int TextureManager::ChooseTailLevel(const TextureImage& image)
+{
+    if (image.levels.size() < 2 || std::max(image.width, image.height) <= STREAMING_MIN_SIZE) {
+        return 0;
+    }
+    // 初始只上传不大于 STREAMING_TAIL_SIZE 的级别，模型可以立即以低分辨率显示
+    int level = 0;
+    while (level + 1 < static_cast<int>(image.levels.size()) &&
+           std::max(image.levels[level].width, image.levels[level].height) > STREAMING_TAIL_SIZE) {
+        ++level;
+    }
+    return level;
+}
+
+std::shared_ptr<Texture> TextureManager::FindTexture(const std::string& path, bool flipY, bool srgb, bool normalMap) const
+{
+    auto it = textureCache.find(MakeCacheKey(path, flipY, srgb, normalMap));
+    return it != textureCache.end() ? it->second.texture : nullptr;
+}
+
+void TextureManager::ProcessUploads()
+{
+    for (auto it = pendingUploads.begin(); it != pendingUploads.end();) {
+        if (!it->task->ready.load(std::memory_order_acquire)) {
+            ++it;
+            continue;
+        }
+
+        TextureImage& image = it->task->image;
+        if (!image.IsValid()) {
+            std::cerr << "Texture failed to load, not cached: " << it->task->path << std::endl;
+            textureCache.erase(it->cacheKey);
+            it = pendingUploads.erase(it);
+            continue;
+        }
+
+        // 超出本帧预算的纹理留到下一帧（本帧尚未上传任何数据时总是放行）
+        if (frameUploadBytes > 0 && frameUploadBytes + image.pixels.size() > uploadBudgetBytes) {
+            break;
+        }
+
+        UploadOrShare(it->texture, image);
+        it = pendingUploads.erase(it);
+    }
+
+    ++frameIndex;
+    UpdateResidency();
+    if (stats.residentBytes > memoryBudgetBytes) {
+        Evict(memoryBudgetBytes);
+    }
+    UpdateStreaming();
+
+    if (uploadRing) {
+        uploadRing->EndFrame();
+    }
+    lastFrameUploadBytes = frameUploadBytes;
+    frameUploadBytes = 0;
+}
+
+void TextureManager::UpdateStreaming()
+{
+    // 1. 根据上一帧的屏幕尺寸请求更新目标级别，移除已释放的纹理
+    // active 持有强引用，本函数中淘汰未引用纹理时不会释放正在处理的流式纹理
+    stats.streamingCount = 0;
+    std::vector<std::pair<StreamingEntry*, std::shared_ptr<Texture>>> active;
+    for (auto it = streamingTextures.begin(); it != streamingTextures.end();) {
+        auto texture = it->texture.lock();
+        if (!texture || !texture->IsStreaming()) {
+            it = streamingTextures.erase(it);
+            continue;
+        }
+
+        float screenSize = texture->TakeRequestedScreenSize();
+        if (screenSize > 0.0f) {
+            it->screenSize = screenSize;
+            it->lastRequestFrame = frameIndex;
+        } else if (frameIndex - it->lastRequestFrame > STREAMING_IDLE_FRAMES) {
+            it->screenSize = 0.0f; // 一段时间不可见，退回 mip 尾部
+        }
+        it->desiredLevel = GetDesiredLevel(*texture, it->screenSize);
+
+        ++stats.streamingCount;
+        active.emplace_back(&*it, std::move(texture));
+        ++it;
+    }
+    if (active.empty()) {
+        return;
+    }
+
+    auto levelSize = [](const Texture& texture, int level) {
+        return texture.GetStreamSource()->levels[level].size;
+    };
+    auto dropLevel = [&](Texture& texture) {
+        size_t bytes = levelSize(texture, texture.GetResidentLevel());
+        if (!texture.DropFinestLevel()) {
+            return false;
+        }
+        stats.residentBytes -= bytes;
+        stats.referencedBytes -= std::min(stats.referencedBytes, bytes);
+        ++stats.droppedLevels;
+        return true;
+    };
+
+    // 2. 释放比目标更细的级别（物体变远或不再可见）
+    for (auto& [entry, texture] : active) {
+        while (texture->GetResidentLevel() < entry->desiredLevel && dropLevel(*texture)) {
+        }
+    }
+
+    // 3. 仍然超出预算：从屏幕尺寸最小的纹理开始逐级降低分辨率，直到回到预算内
+    std::sort(active.begin(), active.end(),
+              [](const auto& a, const auto& b) { return a.first->screenSize < b.first->screenSize; });
+    bool dropped = true;
+    while (stats.residentBytes > memoryBudgetBytes && dropped) {
+        dropped = false;
+        for (auto& [entry, texture] : active) {
+            if (stats.residentBytes <= memoryBudgetBytes) {
+                break;
+            }
+            dropped |= dropLevel(*texture);
+        }
+    }
+
+    // 4. 每个纹理每帧流入一级，受显存预算和本帧上传预算限制
+    // 屏幕尺寸越大越优先（active 已按屏幕尺寸升序排列，逆序遍历）
+    for (auto it = active.rbegin(); it != active.rend(); ++it) {
+        StreamingEntry* entry = it->first;
+        Texture* texture = it->second.get();
+        if (texture->GetResidentLevel() <= entry->desiredLevel) {
+            continue;
+        }
+        const int level = texture->GetResidentLevel() - 1;
+        const TextureImage& source = *texture->GetStreamSource();
+        const size_t bytes = source.levels[level].size;
+
+        if (stats.residentBytes + bytes > memoryBudgetBytes) {
+            // 先淘汰未引用的纹理腾出空间，仍然不够时保持当前分辨率
+            Evict(bytes < memoryBudgetBytes ? memoryBudgetBytes - bytes : 0);
+            if (stats.residentBytes + bytes > memoryBudgetBytes) {
+                continue;
+            }
+        }
+        if (frameUploadBytes > 0 && frameUploadBytes + bytes > uploadBudgetBytes) {
+            break;
+        }
+
+        if (!uploadRing) {
+            uploadRing = std::make_unique<PixelUploadRing>(uploadBudgetBytes);
+        }
+        size_t offset = 0;
+        void* mapped = nullptr;
+        const unsigned char* levelPixels = source.pixels.data() + source.levels[level].offset;
+        bool uploaded;
+        if (uploadRing->Allocate(bytes, offset, mapped)) {
+            std::memcpy(mapped, levelPixels, bytes);
+            uploadRing->Bind();
+            uploaded = texture->StreamInLevel(reinterpret_cast<const void*>(offset));
+            PixelUploadRing::Unbind();
+        } else {
+            uploaded = texture->StreamInLevel(levelPixels);
+        }
+
+        if (uploaded) {
+            frameUploadBytes += bytes;
+            stats.residentBytes += bytes;
+            stats.referencedBytes += bytes;
+            ++stats.streamedLevels;
+        }
+    }
+}
+
+int TextureManager::GetDesiredLevel(const Texture& texture, float screenSize)
+{
+    const TextureImage& source = *texture.GetStreamSource();
+    if (screenSize <= 0.0f) {
+        return texture.GetTailLevel();
+    }
+    // 纹理大约铺满物体一次：纹素数与屏幕像素数之比为 2^level 时第 level 级恰好一纹素对应一像素
+    float texels = static_cast<float>(std::max(source.width, source.height));
+    int level = static_cast<int>(std::floor(std::log2(std::max(texels / screenSize, 1.0f))));
+    return std::clamp(level, 0, texture.GetTailLevel());
+}
+
+size_t TextureManager::EvictUnused()
+{
+    UpdateResidency();
+    return Evict(0);
+}
+
+void TextureManager::UpdateResidency()
+{
+    for (auto it = contentIndex.begin(); it != contentIndex.end();) {
+        if (it->second.expired()) {
+            it = contentIndex.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    stats.residentBytes = 0;
+    stats.referencedBytes = 0;
+    stats.residentCount = textureCache.size();
+    stats.referencedCount = 0;
+    for (auto& [key, entry] : textureCache) {
+        size_t bytes = entry.texture->GetMemorySize();
+        stats.residentBytes += bytes;
+        // 缓存自身持有一份引用，超过一份说明材质、模型、编辑器或共享其存储的纹理仍在使用（包括等待上传的异步纹理）
+        if (entry.texture.use_count() > 1) {
+            entry.lastUsedFrame = frameIndex;
+            stats.referencedBytes += bytes;
+            ++stats.referencedCount;
+        }
+    }
+}
+
+size_t TextureManager::Evict(size_t targetBytes)
+{
+    std::vector<std::pair<uint64_t, std::string>> candidates;
+    for (const auto& [key, entry] : textureCache) {
+        if (entry.texture.use_count() == 1) {
+            candidates.emplace_back(entry.lastUsedFrame, key);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t freedBytes = 0;
+    for (const auto& [lastUsedFrame, key] : candidates) {
+        if (stats.residentBytes <= targetBytes) {
+            break;
+        }
+        auto it = textureCache.find(key);
+        size_t bytes = it->second.texture->GetMemorySize();
+        textureCache.erase(it);
+
+        stats.residentBytes -= bytes;
+        --stats.residentCount;
+        ++stats.evictions;
+        stats.evictedBytes += bytes;
+        freedBytes += bytes;
+    }
+    return freedBytes;
+}
+
 void TextureManager::ClearCache()
 {
     textureCache.clear();
+    contentIndex.clear();
+    pendingUploads.clear();
 }
 
 size_t TextureManager::GetCacheSize() const
 {
     return textureCache.size();
 }
+
+std::string TextureManager::MakeCacheKey(const std::string& path, bool flipY, bool srgb, bool normalMap)
+{
+    // 创建包含flipY、颜色空间和用途信息的缓存键
+    return path + "_flip_" + (flipY ? "1" : "0") + (srgb ? "_srgb" : "") + (normalMap ? "_normal" : "");
+}
@@ -0,0 +1,38 @@
+#include "core/UniformBuffer.hpp"
+#include <iostream>
+
+UniformBuffer::UniformBuffer(size_t size, GLuint binding) : size(size), binding(binding)
+{
+    glGenBuffers(1, &ID);
+    glBindBuffer(GL_UNIFORM_BUFFER, ID);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    Bind();
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    if (ID != 0)
+    {
+        glDeleteBuffers(1, &ID);
+        ID = 0;
+    }
+}
+
+void UniformBuffer::Update(const void *data, size_t dataSize, size_t offset) const
+{
+    if (offset + dataSize > size)
+    {
+        std::cerr << "UniformBuffer::Update out of range: " << offset + dataSize << " > " << size << std::endl;
+        return;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, ID);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, dataSize, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffer::Bind() const
+{
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, ID);
+}
@@ -1,10 +1,10 @@
 #include "core/Application.hpp"
 
-int main()
+int main(int argc, char **argv)
 {
     // 创建应用程序实例并运行
     setlocale(LC_ALL, "zh_CN.UTF-8"); // 设置中文环境
-    Application app;
+    Application app(argc, argv);
     app.Run();
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#include "ui/EditorUI.hpp"
 #include "core/Application.hpp"
+#include "core/TextureManager.hpp"
 #include "glm/gtc/type_ptr.hpp"
 #include "imgui.h"
 #include "utils/FileDialog.hpp"
@@ -256,12 +257,14 @@ void EditorUI::ShowAssetsPanel()
     ImGui::SameLine();
     if (ImGui::Button(ConvertToUTF8(L"清除缓存").c_str()))
     {
-        preloadedAssets.clear();
         for (auto& item : assetItems)
         {
+            item.resource.reset();
             item.isPreloaded = false;
             item.previewTexture.reset();
         }
+        // 预加载的纹理只由资源条目引用，释放引用后立即从显存中淘汰
+        TextureManager::GetInstance().EvictUnused();
     }
     ImGui::Text(ConvertToUTF8(L"路径: %s").c_str(), currentAssetPath.c_str());
 
@@ -450,6 +453,12 @@ void EditorUI::ShowViewport()
     {
         // 注意：OpenGL纹理坐标原点在左下，ImGui在左上，所以需要翻转Y轴
         ImGui::Image((void *)(intptr_t)textureID, viewportSize, ImVec2(0, 1), ImVec2(1, 0));
+        if (renderer->GetPendingShaderCount() > 0)
+        {
+            ImGui::SetCursorPos(ImVec2(ImGui::GetWindowContentRegionMin().x + 8.0f,
+                                       ImGui::GetWindowContentRegionMin().y + 8.0f));
+            ImGui::Text(ConvertToUTF8(L"着色器编译中，剩余 %zu 个").c_str(), renderer->GetPendingShaderCount());
+        }
     }
     else
     {
@@ -585,7 +594,7 @@ void EditorUI::ShowAssetContextMenu(AssetItem& item)
         switch (item.type)
         {
             case AssetType::MODEL:
-                renderer->LoadModel(item.path.string());
+                renderer->LoadModelAsync(item.path.string());
                 break;
             case AssetType::TEXTURE:
                 // 加载纹理
@@ -943,7 +952,7 @@ void EditorUI::ShowSceneHierarchy()
                 "Model Files\0*.obj;*.fbx;*.gltf;*.glb;*.pmx\0All Files\0*.*\0"
             );
             if (!modelPath.empty()) {
-                renderer->LoadModel(modelPath);
+                renderer->LoadModelAsync(modelPath);
             }
         }
         
@@ -1131,25 +1140,25 @@ void EditorUI::ShowSceneHierarchy()
                     
                     // 复制纹理
                     if (originalMaterial->diffuseMap) {
-                        newMaterial->diffuseMap = std::make_shared<Texture>(originalMaterial->diffuseMap->GetPath());
+                        newMaterial->diffuseMap = Texture::LoadCopy(*originalMaterial->diffuseMap);
                     }
                     if (originalMaterial->specularMap) {
-                        newMaterial->specularMap = std::make_shared<Texture>(originalMaterial->specularMap->GetPath());
+                        newMaterial->specularMap = Texture::LoadCopy(*originalMaterial->specularMap);
                     }
                     if (originalMaterial->normalMap) {
-                        newMaterial->normalMap = std::make_shared<Texture>(originalMaterial->normalMap->GetPath());
+                        newMaterial->normalMap = Texture::LoadCopy(*originalMaterial->normalMap);
                     }
                     if (originalMaterial->albedoMap) {
-                        newMaterial->albedoMap = std::make_shared<Texture>(originalMaterial->albedoMap->GetPath());
+                        newMaterial->albedoMap = Texture::LoadCopy(*originalMaterial->albedoMap);
                     }
                     if (originalMaterial->metallicMap) {
-                        newMaterial->metallicMap = std::make_shared<Texture>(originalMaterial->metallicMap->GetPath());
+                        newMaterial->metallicMap = Texture::LoadCopy(*originalMaterial->metallicMap);
                     }
                     if (originalMaterial->roughnessMap) {
-                        newMaterial->roughnessMap = std::make_shared<Texture>(originalMaterial->roughnessMap->GetPath());
+                        newMaterial->roughnessMap = Texture::LoadCopy(*originalMaterial->roughnessMap);
                     }
                     if (originalMaterial->aoMap) {
-                        newMaterial->aoMap = std::make_shared<Texture>(originalMaterial->aoMap->GetPath());
+                        newMaterial->aoMap = Texture::LoadCopy(*originalMaterial->aoMap);
                     }
                     
                     // 在相同位置创建新几何体
@@ -1374,25 +1383,25 @@ void EditorUI::ShowSceneHierarchy()
                 
                 // 复制纹理
                 if (originalMaterial->diffuseMap) {
-                    newMaterial->diffuseMap = std::make_shared<Texture>(originalMaterial->diffuseMap->GetPath());
+                    newMaterial->diffuseMap = Texture::LoadCopy(*originalMaterial->diffuseMap);
                 }
                 if (originalMaterial->specularMap) {
-                    newMaterial->specularMap = std::make_shared<Texture>(originalMaterial->specularMap->GetPath());
+                    newMaterial->specularMap = Texture::LoadCopy(*originalMaterial->specularMap);
                 }
                 if (originalMaterial->normalMap) {
-                    newMaterial->normalMap = std::make_shared<Texture>(originalMaterial->normalMap->GetPath());
+                    newMaterial->normalMap = Texture::LoadCopy(*originalMaterial->normalMap);
                 }
                 if (originalMaterial->albedoMap) {
-                    newMaterial->albedoMap = std::make_shared<Texture>(originalMaterial->albedoMap->GetPath());
+                    newMaterial->albedoMap = Texture::LoadCopy(*originalMaterial->albedoMap);
                 }
                 if (originalMaterial->metallicMap) {
-                    newMaterial->metallicMap = std::make_shared<Texture>(originalMaterial->metallicMap->GetPath());
+                    newMaterial->metallicMap = Texture::LoadCopy(*originalMaterial->metallicMap);
                 }
                 if (originalMaterial->roughnessMap) {
-                    newMaterial->roughnessMap = std::make_shared<Texture>(originalMaterial->roughnessMap->GetPath());
+                    newMaterial->roughnessMap = Texture::LoadCopy(*originalMaterial->roughnessMap);
                 }
                 if (originalMaterial->aoMap) {
-                    newMaterial->aoMap = std::make_shared<Texture>(originalMaterial->aoMap->GetPath());
+                    newMaterial->aoMap = Texture::LoadCopy(*originalMaterial->aoMap);
                 }
                 
                 // 在相同位置创建新几何体（完全相同的变换）
@@ -1543,13 +1552,26 @@ void EditorUI::ShowInspector()
             model->SetTransform(position, rotation, scale);
 
             // 材质编辑器 可能有很多个不同的mesh，imgui需要分配不同id
-            for (auto &mesh : model->GetMeshes())
+            // 默认编辑同一模型文件所有实例共享的材质，勾选“独立材质”后只修改当前实例
+            const auto &meshes = model->GetMeshes();
+            for (size_t i = 0; i < meshes.size(); ++i)
             {
-                ImGui::PushID(&mesh);
+                const auto &mesh = meshes[i];
+                ImGui::PushID(static_cast<int>(i));
                 ImGui::Text("%s: %s", ConvertToUTF8(L"网格").c_str(), mesh->GetName().c_str());
                 if (ImGui::TreeNode(mesh->GetName().c_str()))
                 {
-                    ShowMaterialEditor(*mesh->GetMaterial());
+                    bool overridden = model->HasMaterialOverride(i);
+                    if (ImGui::Checkbox(ConvertToUTF8(L"独立材质").c_str(), &overridden))
+                    {
+                        if (overridden)
+                            model->OverrideMaterial(i);
+                        else
+                            model->ResetMaterial(i);
+                    }
+                    DrawTooltip(ConvertToUTF8(L"复制一份只属于当前模型实例的材质，取消后恢复共享材质").c_str());
+
+                    ShowMaterialEditor(*model->GetMaterial(i));
                     ImGui::TreePop();
                 }
                 ImGui::PopID();
@@ -1894,20 +1916,14 @@ void EditorUI::TextureSelector(const std::string &label, std::shared_ptr<Texture
         );
         if (!path.empty())
         {
+            // 经由 TextureManager 加载（可能与其他材质共享，不能原地修改），保持翻转设置，颜色贴图使用 sRGB 格式
+            bool flip = texture ? texture->flipY : true;
+            texture = TextureManager::GetInstance().GetTexture(path, flip, idSuffix == "diffuse" || idSuffix == "albedo",
+                                                               idSuffix == "normal");
             if (!texture)
-                texture = std::make_shared<Texture>();
-                
-            // 保持翻转设置
-            bool prevFlip = texture->flipY;
-            if (!texture->LoadFromFile(path))
             {
-                texture.reset();
                 Application::AddConsoleLog(ConvertToUTF8(L"贴图加载失败: ") + path);
             }
-            else
-            {
-                texture->flipY = prevFlip;
-            }
         }
     }
     
@@ -1925,13 +1941,13 @@ void EditorUI::TextureSelector(const std::string &label, std::shared_ptr<Texture
         
         // 翻转Y轴选项
         bool flip = texture->flipY;
-        if (ImGui::Checkbox(ConvertToUTF8(L"翻转Y轴").c_str(), &flip))
+        if (ImGui::Checkbox(ConvertToUTF8(L"翻转Y轴").c_str(), &flip) && !texture->GetPath().empty())
         {
-            texture->flipY = flip;
-            if (!texture->GetPath().empty())
-            {
-                texture->LoadFromFile(texture->GetPath());
-            }
+            // 翻转是缓存键的一部分，换成另一份纹理而不是重新加载共享的这一份
+            auto flipped = TextureManager::GetInstance().GetTexture(texture->GetPath(), flip, texture->srgb,
+                                                                    texture->normalMap);
+            if (flipped)
+                texture = flipped;
         }
         DrawTooltip(ConvertToUTF8(L"某些贴图可能需要翻转Y轴以正确显示").c_str());
         
@@ -1955,9 +1971,11 @@ void EditorUI::TextureSelector(const std::string &label, std::shared_ptr<Texture
                 const auto& asset = assetItems[assetIndex];
                 if (asset.type == AssetType::TEXTURE)
                 {
-                    if (!texture)
-                        texture = std::make_shared<Texture>();
-                    texture->LoadFromFile(asset.path.string());
+                    auto loaded = TextureManager::GetInstance().GetTexture(
+                        asset.path.string(), texture ? texture->flipY : true, idSuffix == "diffuse" || idSuffix == "albedo",
+                        idSuffix == "normal");
+                    if (loaded)
+                        texture = loaded;
                 }
             }
         }
@@ -1976,7 +1994,7 @@ void EditorUI::ShowRendererSettings()
     if (ImGui::CollapsingHeader(ConvertToUTF8(L"基础渲染").c_str(), ImGuiTreeNodeFlags_DefaultOpen))
     {
         // 渲染模式
-        static const char *renderModes[] = {"Forward", "Deferred"};
+        static const char *renderModes[] = {"Forward", "Deferred", "Tiled Deferred"};
         int currentMode = static_cast<int>(renderer->GetRenderMode());
         if (ImGui::Combo(ConvertToUTF8(L"渲染模式").c_str(), &currentMode, renderModes, IM_ARRAYSIZE(renderModes)))
         {
@@ -2016,6 +2034,12 @@ void EditorUI::ShowRendererSettings()
         ShowShadowSettings();
     }
 
+    // 纹理显存
+    if (ImGui::CollapsingHeader(ConvertToUTF8(L"纹理内存").c_str()))
+    {
+        ShowTextureMemorySettings();
+    }
+
     ImGui::End();
 }
 
@@ -2448,6 +2472,149 @@ void EditorUI::ShowShadowSettings()
         renderer->SetShadow(shadow);
     }
     DrawTooltip(ConvertToUTF8(L"启用实时阴影渲染").c_str());
+
+    CascadedShadowMap *cascades = renderer->GetCascadedShadowMap();
+    if (shadow && cascades)
+    {
+        int cascadeCount = cascades->GetCascadeCount();
+        if (ImGui::SliderInt(ConvertToUTF8(L"级联数量").c_str(), &cascadeCount, CascadedShadowMap::MIN_CASCADES,
+                             CascadedShadowMap::MAX_CASCADES))
+        {
+            cascades->SetCascadeCount(cascadeCount);
+        }
+        DrawTooltip(ConvertToUTF8(L"方向光阴影沿相机视锥划分的段数").c_str());
+
+        const int resolutions[] = {512, 1024, 2048, 4096};
+        const char *resolutionNames[] = {"512", "1024", "2048", "4096"};
+        int resolutionIndex = 1;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (resolutions[i] == cascades->GetResolution())
+                resolutionIndex = i;
+        }
+        if (ImGui::Combo(ConvertToUTF8(L"级联分辨率").c_str(), &resolutionIndex, resolutionNames, 4))
+        {
+            cascades->SetResolution(resolutions[resolutionIndex]);
+        }
+
+        float lambda = cascades->GetSplitLambda();
+        if (ImGui::SliderFloat(ConvertToUTF8(L"分割系数").c_str(), &lambda, 0.0f, 1.0f))
+        {
+            cascades->SetSplitLambda(lambda);
+        }
+        DrawTooltip(ConvertToUTF8(L"0 为均匀分割，1 为对数分割；越大近处阴影越清晰").c_str());
+
+        float distance = cascades->GetShadowDistance();
+        if (ImGui::DragFloat(ConvertToUTF8(L"阴影距离").c_str(), &distance, 1.0f, 1.0f, 1000.0f))
+        {
+            cascades->SetShadowDistance(distance);
+        }
+
+        float blend = cascades->GetBlendRange();
+        if (ImGui::SliderFloat(ConvertToUTF8(L"级联混合").c_str(), &blend, 0.0f, 0.5f))
+        {
+            cascades->SetBlendRange(blend);
+        }
+
+        const auto &splits = cascades->GetGpuData().splits;
+        ImGui::Text(ConvertToUTF8(L"级联分割: %.1f / %.1f / %.1f / %.1f").c_str(), splits.x, splits.y, splits.z,
+                    splits.w);
+        ImGui::Text(ConvertToUTF8(L"本帧重绘: 级联 %d，阴影图块 %d").c_str(), renderer->GetShadowCascadesUpdated(),
+                    renderer->GetShadowTilesUpdated());
+    }
+
+    const auto &culling = renderer->GetCullingStats();
+    ImGui::Text(ConvertToUTF8(L"相机可见: %d / %d（剔除 %d）").c_str(), culling.cameraVisible, culling.objects,
+                culling.cameraCulled);
+    ImGui::Text(ConvertToUTF8(L"阴影投射体: 可见 %d，剔除 %d").c_str(), culling.shadowVisible, culling.shadowCulled);
+
+    const auto &queue = renderer->GetRenderQueueStats();
+    ImGui::Text(ConvertToUTF8(L"绘制调用: %d（实例 %d，合并批次 %d）").c_str(), queue.drawCalls, queue.instances,
+                queue.instancedBatches);
+    ImGui::Text(ConvertToUTF8(L"着色器: 切换 %d 次，已编译变体 %zu 个").c_str(), queue.programBinds,
+                renderer->GetShaderVariantCount());
+
+    // 各阶段 GPU 耗时（滑动平均），嵌套阶段缩进显示
+    const GpuTimer &gpuTimer = renderer->GetGpuTimer();
+    if (!gpuTimer.GetSections().empty() && ImGui::TreeNode(ConvertToUTF8(L"GPU 耗时").c_str()))
+    {
+        ImGui::Text(ConvertToUTF8(L"整帧: %.2f ms").c_str(), gpuTimer.GetFrameMs());
+        for (const auto &section : gpuTimer.GetSections())
+        {
+            ImGui::Text("%*s%s: %.2f ms", section.depth * 2, "", section.name.c_str(), section.averageMs);
+        }
+        ImGui::TreePop();
+    }
+
+    bool clustered = renderer->IsClusteredLightingEnabled();
+    if (ImGui::Checkbox(ConvertToUTF8(L"分簇光照").c_str(), &clustered))
+    {
+        renderer->SetClusteredLighting(clustered);
+    }
+    DrawTooltip(ConvertToUTF8(L"前向渲染时每个片段只计算所在簇内的点光源和聚光灯").c_str());
+
+    LightClusters *clusters = renderer->GetLightClusters();
+    if (clustered && clusters)
+    {
+        // 不支持计算着色器时始终使用 CPU 分配
+        if (clusters->IsComputeSupported())
+        {
+            bool cpuAssign = !clusters->IsUsingCompute();
+            if (ImGui::Checkbox(ConvertToUTF8(L"CPU 分配光源").c_str(), &cpuAssign))
+            {
+                clusters->SetUseCompute(!cpuAssign);
+            }
+            DrawTooltip(ConvertToUTF8(L"不使用计算着色器，在工作线程中计算簇光源列表").c_str());
+        }
+
+        const auto &clusterStats = clusters->GetStats();
+        if (clusterStats.maxClusterLights >= 0)
+            ImGui::Text(ConvertToUTF8(L"分簇光源: %d 个，单簇最多 %d 个（截断 %d 簇）").c_str(), clusterStats.lights,
+                        clusterStats.maxClusterLights, clusterStats.overflowClusters);
+        else
+            ImGui::Text(ConvertToUTF8(L"分簇光源: %d 个").c_str(), clusterStats.lights);
+    }
+}
+
+void EditorUI::ShowTextureMemorySettings()
+{
+    TextureManager &textureManager = TextureManager::GetInstance();
+    const auto &stats = textureManager.GetStats();
+    const float mb = 1.0f / (1024.0f * 1024.0f);
+
+    int budgetMB = static_cast<int>(textureManager.GetMemoryBudget() / (1024 * 1024));
+    if (ImGui::SliderInt(ConvertToUTF8(L"显存预算 (MB)").c_str(), &budgetMB, 64, 4096))
+    {
+        textureManager.SetMemoryBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+    }
+    DrawTooltip(ConvertToUTF8(L"超出预算时按最近最少使用顺序释放未被引用的纹理").c_str());
+
+    ImGui::Text(ConvertToUTF8(L"驻留: %zu 张，%.1f MB").c_str(), stats.residentCount, stats.residentBytes * mb);
+    ImGui::Text(ConvertToUTF8(L"使用中: %zu 张，%.1f MB").c_str(), stats.referencedCount, stats.referencedBytes * mb);
+    uint64_t requests = stats.hits + stats.misses;
+    ImGui::Text(ConvertToUTF8(L"命中 / 未命中: %llu / %llu（命中率 %.1f%%）").c_str(),
+                static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                requests > 0 ? 100.0 * stats.hits / requests : 0.0);
+    ImGui::Text(ConvertToUTF8(L"已淘汰: %llu 张，%.1f MB").c_str(), static_cast<unsigned long long>(stats.evictions),
+                stats.evictedBytes * mb);
+    ImGui::Text(ConvertToUTF8(L"内容去重: %llu 次，节省 %.1f MB").c_str(), static_cast<unsigned long long>(stats.dedupHits),
+                stats.dedupBytes * mb);
+
+    bool streaming = textureManager.IsStreamingEnabled();
+    if (ImGui::Checkbox(ConvertToUTF8(L"Mip 流式加载").c_str(), &streaming))
+    {
+        textureManager.SetStreamingEnabled(streaming);
+    }
+    DrawTooltip(ConvertToUTF8(L"大纹理先上传低分辨率 mip，再按屏幕尺寸逐级加载（对之后加载的纹理生效）").c_str());
+    ImGui::Text(ConvertToUTF8(L"流式纹理: %zu 张，流入 %llu 级，释放 %llu 级").c_str(), stats.streamingCount,
+                static_cast<unsigned long long>(stats.streamedLevels),
+                static_cast<unsigned long long>(stats.droppedLevels));
+
+    if (ImGui::Button(ConvertToUTF8(L"释放未使用纹理").c_str()))
+    {
+        size_t freed = textureManager.EvictUnused();
+        AddNotification(ConvertToUTF8(L"已释放纹理显存: ") + std::to_string(freed / 1024) + " KB", true, 2.0f);
+    }
 }
 
 // 实用工具函数
@@ -2491,18 +2658,20 @@ void EditorUI::EndFrame()
 
 void EditorUI::OnLightInspectorGUI(Light &light)
 {
+    bool changed = false; // 参数被修改时标记光源为脏，光源表只重新上传该光源
+
     if (light.getType() == 0)
     {
         auto &pointLight = static_cast<PointLight &>(light);
         ImGui::Text("%s %d", ConvertToUTF8(L"点光源").c_str(), pointLight.number);
-        ImGui::DragFloat3(ConvertToUTF8(L"位置").c_str(), glm::value_ptr(pointLight.position), 0.1f);
-        ImGui::ColorEdit3(ConvertToUTF8(L"环境光").c_str(), glm::value_ptr(pointLight.ambient));
-        ImGui::ColorEdit3(ConvertToUTF8(L"漫反射").c_str(), glm::value_ptr(pointLight.diffuse));
-        ImGui::ColorEdit3(ConvertToUTF8(L"高光").c_str(), glm::value_ptr(pointLight.specular));
-        ImGui::SliderFloat(ConvertToUTF8(L"强度").c_str(), &pointLight.intensity, 0.0f, 1.0f);
-        ImGui::SliderFloat(ConvertToUTF8(L"常数项").c_str(), &pointLight.constant, 0.0f, 1.0f);
-        ImGui::SliderFloat(ConvertToUTF8(L"线性项").c_str(), &pointLight.linear, 0.0f, 1.0f);
-        ImGui::SliderFloat(ConvertToUTF8(L"二次项").c_str(), &pointLight.quadratic, 0.0f, 1.0f);
+        changed |= ImGui::DragFloat3(ConvertToUTF8(L"位置").c_str(), glm::value_ptr(pointLight.position), 0.1f);
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"环境光").c_str(), glm::value_ptr(pointLight.ambient));
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"漫反射").c_str(), glm::value_ptr(pointLight.diffuse));
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"高光").c_str(), glm::value_ptr(pointLight.specular));
+        changed |= ImGui::SliderFloat(ConvertToUTF8(L"强度").c_str(), &pointLight.intensity, 0.0f, 1.0f);
+        changed |= ImGui::SliderFloat(ConvertToUTF8(L"常数项").c_str(), &pointLight.constant, 0.0f, 1.0f);
+        changed |= ImGui::SliderFloat(ConvertToUTF8(L"线性项").c_str(), &pointLight.linear, 0.0f, 1.0f);
+        changed |= ImGui::SliderFloat(ConvertToUTF8(L"二次项").c_str(), &pointLight.quadratic, 0.0f, 1.0f);
         
         // 阴影设置
         bool shadowEnabled = pointLight.IsShadowEnabled();
@@ -2513,21 +2682,21 @@ void EditorUI::OnLightInspectorGUI(Light &light)
         
         if (shadowEnabled)
         {
-            ImGui::DragFloat(ConvertToUTF8(L"阴影近平面").c_str(), &pointLight.shadowNearPlane, 0.1f, 0.1f, 10.0f);
-            ImGui::DragFloat(ConvertToUTF8(L"阴影远平面").c_str(), &pointLight.shadowFarPlane, 1.0f, 10.0f, 1000.0f);
+            changed |= ImGui::DragFloat(ConvertToUTF8(L"阴影近平面").c_str(), &pointLight.shadowNearPlane, 0.1f, 0.1f, 10.0f);
+            changed |= ImGui::DragFloat(ConvertToUTF8(L"阴影远平面").c_str(), &pointLight.shadowFarPlane, 1.0f, 10.0f, 1000.0f);
         }
     }
     else if (light.getType() == 1)
     {
         auto &directionalLight = static_cast<DirectionalLight &>(light);
         ImGui::Text("%s %d", ConvertToUTF8(L"方向光源").c_str(), directionalLight.number);
-        ImGui::DragFloat3(ConvertToUTF8(L"方向").c_str(), glm::value_ptr(directionalLight.direction), 0.1f,- 1.0f, 1.0f);
+        changed |= ImGui::DragFloat3(ConvertToUTF8(L"方向").c_str(), glm::value_ptr(directionalLight.direction), 0.1f,- 1.0f, 1.0f);
         //directionalLight.direction = glm::normalize(directionalLight.direction);
         ImGui::Text("%s: (0.0, 0.0, 0.0)", ConvertToUTF8(L"位置").c_str()); // 定向光没有位置
-        ImGui::ColorEdit3(ConvertToUTF8(L"环境光").c_str(), glm::value_ptr(directionalLight.ambient));
-        ImGui::ColorEdit3(ConvertToUTF8(L"漫反射").c_str(), glm::value_ptr(directionalLight.diffuse));
-        ImGui::ColorEdit3(ConvertToUTF8(L"高光").c_str(), glm::value_ptr(directionalLight.specular));
-        ImGui::SliderFloat(ConvertToUTF8(L"强度").c_str(), &directionalLight.intensity, 0.0f, 1.0f);
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"环境光").c_str(), glm::value_ptr(directionalLight.ambient));
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"漫反射").c_str(), glm::value_ptr(directionalLight.diffuse));
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"高光").c_str(), glm::value_ptr(directionalLight.specular));
+        changed |= ImGui::SliderFloat(ConvertToUTF8(L"强度").c_str(), &directionalLight.intensity, 0.0f, 1.0f);
         
         // 阴影设置
         bool shadowEnabled = directionalLight.IsShadowEnabled();
@@ -2535,22 +2704,17 @@ void EditorUI::OnLightInspectorGUI(Light &light)
         {
             directionalLight.SetShadowEnabled(shadowEnabled);
         }
-        
-        if (shadowEnabled)
-        {
-            ImGui::DragFloat(ConvertToUTF8(L"阴影近平面").c_str(), &directionalLight.shadowNearPlane, 0.1f, 0.1f, 10.0f);
-            ImGui::DragFloat(ConvertToUTF8(L"阴影远平面").c_str(), &directionalLight.shadowFarPlane, 1.0f, 10.0f, 1000.0f);
-            ImGui::DragFloat(ConvertToUTF8(L"阴影正交大小").c_str(), &directionalLight.shadowOrthoSize, 1.0f, 5.0f, 100.0f);
-        }
+        DrawTooltip(ConvertToUTF8(L"级联数量、分割方式和阴影距离在渲染设置的阴影面板中调整").c_str());
     }
     else if (light.getType() == 2)
     {
         auto &spotLight = static_cast<SpotLight &>(light);
         ImGui::Text("%s", ConvertToUTF8(L"聚光灯").c_str());
-        ImGui::DragFloat3(ConvertToUTF8(L"位置").c_str(), glm::value_ptr(spotLight.position), 0.1f);
+        changed |= ImGui::DragFloat3(ConvertToUTF8(L"位置").c_str(), glm::value_ptr(spotLight.position), 0.1f);
         
         // 方向输入，自动归一化
         if (ImGui::DragFloat3(ConvertToUTF8(L"方向").c_str(), glm::value_ptr(spotLight.direction), 0.01f, -1.0f, 1.0f)) {
+            changed = true;
             // 在方向改变时自动归一化，避免零向量
             if (glm::length(spotLight.direction) > 0.001f) {
                 spotLight.direction = glm::normalize(spotLight.direction);
@@ -2559,10 +2723,10 @@ void EditorUI::OnLightInspectorGUI(Light &light)
             }
         }
         
-        ImGui::ColorEdit3(ConvertToUTF8(L"环境光").c_str(), glm::value_ptr(spotLight.ambient));
-        ImGui::ColorEdit3(ConvertToUTF8(L"漫反射").c_str(), glm::value_ptr(spotLight.diffuse));
-        ImGui::ColorEdit3(ConvertToUTF8(L"高光").c_str(), glm::value_ptr(spotLight.specular));
-        ImGui::DragFloat(ConvertToUTF8(L"强度").c_str(), &spotLight.intensity, 0.1f, 0.0f, 100.0f);
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"环境光").c_str(), glm::value_ptr(spotLight.ambient));
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"漫反射").c_str(), glm::value_ptr(spotLight.diffuse));
+        changed |= ImGui::ColorEdit3(ConvertToUTF8(L"高光").c_str(), glm::value_ptr(spotLight.specular));
+        changed |= ImGui::DragFloat(ConvertToUTF8(L"强度").c_str(), &spotLight.intensity, 0.1f, 0.0f, 100.0f);
 
         // 内切角应该小于外切角
         float degrees = glm::degrees(glm::acos(spotLight.cutOff));
@@ -2570,18 +2734,20 @@ void EditorUI::OnLightInspectorGUI(Light &light)
         // 内切角是光锥的角度，范围在0到90度之间
         if (ImGui::DragFloat(ConvertToUTF8(L"内切角").c_str(), &degrees, 1.0f, 0.0f, outerDegrees))
         {
+            changed = true;
             spotLight.cutOff = glm::cos(glm::radians(degrees));
         }
 
         // 外切角应该大于内切角
         if (ImGui::DragFloat(ConvertToUTF8(L"外切角").c_str(), &outerDegrees, 1.0f, degrees, 89.9f))
         {
+            changed = true;
             spotLight.outerCutOff = glm::cos(glm::radians(outerDegrees));
         }
 
-        ImGui::DragFloat(ConvertToUTF8(L"常数项").c_str(), &spotLight.constant, 0.01f, 0.0f, 1.0f);
-        ImGui::DragFloat(ConvertToUTF8(L"线性项").c_str(), &spotLight.linear, 0.001f, 0.0f, 1.0f);
-        ImGui::DragFloat(ConvertToUTF8(L"二次项").c_str(), &spotLight.quadratic, 0.0001f, 0.0f, 1.0f);
+        changed |= ImGui::DragFloat(ConvertToUTF8(L"常数项").c_str(), &spotLight.constant, 0.01f, 0.0f, 1.0f);
+        changed |= ImGui::DragFloat(ConvertToUTF8(L"线性项").c_str(), &spotLight.linear, 0.001f, 0.0f, 1.0f);
+        changed |= ImGui::DragFloat(ConvertToUTF8(L"二次项").c_str(), &spotLight.quadratic, 0.0001f, 0.0f, 1.0f);
         
         // 阴影设置
         bool shadowEnabled = spotLight.IsShadowEnabled();
@@ -2592,10 +2758,15 @@ void EditorUI::OnLightInspectorGUI(Light &light)
         
         if (shadowEnabled)
         {
-            ImGui::DragFloat(ConvertToUTF8(L"阴影近平面").c_str(), &spotLight.shadowNearPlane, 0.1f, 0.1f, 10.0f);
-            ImGui::DragFloat(ConvertToUTF8(L"阴影远平面").c_str(), &spotLight.shadowFarPlane, 1.0f, 10.0f, 1000.0f);
+            changed |= ImGui::DragFloat(ConvertToUTF8(L"阴影近平面").c_str(), &spotLight.shadowNearPlane, 0.1f, 0.1f, 10.0f);
+            changed |= ImGui::DragFloat(ConvertToUTF8(L"阴影远平面").c_str(), &spotLight.shadowFarPlane, 1.0f, 10.0f, 1000.0f);
         }
     }
+
+    if (changed)
+    {
+        light.MarkDirty();
+    }
 }
 
 // 通知系统实现
@@ -2682,14 +2853,6 @@ void EditorUI::PreloadAsset(AssetItem &item)
 {
     if (item.isPreloaded) return;
     
-    // 检查是否已经在缓存中
-    std::string key = item.path.string();
-    if (preloadedAssets.find(key) != preloadedAssets.end())
-    {
-        item.isPreloaded = true;
-        return;
-    }
-    
     // 根据资源类型进行预加载
     try 
     {
@@ -2697,8 +2860,9 @@ void EditorUI::PreloadAsset(AssetItem &item)
         {
             case AssetType::TEXTURE:
             {
-                auto texture = std::make_shared<Texture>();
-                if (texture->LoadFromFile(item.path.string()))
+                // 异步加载：浏览资源时不阻塞编辑器，解码完成前显示占位纹理
+                auto texture = TextureManager::GetInstance().GetTextureAsync(item.path.string());
+                if (texture)
                 {
                     item.resource = texture;
                     item.previewTexture = texture;
@@ -2708,7 +2872,6 @@ void EditorUI::PreloadAsset(AssetItem &item)
                     item.cachedData.textureData.width = 512;
                     item.cachedData.textureData.height = 512;
                     item.cachedData.textureData.channels = 4;
-                    preloadedAssets[key] = texture;
                     item.isPreloaded = true;
                     AddNotification(ConvertToUTF8(L"预加载纹理: ") + item.name, true, 2.0f);
                 }
@@ -2734,13 +2897,7 @@ void EditorUI::PreloadAsset(AssetItem &item)
 
 void EditorUI::UnloadAsset(AssetItem &item)
 {
-    std::string key = item.path.string();
-    auto it = preloadedAssets.find(key);
-    if (it != preloadedAssets.end())
-    {
-        preloadedAssets.erase(it);
-    }
-    
+    // 只释放引用，纹理在超出显存预算或清除缓存时由 TextureManager 淘汰
     item.resource.reset();
     item.previewTexture.reset();
     item.isPreloaded = false;
@@ -2818,7 +2975,7 @@ void EditorUI::ShowAssetPreviewWindow()
     {
         if (selectedAsset->type == AssetType::MODEL)
         {
-            renderer->LoadModel(selectedAsset->path.string());
+            renderer->LoadModelAsync(selectedAsset->path.string());
             AddNotification(ConvertToUTF8(L"模型已添加到场景: ") + selectedAsset->name, true);
         }
     }
@@ -2873,6 +3030,10 @@ void EditorUI::ShowDebugViewport()
     {
         ImGui::TextColored(ImVec4(0.2f, 0.8f, 0.2f, 1.0f), "%s", ConvertToUTF8(L"前向渲染").c_str());
     }
+    else if (renderMode == Renderer::TILED_DEFERRED)
+    {
+        ImGui::TextColored(ImVec4(0.2f, 0.6f, 1.0f, 1.0f), "%s", ConvertToUTF8(L"分块延迟渲染").c_str());
+    }
     else
     {
         ImGui::TextColored(ImVec4(0.2f, 0.6f, 1.0f, 1.0f), "%s", ConvertToUTF8(L"延迟渲染").c_str());
@@ -2904,10 +3065,13 @@ void EditorUI::ShowDebugViewport()
     }
     
     // ===== G-Buffer 数据（仅延迟渲染）=====
-    if (renderMode == Renderer::DEFERRED && showGBuffer)
+    if (renderMode != Renderer::FORWARD && showGBuffer)
     {
         if (ImGui::CollapsingHeader(ConvertToUTF8(L"G-Buffer 数据").c_str(), ImGuiTreeNodeFlags_DefaultOpen))
         {
+            // 紧凑 G 缓冲需要解码后才能逐属性显示，只在面板展开时请求
+            renderer->RequestGBufferDebugView();
+
             // 创建一个子窗口来容纳G-Buffer纹理
             ImGui::BeginChild("GBufferChild", ImVec2(0, 0), true);
             
@@ -3033,7 +3197,7 @@ void EditorUI::ShowDebugViewport()
     }
     
     // ===== SSAO效果（仅延迟渲染）=====
-    if (renderMode == Renderer::DEFERRED && renderer->IsSSAOEnabled() && showSSAO)
+    if (renderMode != Renderer::FORWARD && renderer->IsSSAOEnabled() && showSSAO)
     {
         if (ImGui::CollapsingHeader(ConvertToUTF8(L"SSAO 效果").c_str(), ImGuiTreeNodeFlags_DefaultOpen))
         {
@@ -3349,19 +3513,20 @@ void EditorUI::ApplyMaterialToObject()
             auto model = models[selectedObjectIndex];
             auto meshes = model->GetMeshes();
             
+            // 与材质编辑器一致：应用到实例当前使用的材质（共享材质或独立材质）
             if (selectedMeshIndex == -1)
             {
                 // 应用到所有mesh
-                for (auto& mesh : meshes)
+                for (size_t i = 0; i < meshes.size(); ++i)
                 {
-                    ApplyAssetToMesh(mesh);
+                    ApplyAssetToMaterial(model->GetMaterial(i));
                 }
                 successMessage = ConvertToUTF8(L"已应用到模型的所有Mesh: ") + pendingAssetToApply.name;
             }
             else if (selectedMeshIndex < meshes.size())
             {
                 // 应用到指定mesh
-                ApplyAssetToMesh(meshes[selectedMeshIndex]);
+                ApplyAssetToMaterial(model->GetMaterial(selectedMeshIndex));
                 successMessage = ConvertToUTF8(L"已应用到Mesh ") + std::to_string(selectedMeshIndex + 1) + ": " + pendingAssetToApply.name;
             }
         }
@@ -3393,6 +3558,20 @@ void EditorUI::ApplyAssetToMesh(std::shared_ptr<Mesh> mesh)
 {
     if (!mesh) return;
     
+    // 获取mesh的当前材质，如果没有则创建一个新的
+    auto material = mesh->GetMaterial();
+    if (!material)
+    {
+        material = std::make_shared<Material>();
+        mesh->SetMaterial(material);
+    }
+    ApplyAssetToMaterial(material);
+}
+
+void EditorUI::ApplyAssetToMaterial(const std::shared_ptr<Material> &material)
+{
+    if (!material) return;
+    
     if (pendingAssetToApply.type == AssetType::MATERIAL)
     {
         // TODO: 加载并应用整个材质
@@ -3400,16 +3579,13 @@ void EditorUI::ApplyAssetToMesh(std::shared_ptr<Mesh> mesh)
     }
     else if (pendingAssetToApply.type == AssetType::TEXTURE)
     {
-        // 获取mesh的当前材质，如果没有则创建一个新的
-        auto material = mesh->GetMaterial();
-        if (!material)
-        {
-            material = std::make_shared<Material>();
-            mesh->SetMaterial(material);
-        }
-        
         // 根据选择的材质属性应用纹理
-        auto texture = std::make_shared<Texture>(pendingAssetToApply.path.string());
+        // 漫反射和反照率贴图是颜色数据，使用 sRGB 格式；法线贴图按双通道压缩
+        auto texture = TextureManager::GetInstance().GetTexture(pendingAssetToApply.path.string(), true,
+                                                                selectedMaterialProperty == 1 ||
+                                                                    selectedMaterialProperty == 7,
+                                                                selectedMaterialProperty == 2);
+        if (!texture) return;
         
         switch (selectedMaterialProperty)
         {
@@ -0,0 +1,290 @@
+// JobSystem 单元测试：xmake build JobSystemTests && xmake run JobSystemTests（或 xmake test）
+// 不依赖 GL 上下文，失败时返回非零退出码
+#include "core/JobSystem.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+int failures = 0;
+
+#define CHECK(condition)                                                                                             \
+    do                                                                                                               \
+    {                                                                                                                \
+        if (!(condition))                                                                                            \
+        {                                                                                                            \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                      \
+            ++failures;                                                                                              \
+        }                                                                                                            \
+    } while (0)
+
+// 每个元素恰好被访问一次，且切分不越界
+void TestParallelForCoversRange()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    for (size_t count : {0u, 1u, 7u, 64u, 1000u, 100003u})
+    {
+        for (size_t grain : {1u, 3u, 64u, 4096u})
+        {
+            std::vector<std::atomic<int>> visits(count);
+            jobs.ParallelFor(0, count, grain, [&](size_t begin, size_t end) {
+                CHECK(begin < end);
+                CHECK(end <= count);
+                CHECK(end - begin <= grain);
+                for (size_t i = begin; i < end; ++i)
+                    visits[i].fetch_add(1, std::memory_order_relaxed);
+            });
+            bool allOnce = true;
+            for (auto &v : visits)
+                allOnce &= v.load() == 1;
+            CHECK(allOnce);
+        }
+    }
+}
+
+// 非零起点与嵌套的 ParallelFor（工作线程中再次 ParallelFor 不能死锁）
+void TestParallelForNested()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    std::atomic<long long> sum{0};
+    jobs.ParallelFor(10, 50, 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            jobs.ParallelFor(0, 100, 16, [&](size_t innerBegin, size_t innerEnd) {
+                sum.fetch_add(static_cast<long long>(innerEnd - innerBegin) * static_cast<long long>(i),
+                              std::memory_order_relaxed);
+            });
+        }
+    });
+    // sum(i = 10..49) * 100
+    CHECK(sum.load() == 100LL * (10 + 49) * 40 / 2);
+}
+
+// Wait 返回时计数器上的所有作业都已完成，写入对调用线程可见
+void TestWaitSeesAllResults()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    auto counter = std::make_shared<JobCounter>();
+    std::vector<int> results(256, 0);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        jobs.Schedule([&results, i]() { results[i] = static_cast<int>(i) * 2; }, counter);
+    }
+    jobs.Wait(counter);
+    CHECK(counter->IsDone());
+    CHECK(counter->GetPending() == 0);
+    bool allWritten = true;
+    for (size_t i = 0; i < results.size(); ++i)
+        allWritten &= results[i] == static_cast<int>(i) * 2;
+    CHECK(allWritten);
+
+    // 空计数器和空指针立即返回
+    jobs.Wait(std::make_shared<JobCounter>());
+    jobs.Wait(nullptr);
+}
+
+// 后续作业只在依赖的全部作业完成后运行，并计入自己的计数器
+void TestScheduleAfterOrdering()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    auto first = std::make_shared<JobCounter>();
+    auto second = std::make_shared<JobCounter>();
+    std::atomic<int> finishedFirst{0};
+    std::atomic<int> seenByContinuation{-1};
+
+    for (int i = 0; i < 32; ++i)
+    {
+        jobs.Schedule(
+            [&finishedFirst]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                finishedFirst.fetch_add(1, std::memory_order_relaxed);
+            },
+            first);
+    }
+    jobs.ScheduleAfter(first, [&]() { seenByContinuation = finishedFirst.load(); }, second);
+
+    // 后续作业挂起期间 second 不能归零
+    CHECK(!second->IsDone() || seenByContinuation.load() == 32);
+    jobs.Wait(second);
+    CHECK(first->IsDone());
+    CHECK(seenByContinuation.load() == 32);
+
+    // 依赖已完成时立即调度
+    std::atomic<bool> ran{false};
+    auto third = std::make_shared<JobCounter>();
+    jobs.ScheduleAfter(first, [&ran]() { ran = true; }, third);
+    jobs.Wait(third);
+    CHECK(ran.load());
+
+    // 链式依赖：A -> B -> C（ScheduleAfter 立即计入 counter，因此按依赖顺序注册即可，A 未完成时 B、C 都会挂起）
+    auto a = std::make_shared<JobCounter>();
+    auto b = std::make_shared<JobCounter>();
+    auto c = std::make_shared<JobCounter>();
+    std::mutex orderMutex;
+    std::vector<char> order;
+    auto record = [&](char tag) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(tag);
+    };
+    jobs.Schedule(
+        [&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            record('A');
+        },
+        a);
+    jobs.ScheduleAfter(a, [&]() { record('B'); }, b);
+    jobs.ScheduleAfter(b, [&]() { record('C'); }, c);
+    jobs.Wait(c);
+    CHECK((order == std::vector<char>{'A', 'B', 'C'}));
+}
+
+// 主线程的 Wait 只执行帧内作业，从不执行后台作业；后台线程中的 ParallelFor 留在后台队列
+void TestWaitSkipsBackgroundJobs()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    std::thread::id caller = std::this_thread::get_id();
+
+    // 占满所有后台线程，使之后投递的后台作业留在队列中
+    std::atomic<bool> release{false};
+    std::atomic<unsigned int> blocked{0};
+    auto blockers = std::make_shared<JobCounter>();
+    for (unsigned int i = 0; i < jobs.GetBackgroundWorkerCount(); ++i)
+    {
+        jobs.ScheduleBackground(
+            [&]() {
+                blocked.fetch_add(1);
+                while (!release.load())
+                    std::this_thread::yield();
+            },
+            blockers);
+    }
+    while (blocked.load() < jobs.GetBackgroundWorkerCount())
+        std::this_thread::yield();
+
+    std::atomic<bool> backgroundOnCaller{false};
+    std::atomic<bool> backgroundOnBackground{false};
+    std::atomic<bool> chunksOnBackground{true};
+    auto imports = std::make_shared<JobCounter>();
+    for (int i = 0; i < 8; ++i)
+    {
+        jobs.ScheduleBackground(
+            [&]() {
+                backgroundOnCaller = backgroundOnCaller || std::this_thread::get_id() == caller;
+                backgroundOnBackground = JobSystem::IsBackgroundThread();
+                jobs.ParallelFor(0, 64, 4, [&](size_t, size_t) {
+                    if (!JobSystem::IsBackgroundThread())
+                        chunksOnBackground = false;
+                });
+            },
+            imports);
+    }
+
+    // 后台作业挂起期间，主线程的 Wait 与 ParallelFor 都能完成，且不会执行后台作业
+    auto frame = std::make_shared<JobCounter>();
+    std::atomic<int> frameJobs{0};
+    for (int i = 0; i < 64; ++i)
+        jobs.Schedule([&frameJobs]() { frameJobs.fetch_add(1); }, frame);
+    jobs.Wait(frame);
+    jobs.ParallelFor(0, 1000, 8, [](size_t, size_t) {});
+    CHECK(frameJobs.load() == 64);
+    CHECK(imports->GetPending() == 8);
+
+    release = true;
+    jobs.Wait(imports);
+    jobs.Wait(blockers);
+    CHECK(!backgroundOnCaller.load());
+    CHECK(backgroundOnBackground.load());
+    CHECK(chunksOnBackground.load());
+}
+
+// Shutdown 先执行完队列中剩余的作业，之后 Schedule 退回到调用线程同步执行
+void TestShutdownDrains()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    auto counter = std::make_shared<JobCounter>();
+    std::atomic<int> executed{0};
+    const int jobCount = 500;
+    for (int i = 0; i < jobCount; ++i)
+    {
+        jobs.Schedule(
+            [&executed]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                executed.fetch_add(1, std::memory_order_relaxed);
+            },
+            counter);
+    }
+    std::atomic<int> backgroundExecuted{0};
+    auto backgroundCounter = std::make_shared<JobCounter>();
+    for (int i = 0; i < 16; ++i)
+    {
+        jobs.ScheduleBackground(
+            [&backgroundExecuted]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                backgroundExecuted.fetch_add(1, std::memory_order_relaxed);
+            },
+            backgroundCounter);
+    }
+    jobs.Shutdown();
+    CHECK(executed.load() == jobCount);
+    CHECK(counter->IsDone());
+    CHECK(backgroundExecuted.load() == 16);
+    CHECK(backgroundCounter->IsDone());
+    CHECK(jobs.GetBackgroundWorkerCount() == 0);
+    CHECK(!jobs.IsInitialized());
+
+    bool ranInline = false;
+    std::thread::id caller = std::this_thread::get_id();
+    jobs.Schedule([&]() { ranInline = std::this_thread::get_id() == caller; });
+    CHECK(ranInline);
+    bool backgroundInline = false;
+    jobs.ScheduleBackground([&]() { backgroundInline = std::this_thread::get_id() == caller; });
+    CHECK(backgroundInline);
+
+    // 可以重新初始化
+    jobs.Initialize(2);
+    CHECK(jobs.GetWorkerCount() == 2);
+    std::atomic<int> after{0};
+    jobs.ParallelFor(0, 1000, 10, [&](size_t begin, size_t end) {
+        after.fetch_add(static_cast<int>(end - begin), std::memory_order_relaxed);
+    });
+    CHECK(after.load() == 1000);
+    jobs.Shutdown();
+}
+
+// 作业抛出异常时计数器仍然归零
+void TestExceptionStillFinishes()
+{
+    JobSystem &jobs = JobSystem::GetInstance();
+    auto counter = std::make_shared<JobCounter>();
+    jobs.Schedule([]() { throw std::runtime_error("expected test exception"); }, counter);
+    jobs.Wait(counter);
+    CHECK(counter->IsDone());
+}
+} // namespace
+
+int main()
+{
+    JobSystem::GetInstance().Initialize(4);
+
+    TestParallelForCoversRange();
+    TestParallelForNested();
+    TestWaitSeesAllResults();
+    TestScheduleAfterOrdering();
+    TestExceptionStillFinishes();
+    TestWaitSkipsBackgroundJobs();
+    TestShutdownDrains(); // 最后执行：会关闭作业系统
+
+    if (failures)
+    {
+        std::fprintf(stderr, "JobSystemTests: %d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("JobSystemTests: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,196 @@
+// 分簇光照 CPU 分配的单元测试：xmake build LightClusterTests && xmake run LightClusterTests（或 xmake test）
+// 计算着色器路径需要 GL 上下文，这里用逐簇遍历全部光源的参考实现代替（与 light_cluster.comp 的算法逐步对应），
+// 检查 SIMD 与标量两条路径的结果都与之完全一致。不依赖 GL 上下文，失败时返回非零退出码
+#include "core/JobSystem.hpp"
+#include "core/LightClusterAssigner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+int failures = 0;
+
+#define CHECK(condition)                                                                                             \
+    do                                                                                                               \
+    {                                                                                                                \
+        if (!(condition))                                                                                            \
+        {                                                                                                            \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                      \
+            ++failures;                                                                                              \
+        }                                                                                                            \
+    } while (0)
+
+using Assigner = LightClusterAssigner;
+
+constexpr float NEAR_PLANE = 0.1f;
+constexpr float FAR_PLANE = 100.0f;
+
+glm::mat4 TestProjection()
+{
+    return glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, NEAR_PLANE, FAR_PLANE);
+}
+
+// light_cluster.comp 的 CPU 版本：每个簇独立计算包围盒并按顺序测试全部光源，满 MAX_LIGHTS_PER_CLUSTER 后停止
+std::vector<uint32_t> ReferenceAssign(const std::vector<glm::vec4> &spheres, const glm::mat4 &projection,
+                                      uint32_t indexOffset)
+{
+    const glm::mat4 inverseProjection = glm::inverse(projection);
+    auto viewRay = [&](float x, float y) {
+        glm::vec4 p = inverseProjection * glm::vec4(x, y, -1.0f, 1.0f);
+        return glm::vec3(p) / p.w;
+    };
+    auto sliceDepth = [](int slice) {
+        return NEAR_PLANE * std::pow(FAR_PLANE / NEAR_PLANE, static_cast<float>(slice) / Assigner::CLUSTER_Z);
+    };
+
+    std::vector<uint32_t> data(Assigner::DATA_SIZE, 0);
+    for (int cluster = 0; cluster < Assigner::CLUSTER_COUNT; ++cluster)
+    {
+        int x = cluster % Assigner::CLUSTER_X;
+        int y = (cluster / Assigner::CLUSTER_X) % Assigner::CLUSTER_Y;
+        int z = cluster / (Assigner::CLUSTER_X * Assigner::CLUSTER_Y);
+
+        float nearDepth = sliceDepth(z);
+        float farDepth = sliceDepth(z + 1);
+        float ndcMinX = static_cast<float>(x) / Assigner::CLUSTER_X * 2.0f - 1.0f;
+        float ndcMaxX = static_cast<float>(x + 1) / Assigner::CLUSTER_X * 2.0f - 1.0f;
+        float ndcMinY = static_cast<float>(y) / Assigner::CLUSTER_Y * 2.0f - 1.0f;
+        float ndcMaxY = static_cast<float>(y + 1) / Assigner::CLUSTER_Y * 2.0f - 1.0f;
+        const glm::vec3 rays[4] = {viewRay(ndcMinX, ndcMinY), viewRay(ndcMaxX, ndcMinY), viewRay(ndcMinX, ndcMaxY),
+                                   viewRay(ndcMaxX, ndcMaxY)};
+        glm::vec3 aabbMin(1e30f), aabbMax(-1e30f);
+        for (const glm::vec3 &ray : rays)
+        {
+            glm::vec3 nearPoint = ray * (nearDepth / -ray.z);
+            glm::vec3 farPoint = ray * (farDepth / -ray.z);
+            aabbMin = glm::min(aabbMin, glm::min(nearPoint, farPoint));
+            aabbMax = glm::max(aabbMax, glm::max(nearPoint, farPoint));
+        }
+
+        uint32_t count = 0;
+        for (size_t i = 0; i < spheres.size() && count < Assigner::MAX_LIGHTS_PER_CLUSTER; ++i)
+        {
+            glm::vec3 center(spheres[i]);
+            glm::vec3 offset = glm::clamp(center, aabbMin, aabbMax) - center;
+            if (glm::dot(offset, offset) <= spheres[i].w * spheres[i].w)
+            {
+                data[Assigner::CLUSTER_COUNT + cluster * Assigner::MAX_LIGHTS_PER_CLUSTER + count] =
+                    indexOffset + static_cast<uint32_t>(i);
+                ++count;
+            }
+        }
+        data[cluster] = count;
+    }
+    return data;
+}
+
+// 视锥内外随机分布的光源；radiusScale 越大每个簇的光源越多
+std::vector<glm::vec4> RandomSpheres(size_t count, unsigned int seed, float radiusScale)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> lateral(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> depth(-5.0f, FAR_PLANE * 1.1f);
+    std::uniform_real_distribution<float> radius(0.05f, 1.0f);
+    std::vector<glm::vec4> spheres;
+    for (size_t i = 0; i < count; ++i)
+    {
+        float d = depth(rng);
+        // 横向范围随深度扩大，使大部分光源落在视锥内
+        spheres.emplace_back(lateral(rng) * std::max(d, 1.0f) * 0.7f, lateral(rng) * std::max(d, 1.0f) * 0.4f, -d,
+                             radius(rng) * radiusScale);
+    }
+    return spheres;
+}
+
+// 只比较着色器会读取的部分：每个簇的光源数和前 count 个下标
+bool SameClusters(const std::vector<uint32_t> &expected, const std::vector<uint32_t> &actual)
+{
+    if (actual.size() != Assigner::DATA_SIZE)
+        return false;
+    for (int cluster = 0; cluster < Assigner::CLUSTER_COUNT; ++cluster)
+    {
+        if (expected[cluster] != actual[cluster])
+            return false;
+        size_t slots = Assigner::CLUSTER_COUNT + static_cast<size_t>(cluster) * Assigner::MAX_LIGHTS_PER_CLUSTER;
+        if (!std::equal(expected.begin() + slots, expected.begin() + slots + expected[cluster], actual.begin() + slots))
+            return false;
+    }
+    return true;
+}
+
+Assigner::Result AssignWith(const std::vector<glm::vec4> &spheres, bool useSimd, uint32_t indexOffset,
+                            std::vector<uint32_t> &data)
+{
+    Assigner assigner;
+    assigner.SetUseSimd(useSimd);
+    for (const glm::vec4 &sphere : spheres)
+        assigner.Add(sphere);
+    return assigner.Assign(TestProjection(), NEAR_PLANE, FAR_PLANE, indexOffset, data);
+}
+
+// 光源数覆盖空集、不足一批、整批加余数等情况，SIMD 与标量路径都与参考实现一致
+void TestMatchesReference()
+{
+    unsigned int seed = 1;
+    for (size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 15u, 17u, 100u, 1000u})
+    {
+        std::vector<glm::vec4> spheres = RandomSpheres(count, seed++, 1.0f);
+        std::vector<uint32_t> expected = ReferenceAssign(spheres, TestProjection(), 3);
+        for (bool useSimd : {true, false})
+        {
+            std::vector<uint32_t> actual;
+            AssignWith(spheres, useSimd, 3, actual);
+            CHECK(SameClusters(expected, actual));
+        }
+    }
+}
+
+// 簇内光源数超过上限时按下标顺序截断，统计中记录溢出的簇
+void TestOverflowTruncates()
+{
+    std::vector<glm::vec4> spheres = RandomSpheres(2000, 42, 20.0f);
+    std::vector<uint32_t> expected = ReferenceAssign(spheres, TestProjection(), 0);
+    for (bool useSimd : {true, false})
+    {
+        std::vector<uint32_t> actual;
+        Assigner::Result result = AssignWith(spheres, useSimd, 0, actual);
+        CHECK(SameClusters(expected, actual));
+        CHECK(result.maxClusterLights > Assigner::MAX_LIGHTS_PER_CLUSTER);
+        CHECK(result.overflowClusters > 0);
+    }
+}
+
+// 复用输出缓冲时旧数据不影响结果
+void TestReusedBuffer()
+{
+    std::vector<uint32_t> data;
+    AssignWith(RandomSpheres(500, 7, 5.0f), true, 0, data);
+    std::vector<glm::vec4> spheres = RandomSpheres(50, 8, 1.0f);
+    Assigner::Result result = AssignWith(spheres, true, 0, data);
+    CHECK(SameClusters(ReferenceAssign(spheres, TestProjection(), 0), data));
+    CHECK(result.overflowClusters == 0);
+}
+} // namespace
+
+int main()
+{
+    JobSystem::GetInstance().Initialize(4);
+
+    TestMatchesReference();
+    TestOverflowTruncates();
+    TestReusedBuffer();
+
+    JobSystem::GetInstance().Shutdown();
+
+    if (failures)
+    {
+        std::fprintf(stderr, "LightClusterTests: %d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("LightClusterTests: all checks passed\n");
+    return 0;
+}
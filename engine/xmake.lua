@@ -20,6 +20,53 @@ target("AmerEngine")
         add_ldflags("/entry:mainCRTStartup", {force = true})
     end
 
+-- 单元测试与基准：不依赖 GL 上下文的部分直接链接对应的源文件，默认不构建
+-- 运行测试：xmake build -g tests && xmake test
+-- 运行基准：xmake build -g benchmarks && xmake run <目标名>（请使用 release 模式）
+target("JobSystemTests")
+    set_kind("binary")
+    set_default(false)
+    set_group("tests")
+    add_files("tests/JobSystemTests.cpp", "src/core/JobSystem.cpp")
+    add_includedirs("include")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+    add_tests("default")
+
+target("JobSystemBench")
+    set_kind("binary")
+    set_default(false)
+    set_group("benchmarks")
+    add_files("benchmarks/JobSystemBench.cpp", "src/core/JobSystem.cpp")
+    add_includedirs("include")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
+target("LightClusterTests")
+    set_kind("binary")
+    set_default(false)
+    set_group("tests")
+    add_files("tests/LightClusterTests.cpp", "src/core/LightClusterAssigner.cpp", "src/core/JobSystem.cpp")
+    add_includedirs("include")
+    add_packages("glm")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+    add_tests("default")
+
+target("LightClustersBench")
+    set_kind("binary")
+    set_default(false)
+    set_group("benchmarks")
+    add_files("benchmarks/LightClustersBench.cpp", "src/core/LightClusterAssigner.cpp", "src/core/JobSystem.cpp")
+    add_includedirs("include")
+    add_packages("glm")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --